@@ -0,0 +1,187 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Bitboard.hpp"
+#include "FoodField.hpp"
+#include "Snake.hpp"
+#include "Random.hpp"
+
+/**
+ * @brief Per-tick summary returned by Arena::step()
+ */
+struct ArenaTickStats {
+    int deaths = 0;       ///< Snakes killed this tick
+    int foodEaten = 0;    ///< Food items eaten this tick
+    int respawns = 0;     ///< Autopilot snakes brought back this tick
+};
+
+/**
+ * @brief How arena food is valued and how long it lasts
+ */
+struct ArenaFoodRules {
+    std::uint32_t lifetime = 0;       ///< Ticks an item stays before it expires (0 = until eaten)
+    std::uint32_t bonusChance = 0;    ///< One item in bonusChance is a bonus item (0 = none)
+    std::uint16_t bonusWeight = 5;    ///< Score of a bonus item (normal items score 1)
+};
+
+/**
+ * @brief Many snakes sharing one board
+ * 
+ * The Arena manages:
+ * - Any number of snakes (up to MaxSnakes), each human or autopilot controlled
+ * - A shared occupancy grid storing the owner of every cell
+ * - Any number of food items on free cells, optionally weighted and
+ *   expiring, indexed by a FoodField
+ * 
+ * Collisions are resolved in a single pass per tick without comparing
+ * snakes pairwise. Tails that will move are vacated first, then each
+ * head claims its target cell: a second claim on the same cell kills
+ * both snakes (head-to-head), and a claim on an occupied cell kills the
+ * mover (head-to-body). Tick cost is linear in the number of live snakes
+ * plus the length of the snakes that died.
+ */
+class Arena {
+public:
+    static constexpr std::uint16_t NoOwner = 0;          ///< Cell value for an empty cell
+    static constexpr std::uint16_t FoodCell = 0xFFFF;    ///< Cell value for food
+    static constexpr std::size_t MaxSnakes = 0xFFFE;     ///< Owner ids are snake index + 1
+    static constexpr std::size_t BodyReserveBudget = 1 << 20; ///< Max segments reserved up front over all snakes
+
+private:
+    int width;                              ///< Board width in cells
+    int height;                             ///< Board height in cells
+    int foodTarget;                         ///< Number of food items kept on the board
+    ArenaFoodRules foodRules;               ///< Weights and lifetime of new food
+    std::uint32_t tick;                     ///< Ticks simulated so far
+
+    std::vector<Snake> snakes;              ///< All snakes, indexed by id
+    std::vector<std::uint8_t> alive;        ///< Non-zero while the snake is on the board
+    std::vector<std::uint8_t> autopilot;    ///< Non-zero if the arena steers the snake
+    std::vector<int> scores;                ///< Food eaten per snake since last spawn
+    std::vector<std::uint32_t> generations; ///< Incremented each time a snake (re)spawns
+
+    std::vector<std::uint16_t> cells;       ///< Occupancy grid: NoOwner, FoodCell or id + 1
+    FoodField food;                         ///< Food items: weights, expiry and nearest-food index
+    Bitboard freeCells;                     ///< Cells no snake covers (food counts as free), mirrors cells
+    BitboardGrid grid;                      ///< Flood-fill kernels and scratch for the autopilot
+    std::vector<std::uint32_t> claimTick;   ///< Tick in which a head last claimed each cell
+    std::vector<std::uint16_t> claimOwner;  ///< Snake id of that claim
+
+    std::vector<sf::Vector2i> nextHeads;    ///< Scratch: target cell per snake
+    std::vector<std::uint8_t> dying;        ///< Scratch: killed this tick
+    std::vector<std::uint16_t> deadList;    ///< Scratch: ids killed this tick
+    std::vector<int> foodSpawned;           ///< Cells that received food during the last step
+    std::vector<int> foodEaten;             ///< Cells whose food was eaten or expired during the last step
+
+    GameRng rng;                            ///< Spawning and autopilot randomness
+
+    int index(const sf::Vector2i& pos) const { return pos.y * width + pos.x; }
+
+    /**
+     * @brief Writes a cell of the occupancy grid and keeps freeCells in sync
+     */
+    void setCell(int cell, std::uint16_t owner) {
+        cells[cell] = owner;
+        if (owner == NoOwner || owner == FoodCell) {
+            freeCells.set(cell);
+        } else {
+            freeCells.reset(cell);
+        }
+    }
+    bool inBounds(const sf::Vector2i& pos) const {
+        return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height;
+    }
+
+    /**
+     * @brief Places a fresh snake on a random free row of three cells
+     * @param id Snake to place
+     * @return false if no free spot was found in a bounded number of tries
+     */
+    bool spawnSnake(std::size_t id);
+
+    /**
+     * @brief Places one food item on a random free cell
+     * @return false if no free cell was found in a bounded number of tries
+     */
+    bool spawnFood();
+
+    /**
+     * @brief Picks a direction for an autopilot snake
+     * 
+     * Heads for the nearest food within FoodSight cells, otherwise
+     * prefers the current heading (occasionally a random turn), and
+     * takes the first free neighbour whose reachable area, counted with
+     * a bounded bitboard flood fill, has room for the whole body. If
+     * none has, it picks the neighbour with the most room
+     */
+    void steer(std::size_t id);
+
+    /**
+     * @brief Removes a dead snake's cells from the occupancy grid
+     */
+    void clearSnake(std::size_t id);
+
+public:
+    /**
+     * @brief Creates an arena and spawns all snakes and food
+     * @param gridWidth Board width in cells
+     * @param gridHeight Board height in cells
+     * @param numSnakes Number of snakes; all start on autopilot
+     * @param foodCount Food items kept on the board
+     * @param seed Seed for spawning and autopilot decisions
+     * @param rules Food weights and lifetime
+     * @throws std::runtime_error if numSnakes exceeds MaxSnakes
+     */
+    Arena(int gridWidth, int gridHeight, std::size_t numSnakes, int foodCount, std::uint64_t seed,
+          const ArenaFoodRules& rules = ArenaFoodRules());
+
+    /**
+     * @brief Advances every live snake by one tick and resolves collisions
+     * @return Deaths, food eaten and respawns for this tick
+     * 
+     * Dead autopilot snakes respawn; dead human snakes stay dead
+     */
+    ArenaTickStats step();
+
+    /**
+     * @brief Hands a snake to a human/agent or back to the autopilot
+     */
+    void setAutopilot(std::size_t id, bool enabled) { autopilot[id] = enabled ? 1 : 0; }
+
+    /**
+     * @brief Requests a new direction for a snake's next move
+     */
+    void setDirection(std::size_t id, Direction dir) { snakes[id].setDirection(dir); }
+
+    bool isAlive(std::size_t id) const { return alive[id] != 0; }
+    const Snake& getSnake(std::size_t id) const { return snakes[id]; }
+    int getScore(std::size_t id) const { return scores[id]; }   ///< Sum of the weights eaten
+    std::uint32_t getGeneration(std::size_t id) const { return generations[id]; }
+    std::size_t snakeCount() const { return snakes.size(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    std::uint32_t getTick() const { return tick; }
+
+    /**
+     * @brief Gets the occupancy of a cell
+     * @return NoOwner, FoodCell or owning snake id + 1
+     */
+    std::uint16_t cellAt(int x, int y) const { return cells[y * width + x]; }
+
+    /**
+     * @brief Gets the food index, e.g. for nearest-food queries
+     */
+    const FoodField& getFood() const { return food; }
+
+    /**
+     * @brief Gets the cells (y * width + x) where food appeared during the last step
+     */
+    const std::vector<int>& getFoodSpawned() const { return foodSpawned; }
+
+    /**
+     * @brief Gets the cells (y * width + x) where food was eaten or expired during the last step
+     */
+    const std::vector<int>& getFoodEaten() const { return foodEaten; }
+};
@@ -0,0 +1,269 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Number of set bits in a word
+ */
+inline int popCount(std::uint64_t value) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(value));
+#else
+    return __builtin_popcountll(value);
+#endif
+}
+
+/**
+ * @brief Index of the lowest set bit
+ * @param value Non-zero value
+ */
+inline int lowestBit(std::uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+/**
+ * @brief One bit per cell of a width x height board
+ *
+ * Cell y * width + x is bit (cell % 64) of word (cell / 64), so the
+ * 40x30 board takes 19 words. Storage is padded so the shift kernels in
+ * BitboardGrid can read one row beyond either end and process four words
+ * at a time without bounds checks:
+ * - width / 64 + 1 zero guard words before and after the data
+ * - the data rounded up to a multiple of four words
+ * Guard, padding and the bits past the last cell always stay zero.
+ */
+class Bitboard {
+private:
+    int width{0};                        ///< Board width in cells
+    int height{0};                       ///< Board height in cells
+    std::size_t words{0};                ///< Words holding cells
+    std::size_t paddedWords{0};          ///< words rounded up to a multiple of 4
+    std::size_t guard{0};                ///< Zero words on each side of the data
+    std::vector<std::uint64_t> storage;  ///< guard + paddedWords + guard
+
+public:
+    Bitboard() = default;
+
+    /**
+     * @brief Creates an empty board
+     */
+    Bitboard(int boardWidth, int boardHeight);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int cellCount() const { return width * height; }
+
+    /**
+     * @brief Gets the number of words that hold cells
+     */
+    std::size_t wordCount() const { return words; }
+
+    /**
+     * @brief Gets the number of words kernels may touch (a multiple of 4)
+     */
+    std::size_t paddedWordCount() const { return paddedWords; }
+
+    std::uint64_t* data() { return storage.data() + guard; }
+    const std::uint64_t* data() const { return storage.data() + guard; }
+
+    void set(int cell) { data()[cell >> 6] |= std::uint64_t{1} << (cell & 63); }
+    void reset(int cell) { data()[cell >> 6] &= ~(std::uint64_t{1} << (cell & 63)); }
+    bool test(int cell) const { return (data()[cell >> 6] >> (cell & 63)) & 1; }
+
+    /**
+     * @brief Clears every cell
+     */
+    void clear();
+
+    /**
+     * @brief Sets every cell of the board
+     */
+    void fill();
+
+    /**
+     * @brief Counts the set cells
+     */
+    int count() const;
+
+    /**
+     * @brief Checks whether any cell is set
+     */
+    bool any() const;
+
+    /**
+     * @brief Checks whether the boards share a set cell
+     */
+    bool intersects(const Bitboard& other) const;
+
+    Bitboard& operator|=(const Bitboard& other);
+    Bitboard& operator&=(const Bitboard& other);
+
+    /**
+     * @brief Clears every cell set in other
+     */
+    Bitboard& andNot(const Bitboard& other);
+
+    /**
+     * @brief Clears every cell set in raw words of this board's layout
+     * @param bits wordCount() words, e.g. a Level's walls
+     */
+    Bitboard& andNot(const std::uint64_t* bits);
+
+    /**
+     * @brief Copies another board of the same size without reallocating
+     */
+    void assign(const Bitboard& other);
+
+    /**
+     * @brief Calls fn(int cell) for every set cell in increasing order
+     */
+    template <typename Fn>
+    void forEachCell(Fn&& fn) const {
+        const std::uint64_t* bits = data();
+        for (std::size_t i = 0; i < words; ++i) {
+            for (std::uint64_t word = bits[i]; word != 0; word &= word - 1) {
+                fn(static_cast<int>(i * 64) + lowestBit(word));
+            }
+        }
+    }
+};
+
+/**
+ * @brief Bit-parallel flood fill and distance kernels for one board size
+ *
+ * Every query works on whole Bitboards: a BFS layer is one pass of
+ * shift-and-mask over the words (the four neighbour shifts, column masks
+ * so rows do not wrap, AND with the passable cells and ANDNOT with the
+ * cells already reached), so a layer costs O(cells / 64) instead of
+ * O(cells) queue operations. A pass only covers the rows the query can
+ * have reached so far, which keeps small bounded queries on big boards
+ * cheap. On x86-64 the pass uses AVX2 (four words per instruction) when
+ * the CPU supports it, picked once at run time.
+ *
+ * A grid owns its scratch boards, so queries never allocate; use one
+ * grid per thread.
+ */
+class BitboardGrid {
+public:
+    static constexpr std::uint16_t Unreachable = 0xFFFF;   ///< Distance of cells that cannot be reached
+
+    /**
+     * @brief One layer step over words [begin, end) of the boards:
+     *        out = neighbours(in) & allowed & ~visited, visited |= out
+     * @return Number of cells in out
+     */
+    using LayerKernel = int (*)(const BitboardGrid& grid, std::size_t begin, std::size_t end,
+                                const std::uint64_t* in, const std::uint64_t* allowed,
+                                std::uint64_t* visited, std::uint64_t* out);
+
+private:
+    int width;                   ///< Board width in cells
+    int height;                  ///< Board height in cells
+    Bitboard board;              ///< Every cell
+    Bitboard notFirstColumn;     ///< Cells with x > 0
+    Bitboard notLastColumn;      ///< Cells with x < width - 1
+    Bitboard frontier;           ///< Scratch: current BFS layer (all zero between queries)
+    Bitboard nextLayer;          ///< Scratch: next BFS layer (all zero between queries)
+    Bitboard visited;            ///< Scratch: cells reached so far (all zero between queries)
+    int firstRow{0};             ///< First row the current query may have reached
+    int lastRow{0};              ///< Last row the current query may have reached
+    LayerKernel layerKernel;     ///< Scalar or AVX2 implementation
+
+    static int layerScalar(const BitboardGrid& grid, std::size_t begin, std::size_t end,
+                           const std::uint64_t* in, const std::uint64_t* allowed,
+                           std::uint64_t* visited, std::uint64_t* out);
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    static int layerAvx2(const BitboardGrid& grid, std::size_t begin, std::size_t end,
+                         const std::uint64_t* in, const std::uint64_t* allowed,
+                         std::uint64_t* visited, std::uint64_t* out);
+#endif
+
+    /**
+     * @brief Starts a query from one cell
+     */
+    void start(int from);
+
+    /**
+     * @brief Starts a query from a set of cells anywhere on the board
+     */
+    void startAll(const Bitboard& seeds);
+
+    /**
+     * @brief Gets the words covering the rows the query has reached
+     */
+    void windowWords(std::size_t& begin, std::size_t& end) const;
+
+    /**
+     * @brief Advances frontier by one layer through passable cells
+     * @return Number of newly reached cells (0 when the fill is complete)
+     */
+    int advance(const Bitboard& passable);
+
+    /**
+     * @brief Zeroes the scratch words the query touched
+     */
+    void finish();
+
+public:
+    /**
+     * @brief Precomputes the masks for a board size
+     * @param boardWidth Board width in cells
+     * @param boardHeight Board height in cells
+     */
+    BitboardGrid(int boardWidth, int boardHeight);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    /**
+     * @brief Checks whether the AVX2 kernel is in use
+     */
+    bool usesAvx2() const;
+
+    /**
+     * @brief Gets every cell, for building passable masks
+     */
+    const Bitboard& allCells() const { return board; }
+
+    /**
+     * @brief Finds every cell connected to the seeds through passable cells
+     * @param seeds Start cells (included in the region even if not passable)
+     * @param passable Cells that may be entered
+     * @param region Output board of the same size
+     */
+    void floodFill(const Bitboard& seeds, const Bitboard& passable, Bitboard& region);
+
+    /**
+     * @brief Counts the passable cells reachable from a cell
+     * @param from Start cell (need not be passable; not counted)
+     * @param passable Cells that may be entered
+     * @param limit Stop counting once this many cells were found
+     * @return Reachable cells, at most about limit plus one layer
+     */
+    int reachableArea(int from, const Bitboard& passable, int limit = 1 << 30);
+
+    /**
+     * @brief Computes BFS distances from a cell with one bitboard pass per layer
+     * @param from Start cell (distance 0, need not be passable)
+     * @param passable Cells that may be entered
+     * @param distances Output, one entry per cell; Unreachable where not reached
+     * @return Number of layers (largest finite distance)
+     */
+    int distanceMap(int from, const Bitboard& passable, std::vector<std::uint16_t>& distances);
+
+    /**
+     * @brief Gets the BFS distance between two cells, stopping at the target
+     * @return Distance, or -1 if to cannot be reached
+     */
+    int distance(int from, int to, const Bitboard& passable);
+};
@@ -0,0 +1,135 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Snake.hpp"
+#include "GameConfig.hpp"
+
+/**
+ * @brief Memory-compact snake for mass simulation
+ * 
+ * Behaves like Snake on the standard GameConfig grid, but stores:
+ * - Head and tail positions as 16-bit coordinates
+ * - One 2-bit direction per body link in a fixed bit ring buffer
+ * 
+ * Moving pushes the new heading at the head end and, unless growing,
+ * advances the tail by the oldest link, so move() and grow() are O(1).
+ * Segment coordinates are only decoded on demand (forEachSegment,
+ * decode, draw). The whole object is about 320 bytes for a 40x30 grid
+ * with no heap allocation, versus several KB for a long deque.
+ */
+class CompactSnake {
+public:
+    static constexpr int MaxSegments = GameConfig::GRID_WIDTH * GameConfig::GRID_HEIGHT;
+
+private:
+    static constexpr int MaxLinks = MaxSegments;                 ///< Ring capacity (length - 1 links used)
+    static constexpr int ChainWords = (2 * MaxLinks + 63) / 64;  ///< 64-bit words holding the ring
+
+    std::uint64_t chain[ChainWords];  ///< Link directions, oldest (tail) first, 2 bits each
+    std::int16_t headX, headY;        ///< Head position
+    std::int16_t tailX, tailY;        ///< Tail position
+    std::uint16_t firstLink;          ///< Ring index of the tail-most link
+    std::uint16_t linkCount;          ///< Number of links (length - 1)
+    Direction direction;              ///< Current movement direction
+    bool hasEaten;                    ///< Flag for pending growth
+
+    /**
+     * @brief Gets the direction of the i-th link counted from the tail
+     */
+    Direction link(int i) const {
+        int index = firstLink + i;
+        if (index >= MaxLinks) index -= MaxLinks;
+        return static_cast<Direction>((chain[index >> 5] >> ((index & 31) * 2)) & 3u);
+    }
+
+    /**
+     * @brief Appends a link at the head end
+     */
+    void pushLink(Direction dir);
+
+public:
+    /**
+     * @brief Creates a 3-segment snake with its head at (x, y), facing right
+     */
+    CompactSnake(int x, int y);
+
+    /**
+     * @brief Creates a 3-segment snake with its head at startPos, facing right
+     */
+    explicit CompactSnake(const sf::Vector2i& startPos) : CompactSnake(startPos.x, startPos.y) {}
+
+    /**
+     * @brief Puts a fresh 3-segment snake at a position
+     */
+    void reset(const sf::Vector2i& head) { *this = CompactSnake(head); }
+
+    /**
+     * @brief No-op: the chain is inline and already sized for the whole grid
+     */
+    void reserve(std::size_t) {}
+
+    /**
+     * @brief Sets new movement direction
+     * @note Cannot reverse directly into opposite direction
+     */
+    void setDirection(Direction newDir);
+
+    /**
+     * @brief Moves one step in the current direction in O(1)
+     */
+    void move();
+
+    /**
+     * @brief Triggers snake growth on next move
+     */
+    void grow() { hasEaten = true; }
+
+    /**
+     * @brief Checks for collisions with walls or self
+     * @return true if collision detected, false otherwise
+     */
+    bool checkCollision(const int gridWidth, const int gridHeight) const;
+
+    /**
+     * @brief Checks if snake head collides with food
+     * @return true if food eaten, false otherwise
+     */
+    bool eat(const sf::Vector2i& food);
+
+    /**
+     * @brief Renders snake to game window, decoding segments on the fly
+     */
+    void draw(sf::RenderWindow& window, const int cellSize) const;
+
+    /**
+     * @brief Checks whether any segment covers a cell
+     */
+    bool occupies(const sf::Vector2i& pos) const;
+
+    /**
+     * @brief Calls fn(const sf::Vector2i&) for every segment, head first
+     */
+    template <typename Fn>
+    void forEachSegment(Fn&& fn) const {
+        sf::Vector2i pos(headX, headY);
+        fn(pos);
+        for (int i = linkCount - 1; i >= 0; --i) {
+            pos = pos - directionOffset(link(i));
+            fn(pos);
+        }
+    }
+
+    /**
+     * @brief Decodes all segment positions, head first
+     * @param out Receives the positions (cleared first)
+     */
+    void decode(std::vector<sf::Vector2i>& out) const;
+
+    sf::Vector2i getHead() const { return sf::Vector2i(headX, headY); }
+    sf::Vector2i getTail() const { return sf::Vector2i(tailX, tailY); }
+    sf::Vector2i nextHead() const { return getHead() + directionOffset(direction); }
+    Direction getDirection() const { return direction; }
+    bool isGrowing() const { return hasEaten; }
+    std::size_t length() const { return static_cast<std::size_t>(linkCount) + 1; }
+};
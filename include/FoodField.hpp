@@ -0,0 +1,166 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief One result of FoodField::nearest()
+ */
+struct FoodHit {
+    int cell;                  ///< y * width + x
+    int distance;              ///< Manhattan distance from the query cell
+    std::uint16_t weight;      ///< Score the item is worth
+};
+
+/**
+ * @brief Many food items on one board, indexed for eating, expiry and nearest-k queries
+ *
+ * Items live in a fixed pool of slots, each linked into three intrusive
+ * lists, so nothing allocates after construction:
+ * - a dense cell -> slot table, so "is there food here" and eating are
+ *   one lookup and an O(1) unlink
+ * - a uniform grid of BucketSize x BucketSize buckets, each a doubly
+ *   linked list of its items, which nearest() walks ring by ring
+ *   outwards from the query cell and stops as soon as no farther ring
+ *   can beat the k-th hit
+ * - a timing wheel keyed by expiry tick, so expire() only visits items
+ *   that actually expire
+ *
+ * Food spawn positions are the owner's business; the field only
+ * indexes them.
+ */
+class FoodField {
+public:
+    static constexpr int BucketShift = 3;                    ///< log2 of the bucket side
+    static constexpr int BucketSize = 1 << BucketShift;      ///< Cells per bucket side
+    static constexpr int MaxNearest = 16;                    ///< Largest k nearest() accepts
+    static constexpr std::uint32_t Never = 0;                ///< expiresAt of items that stay until eaten
+
+private:
+    static constexpr int None = -1;                          ///< Null link / empty cell
+
+    /**
+     * @brief One pooled item and its list links
+     */
+    struct Slot {
+        int cell;                   ///< Board cell, None while the slot is free
+        std::uint32_t expiresAt;    ///< Tick the item disappears in, or Never
+        std::uint16_t weight;       ///< Score when eaten
+        int bucketNext;             ///< Bucket list links (the free list reuses bucketNext)
+        int bucketPrev;
+        int wheelNext;              ///< Timing wheel links
+        int wheelPrev;
+    };
+
+    int width;                          ///< Board width in cells
+    int height;                         ///< Board height in cells
+    int bucketsX;                       ///< Buckets per row
+    int bucketsY;                       ///< Bucket rows
+    std::uint32_t wheelMask;            ///< Timing wheel size - 1
+    std::vector<int> slotOfCell;        ///< Slot holding each cell's item, or None
+    std::vector<Slot> slots;            ///< Item pool
+    std::vector<int> bucketHeads;       ///< First slot of each bucket
+    std::vector<int> wheelHeads;        ///< First slot expiring in each wheel position
+    int freeHead{None};                 ///< First unused slot
+    std::size_t count{0};               ///< Items on the board
+
+    int bucketOf(int cell) const {
+        return ((cell / width) >> BucketShift) * bucketsX + ((cell % width) >> BucketShift);
+    }
+
+    /**
+     * @brief Unlinks a slot from its bucket, wheel and cell and returns it to the pool
+     */
+    void release(int slot);
+
+public:
+    /**
+     * @brief Creates an empty field
+     * @param boardWidth Board width in cells
+     * @param boardHeight Board height in cells
+     * @param capacity Most items on the board at once
+     * @param maxLifetime Longest lifetime add() will be given, in ticks (0 if items never expire)
+     */
+    FoodField(int boardWidth, int boardHeight, std::size_t capacity, std::uint32_t maxLifetime = 0);
+
+    /**
+     * @brief Places an item
+     * @param cell Empty cell (y * width + x)
+     * @param weight Score the item is worth
+     * @param expiresAt Tick it disappears in (now + lifetime, at most maxLifetime ahead), or Never
+     * @return false if the pool is full or the cell already holds food
+     */
+    bool add(int cell, std::uint16_t weight, std::uint32_t expiresAt = Never);
+
+    /**
+     * @brief Checks whether a cell holds food
+     */
+    bool has(int cell) const { return slotOfCell[cell] != None; }
+
+    /**
+     * @brief Gets the weight of the item on a cell
+     * @return Weight, or 0 if the cell holds no food
+     */
+    std::uint16_t weightAt(int cell) const {
+        const int slot = slotOfCell[cell];
+        return slot == None ? 0 : slots[slot].weight;
+    }
+
+    /**
+     * @brief Removes the item on a cell (it was eaten)
+     * @return Its weight, or 0 if the cell held no food
+     */
+    std::uint16_t remove(int cell);
+
+    /**
+     * @brief Removes every item whose expiry tick is tick
+     * @param tick Current tick; call once per tick without skipping any
+     * @param onExpired Called with the cell of each removed item
+     */
+    template <typename Fn>
+    void expire(std::uint32_t tick, Fn&& onExpired) {
+        if (wheelHeads.empty()) return;
+        int slot = wheelHeads[tick & wheelMask];
+        while (slot != None) {
+            const int next = slots[slot].wheelNext;
+            if (slots[slot].expiresAt == tick) {
+                const int cell = slots[slot].cell;
+                release(slot);
+                onExpired(cell);
+            }
+            slot = next;
+        }
+    }
+
+    /**
+     * @brief Finds the k items closest to a cell by Manhattan distance
+     * @param from Query position (may be off the board)
+     * @param out Receives up to k hits, nearest first
+     * @param k Hits wanted, at most MaxNearest
+     * @param maxDistance Ignore items farther than this
+     * @return Number of hits written
+     */
+    int nearest(const sf::Vector2i& from, FoodHit* out, int k, int maxDistance = INT_MAX) const;
+
+    /**
+     * @brief Calls fn(int cell, std::uint16_t weight) for every item, in no particular order
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Slot& slot : slots) {
+            if (slot.cell != None) fn(slot.cell, slot.weight);
+        }
+    }
+
+    /**
+     * @brief Removes every item
+     */
+    void clear();
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return slots.size(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+};
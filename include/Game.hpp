@@ -1,7 +1,20 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include "GameController.hpp"
 #include "GameConfig.hpp"
+#include "GameOptions.hpp"
+#include "events/EventRecorder.hpp"
+#include "render/FramePacer.hpp"
+#include "render/FrameSnapshot.hpp"
+#include "render/InputQueue.hpp"
+#include "render/SnapshotRenderer.hpp"
+#include "render/TripleBuffer.hpp"
+#include "replay/Session.hpp"
 
 /**
  * @brief Main game class that handles the game window and core game loop
@@ -9,55 +22,109 @@
  * The Game class is responsible for:
  * - Creating and managing the SFML window
  * - Loading and managing global resources (fonts)
- * - Running the main game loop
+ * - Running the simulation and render loops
  * - Delegating game logic to GameController
+ * 
+ * Two threads cooperate without locks:
+ * - The window thread polls events, forwards them through an InputQueue
+ *   and draws the newest FrameSnapshot at GameConfig::RENDER_RATE
+ * - The simulation thread owns the GameController, ticks it at
+ *   GameConfig::TICK_RATE and publishes snapshots through a TripleBuffer
+ * 
+ * A slow frame (vsync stall, driver hiccup) therefore never delays a tick.
+ * 
+ * Turbo mode (PageUp/PageDown/Home, or the speed constructor argument)
+ * multiplies the tick rate of running games, or lifts the cap entirely.
+ * Snapshots are then only published at RENDER_RATE, so the window
+ * shows the latest tick at display rate and describing frames never
+ * throttles the simulation. A ticks/s readout is drawn while turbo is on.
+ * 
+ * Both loops wait for their deadlines through a FramePacer instead of
+ * SFML's framerate limit, and record how late each frame and tick ran
+ * (snaike_frame_jitter_us, snaike_tick_jitter_us). A summary is
+ * printed when the game exits.
  */
 class Game {
 private:
     sf::RenderWindow window;     ///< SFML window for rendering
     sf::Font font;              ///< Global font resource
-    GameController gameController; ///< Manages game states and logic
+    GameController gameController; ///< Manages game states and logic (simulation thread)
+    SnapshotRenderer renderer;  ///< Draws snapshots (window thread)
+    InputQueue inputQueue;      ///< Window events, window thread -> simulation thread
+    TripleBuffer<FrameSnapshot> frames; ///< Snapshots, simulation thread -> window thread
+    std::atomic<bool> running{false};   ///< Cleared to stop the simulation thread
+    std::atomic<int> speed;             ///< Tick rate multiplier in games, 0 for uncapped (set by the window thread)
+    FramePacer framePacer;              ///< Waits for display frames (window thread)
+    FramePacer tickPacer;               ///< Waits for ticks (simulation thread)
+    double measuredTickRate{0};         ///< Ticks per second over the last second (simulation thread)
+    std::uint64_t snapshotsPublished{0}; ///< Snapshot counter (simulation thread)
+    std::chrono::steady_clock::time_point lastDisplay; ///< When the previous frame was shown (window thread)
+    std::unique_ptr<EventRecorder> eventLog; ///< Engine events for the window thread to print (null unless logging)
+    std::unique_ptr<Session> recording; ///< Key presses being recorded (simulation thread; null unless recording)
+    std::string recordingPath;          ///< Where the recording is saved on exit
+
+    /**
+     * @brief Describes the current state in the triple buffer's back slot and publishes it
+     */
+    void publishSnapshot();
+
+    /**
+     * @brief Applies a turbo key (window thread)
+     * @return false if the key is not a speed control and belongs to the game
+     */
+    bool handleSpeedKey(sf::Keyboard::Key key);
+
+    /**
+     * @brief Prints the event frames recorded since the last call to std::clog (window thread)
+     */
+    void printEvents();
 
 public:
     /**
      * @brief Constructs the game object
+     * @param options Spectating, agent, levels, speed, recording and logging settings
      * 
      * Initializes the SFML window, loads resources,
      * and sets up the GameController
      */
-    Game();
+    explicit Game(const GameOptions& options = GameOptions());
 
     /**
-     * @brief Starts and runs the main game loop
+     * @brief Starts and runs the game until the window closes
      * 
-     * Handles the core game loop which:
+     * Starts the simulation thread, then runs the window loop which:
      * 1. Processes events
-     * 2. Updates game logic
-     * 3. Renders the current frame
+     * 2. Renders the latest snapshot
+     * 3. Waits for the next frame at GameConfig::RENDER_RATE
+     * and joins the simulation thread on exit, printing the frame and
+     * tick jitter and saving the recorded session, if any
      */
     void run();
 
     /**
-     * @brief Processes all pending SFML events
+     * @brief Processes all pending SFML events (window thread)
      * 
-     * Handles window events and delegates game-specific
-     * events to the GameController
+     * Handles window events and speed keys and forwards
+     * game-specific events to the simulation thread
      */
     void processEvents();
 
     /**
-     * @brief Updates game logic for the current frame
+     * @brief Runs the simulation loop (simulation thread)
      * 
-     * Delegates update logic to GameController which
-     * then updates the current game state
+     * Applies queued input as it arrives, updates the GameController
+     * on a fixed tick schedule (shortened or dropped in turbo mode)
+     * and publishes a snapshot whenever something changed, at most
+     * once per display frame in turbo mode
      */
-    void update();
+    void simulate();
 
     /**
-     * @brief Renders the current frame
+     * @brief Renders the current frame (window thread)
      * 
-     * Clears the window, delegates rendering to
-     * GameController, and displays the frame
+     * Clears the window, draws the newest published
+     * snapshot and displays the frame, then prints any
+     * logged events
      */
     void render();
-};
\ No newline at end of file
+};
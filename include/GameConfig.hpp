@@ -12,7 +12,19 @@ public:
     static constexpr int CELL_SIZE = 20;
     static constexpr int GRID_WIDTH = 40;
     static constexpr int GRID_HEIGHT = 30;
-    static constexpr int FRAME_RATE = 10;
+    static constexpr int TICK_RATE = 10;     ///< Simulation ticks per second
+    static constexpr int RENDER_RATE = 60;   ///< Window frames per second
+
+    // Arena mode
+    static constexpr int ARENA_BOTS = 7;    ///< Autopilot opponents besides the player
+    static constexpr int ARENA_FOOD = 5;    ///< Food items kept on the board
+    static constexpr int ARENA_FOOD_LIFETIME = 150;  ///< Ticks an uneaten food item stays
+    static constexpr int ARENA_BONUS_CHANCE = 8;     ///< One food item in this many is a bonus item
+    static constexpr int ARENA_BONUS_WEIGHT = 5;     ///< Score of a bonus item
+
+    // Rewind (classic games)
+    static constexpr int REWIND_TICKS = 4096;            ///< Ticks of history kept for rewinding
+    static constexpr int REWIND_KEYFRAME_INTERVAL = 256; ///< Ticks between full keyframes in the history
 
     // Utility methods
     static constexpr int WindowWidth() { return GRID_WIDTH * CELL_SIZE; }
@@ -1,7 +1,17 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include "StateMachine.hpp"
+#include "Random.hpp"
 #include "Snake.hpp"
+#include "GameResources.hpp"
+#include "levels/LevelPack.hpp"
+#include "runlog/RunLog.hpp"
+#include "trajectory/TrajectoryWriter.hpp"
+#include "render/InputQueue.hpp"
 
 /**
  * @brief Controls game logic and manages state transitions
@@ -9,62 +19,175 @@
  * The GameController serves as the primary coordinator between:
  * - State management (through StateMachine)
  * - Game entities (Snake, Food)
- * - Resource management (Font, Window)
+ * - Resource management (Font)
  * - Game loop delegation (Input, Update, Render)
+ * 
+ * Runs on the simulation thread. It never touches the window; quitting
+ * raises a flag that the window thread polls.
  */
 class GameController {
 private:
-    StateMachine stateMachine;    ///< Manages game state transitions
     Snake snake;                  ///< Main player entity // TODO Consider moving this to exclusively within playing state
     sf::Vector2i food;           ///< Current food position
     sf::Font& font;              ///< Reference to global font resource
-    sf::RenderWindow* window;    ///< Pointer to game window for control
+    GameResources resources;     ///< Resources shared by all states (outlives them)
+    std::atomic<bool> quitRequested{false}; ///< Set by quitGame(), read by the window thread
+    std::string spectateSource;  ///< Spectator socket to watch instead of playing (empty to play)
+    std::string agentName;       ///< Controller that steers the player in classic games (empty for the keyboard)
+    std::uint64_t ticks{0};      ///< Ticks completed, for TickCompleted events
+    std::shared_ptr<const LevelPack> levels; ///< Obstacle levels for classic games (null for the open board)
+    std::unique_ptr<TrajectoryWriter> trajectories; ///< Records every classic game step (null unless recording)
+    std::unique_ptr<RunLog> runLog; ///< Finished classic games, shared with other instances (null unless logging)
+    std::uint64_t fixedSeed{0};  ///< Seed of every game while seedFixed is set
+    bool seedFixed{false};       ///< Games use fixedSeed instead of a random seed
+    bool rewindOnDeath{false};   ///< A death freezes classic games in rewind instead of ending them
+    StateMachine stateMachine;    ///< Manages game state transitions (last, so states go before the writer and log they use)
 
 public:
     /**
      * @brief Constructs the game controller
      * @param gameFont Reference to the global font resource
-     * @param gameWindow Pointer to the main game window
      */
-    explicit GameController(sf::Font& gameFont, sf::RenderWindow* gameWindow) 
-        : font(gameFont), window(gameWindow) {}
+    explicit GameController(sf::Font& gameFont) 
+        : font(gameFont), resources(gameFont) {}
     
+    /**
+     * @brief Switches the game into viewer mode
+     * @param socketPath Spectator socket published by another process
+     * @note Must be called before initializeGame()
+     */
+    void setSpectateSource(const std::string& socketPath) { spectateSource = socketPath; }
+
+    /**
+     * @brief Gets the spectator socket being watched
+     * @return Socket path, or empty when playing normally
+     */
+    const std::string& getSpectateSource() const { return spectateSource; }
+
+    /**
+     * @brief Lets a controller steer the player's snake in classic games
+     * @param name ControllerRegistry name, e.g. "flood" or "plugin:./libagent.so"
+     */
+    void setAgent(const std::string& name) { agentName = name; }
+
+    /**
+     * @brief Gets the controller steering the player
+     * @return Registry name, or empty for keyboard play
+     */
+    const std::string& getAgent() const { return agentName; }
+
+    /**
+     * @brief Plays classic games on levels of a pack, one picked at random per game
+     * @param pack Pack of GRID_WIDTH x GRID_HEIGHT levels, or null for the open board
+     */
+    void setLevelPack(std::shared_ptr<const LevelPack> pack) { levels = std::move(pack); }
+
+    /**
+     * @brief Gets the level pack classic games are played on
+     * @return Pack, or null for the open board
+     */
+    const LevelPack* getLevelPack() const { return levels.get(); }
+
+    /**
+     * @brief Records the steps of every classic game from now on
+     * @param writer Writer used from the simulation thread only, or null to stop recording
+     */
+    void setTrajectoryWriter(std::unique_ptr<TrajectoryWriter> writer) { trajectories = std::move(writer); }
+
+    /**
+     * @brief Gets the writer classic games are recorded to
+     * @return Writer, or null when not recording
+     */
+    TrajectoryWriter* getTrajectoryWriter() const { return trajectories.get(); }
+
+    /**
+     * @brief Appends every finished classic game to a run log, and ranks it on the game over screen
+     * @param log Log used from the simulation thread only, or null to stop logging
+     */
+    void setRunLog(std::unique_ptr<RunLog> log) { runLog = std::move(log); }
+
+    /**
+     * @brief Gets the run log finished games go to
+     * @return Log, or null when not logging
+     */
+    RunLog* getRunLog() const { return runLog.get(); }
+
+    /**
+     * @brief Starts every game (and its agent) from one seed instead of a random one
+     * @param seed Seed, so a recorded Session replays exactly
+     * @note Must be called before initializeGame(), as games are built ahead of time
+     */
+    void setGameSeed(std::uint64_t seed) { fixedSeed = seed; seedFixed = true; }
+
+    /**
+     * @brief Gets the seed for a new game
+     * @return The fixed seed if one was set, else a random seed
+     */
+    std::uint64_t nextGameSeed() const { return seedFixed ? fixedSeed : randomSeed(); }
+
+    /**
+     * @brief Makes a death in a classic game freeze it in rewind instead of ending it
+     * @param enabled true to inspect deaths before the game over screen (off by default,
+     *        so unattended agent runs go straight to game over)
+     */
+    void setRewindOnDeath(bool enabled) { rewindOnDeath = enabled; }
+
+    /**
+     * @brief Checks whether deaths freeze classic games in rewind
+     */
+    bool isRewindOnDeath() const { return rewindOnDeath; }
+
     /**
      * @brief Initializes the game state and resources
      * 
-     * Sets up initial game state (usually MenuState) and
-     * prepares game resources for use
+     * Sets up initial game state (MenuState, or SpectatorState
+     * in viewer mode) and prepares game resources for use
      */
     void initializeGame();
 
     /**
      * @brief Processes a single input event
-     * @param event SFML event to process
+     * @param input SFML event and the time it was polled
      * 
      * Delegates event handling to current game state
      */
-    void handleInput(const sf::Event& event);
+    void handleInput(const InputEvent& input);
 
     /**
      * @brief Updates game logic for current frame
      * 
-     * Processes state changes and updates current state
+     * Processes state changes, updates current state and
+     * publishes TickCompleted
      */
     void update();
 
     /**
-     * @brief Renders current game state
-     * @param window SFML window to render to
+     * @brief Describes the current game state for the renderer
+     * @param frame Snapshot to fill (cleared first)
      */
-    void render(sf::RenderWindow& window);
+    void render(FrameSnapshot& frame);
 
     /**
-     * @brief Closes the game window
+     * @brief Requests the game to exit
      * 
-     * Called when game should exit (e.g., from menu)
+     * Called when game should exit (e.g., from menu). Clears the
+     * states; the window thread closes the window once it sees
+     * isQuitRequested()
      */
     void quitGame();
+
+    /**
+     * @brief Checks whether quitGame() was called
+     * @return true once the game should exit (safe from any thread)
+     */
+    bool isQuitRequested() const { return quitRequested.load(std::memory_order_acquire); }
     
+    /**
+     * @brief Checks whether a game is being played (classic or arena)
+     * @return true if the current state is a PlayingState, so turbo speeds apply
+     */
+    bool isInGame() const;
+
     /**
      * @brief Gets reference to state machine
      * @return Reference to the game's state machine
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "levels/LevelPack.hpp"
+#include "render/FramePacer.hpp"
+
+/**
+ * @brief Settings of a windowed run, filled in from the command line
+ *
+ * Shared by Game and MosaicViewer; each reads the fields that apply to
+ * it (the mosaic uses agent, levels, speed, pacing and firstSeed).
+ */
+struct GameOptions {
+    std::string spectateSource;               ///< Spectator socket to watch, empty to play normally
+    std::string agent;                        ///< Controller or "plugin:<path>" steering the player, empty for the keyboard
+    std::shared_ptr<const LevelPack> levels;  ///< Level pack for classic games, null for the open board
+    bool logEvents = false;                   ///< Print state transitions and game events to std::clog
+    int speed = 1;                            ///< Tick rate multiplier for games, 0 for uncapped
+    std::string trajectoryDir;                ///< Directory to record classic games to as .npy chunks, empty to not record
+    PacingMode pacing = PacingMode::Yield;    ///< How the window and simulation loops wait for their deadlines
+    std::string runLogPath;                   ///< Shared run log to append finished classic games to, empty for none
+    std::string sessionPath;                  ///< File to record key presses to for replay_bench, empty for none
+    bool rewindOnDeath = false;               ///< Freeze classic games in rewind when the snake dies
+    std::uint64_t firstSeed = 1;              ///< Seed of the first mosaic tile; later games take the following seeds
+};
@@ -0,0 +1,156 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include "Snake.hpp"
+#include "CompactSnake.hpp"
+#include "Random.hpp"
+#include "GameConfig.hpp"
+#include "levels/Level.hpp"
+
+/**
+ * @brief Result of advancing a game session by one tick
+ */
+enum class StepOutcome {
+    Moved,  ///< Snake moved onto an empty cell
+    Ate,    ///< Snake reached the food and will grow on its next move
+    Died,   ///< Snake hit a wall or its own body
+    Filled  ///< Snake ate and covers every free cell: no room for more food, the game is over
+};
+
+/**
+ * @brief Contents of a single observation cell
+ */
+enum class CellType : std::uint8_t {
+    Empty = 0,  ///< Free cell
+    Body  = 1,  ///< Snake segment other than the head
+    Head  = 2,  ///< Snake head
+    Food  = 3,  ///< Current food position
+    Wall  = 4   ///< Obstacle of the current level
+};
+
+/**
+ * @brief Headless snake game rules
+ * 
+ * A GameSession owns everything needed to simulate one game without a window:
+ * - Snake entity and food position
+ * - Random number generator for food placement
+ * - Score and tick counters
+ * - The obstacle level being played (the open board by default)
+ * 
+ * PlayingState drives a session from keyboard input, while headless tools
+ * (such as the environment server) drive many sessions programmatically.
+ * 
+ * The snake representation is a template parameter: GameSession uses the
+ * deque-based Snake, CompactGameSession the direction-chain CompactSnake
+ * for keeping very many games resident. Both are explicitly instantiated
+ * in GameSession.cpp.
+ * 
+ * @tparam SnakeType Snake or CompactSnake
+ */
+template <typename SnakeType>
+class BasicGameSession {
+private:
+    SnakeType snake;          ///< Snake entity
+    sf::Vector2i food;        ///< Current food position
+    GameRng rng;              ///< Random number generator for food placement
+    int score;                ///< Food eaten this game
+    std::uint64_t tick;       ///< Ticks simulated this game
+    Level level;              ///< Walls, spawn and free cells (open board unless set)
+
+    /**
+     * @brief Spawns new food on a random cell not covered by the snake
+     * 
+     * On a level the cell is drawn from the free-cell list, so walls
+     * are never sampled
+     * @return false, leaving the food where it was, if the snake covers every free cell
+     */
+    bool spawnFood();
+
+public:
+    /// Number of cells in an observation written by writeObservation()
+    static constexpr int ObservationSize = GameConfig::GRID_WIDTH * GameConfig::GRID_HEIGHT;
+
+    /**
+     * @brief Creates a session with a fresh seed from std::random_device
+     */
+    BasicGameSession();
+
+    /**
+     * @brief Creates a session with a fixed seed
+     * @param seed Seed that fully determines food placement
+     */
+    explicit BasicGameSession(std::uint64_t seed);
+
+    /**
+     * @brief Restarts the game with a new seed
+     * @param seed Seed that fully determines food placement
+     * 
+     * Puts the snake back at the centre of the grid, clears
+     * score and tick counters and spawns new food
+     */
+    void reset(std::uint64_t seed);
+
+    /**
+     * @brief Selects the level played from the next reset() on
+     * @param newLevel Level of GRID_WIDTH x GRID_HEIGHT, or Level() for the open board
+     * @throws std::runtime_error if the level has a different board size
+     */
+    void setLevel(const Level& newLevel);
+
+    /**
+     * @brief Puts the session into a previously recorded state
+     * @param newSnake Snake to copy
+     * @param newFood Food position
+     * @param newRng Generator state, so later food spawns match the recording
+     * @param newScore Food eaten so far
+     * @param newTick Ticks simulated so far
+     *
+     * The level is kept. Used to resume a game from a rewound tick
+     */
+    void restore(const SnakeType& newSnake, const sf::Vector2i& newFood, const GameRng& newRng,
+                 int newScore, std::uint64_t newTick);
+
+    /**
+     * @brief Checks whether a cell on the board is a wall of the current level
+     */
+    bool isWall(const sf::Vector2i& pos) const {
+        return !level.isOpen() && level.isWall(pos.y * GameConfig::GRID_WIDTH + pos.x);
+    }
+
+    /**
+     * @brief Requests a new movement direction for the next step
+     * @param dir Desired direction
+     * @note Reversing into the body is ignored, as in Snake::setDirection
+     */
+    void setDirection(Direction dir) { snake.setDirection(dir); }
+
+    /**
+     * @brief Advances the game by one tick
+     * @return What happened to the snake during this tick
+     * 
+     * Moves the snake, checks for collisions, and handles
+     * food collection and respawning. Once the snake covers every
+     * free cell the step reports Filled instead of Ate; the game is
+     * over and must not be stepped again.
+     */
+    StepOutcome step();
+
+    /**
+     * @brief Writes the board as one CellType byte per cell
+     * @param cells Output buffer of at least ObservationSize bytes, row-major
+     */
+    void writeObservation(std::uint8_t* cells) const;
+
+    const SnakeType& getSnake() const { return snake; }
+    const sf::Vector2i& getFood() const { return food; }
+    int getScore() const { return score; }
+    std::uint64_t getTick() const { return tick; }
+    const GameRng& getRng() const { return rng; }
+    const Level& getLevel() const { return level; }
+};
+
+using GameSession = BasicGameSession<Snake>;
+using CompactGameSession = BasicGameSession<CompactSnake>;
+
+extern template class BasicGameSession<Snake>;
+extern template class BasicGameSession<CompactSnake>;
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Bump allocator for data that lives for one tick or one frame
+ *
+ * allocate() hands out memory from one block by advancing an offset;
+ * reset() makes the whole block reusable at once. Nothing is freed
+ * individually and no destructors run, so only trivially destructible
+ * data (characters, PODs) belongs here.
+ *
+ * When a round outgrows the block, the excess comes from overflow
+ * allocations and the next reset() replaces the block with one large
+ * enough for the whole round. After a few rounds at peak usage the
+ * arena stops touching the heap entirely.
+ */
+class MonotonicArena {
+private:
+    std::unique_ptr<std::byte[]> block;                   ///< Main storage
+    std::size_t capacity;                                 ///< Size of block in bytes
+    std::size_t used{0};                                  ///< Bytes handed out from block
+    std::size_t overflowBytes{0};                         ///< Bytes handed out from overflow this round
+    std::vector<std::unique_ptr<std::byte[]>> overflow;   ///< Chunks allocated once block was full
+
+public:
+    /**
+     * @brief Creates an arena
+     * @param initialCapacity Size of the first block in bytes
+     */
+    explicit MonotonicArena(std::size_t initialCapacity)
+        : block(new std::byte[initialCapacity])
+        , capacity(initialCapacity) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    /**
+     * @brief Allocates uninitialised memory valid until the next reset()
+     * @param size Bytes requested
+     * @param alignment Power-of-two alignment
+     */
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        const std::size_t start = (used + alignment - 1) & ~(alignment - 1);
+        if (start + size <= capacity) {
+            used = start + size;
+            return block.get() + start;
+        }
+        // Over-allocate so the chunk can be aligned like the block
+        overflow.emplace_back(new std::byte[size + alignment]);
+        overflowBytes += size + alignment;
+        const auto raw = reinterpret_cast<std::uintptr_t>(overflow.back().get());
+        return reinterpret_cast<void*>((raw + alignment - 1) & ~(alignment - 1));
+    }
+
+    /**
+     * @brief Copies a string into the arena
+     * @return View of the copy, valid until the next reset()
+     */
+    std::string_view copy(std::string_view text) {
+        if (text.empty()) return {};
+        char* chars = static_cast<char*>(allocate(text.size(), 1));
+        std::memcpy(chars, text.data(), text.size());
+        return std::string_view(chars, text.size());
+    }
+
+    /**
+     * @brief Releases everything allocated since the last reset
+     *
+     * If the round spilled into overflow chunks, the block is regrown to
+     * cover the whole round so the next one fits without overflow.
+     */
+    void reset() {
+        if (!overflow.empty()) {
+            capacity = capacity + overflowBytes;
+            block.reset(new std::byte[capacity]);
+            overflow.clear();
+            overflowBytes = 0;
+        }
+        used = 0;
+    }
+
+    /**
+     * @brief Gets the size of the main block in bytes
+     */
+    std::size_t getCapacity() const { return capacity; }
+};
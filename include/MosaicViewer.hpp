@@ -0,0 +1,154 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameOptions.hpp"
+#include "GameSession.hpp"
+#include "agents/Controller.hpp"
+#include "render/FramePacer.hpp"
+#include "render/MosaicRenderer.hpp"
+#include "render/MosaicSnapshot.hpp"
+#include "render/TickSchedule.hpp"
+#include "render/TripleBuffer.hpp"
+#ifdef SNAIKE_PLUGINS
+#include "agents/AgentPlugin.hpp"
+#endif
+
+/**
+ * @brief Window showing many agent games at once, one scaled board per tile
+ *
+ * For watching an agent over many seeds the way a tournament or a
+ * batched trainer plays it. Each tile plays consecutive seeds: when its
+ * game ends (death, a filled board, or starving in a loop) the tile flashes red and
+ * starts the next unplayed seed. The header shows the tick rate, the
+ * games finished and their mean and best scores; the tile of the
+ * leading live game is tinted.
+ *
+ * A plugin agent ("plugin:<path>") is loaded once with one slot per
+ * tile and asked for every tile's move in a single act_batch call per
+ * tick, the way Tournament::playBatch plays it; other agents get one
+ * controller instance per tile.
+ *
+ * Threads split as in Game: the simulation thread steps every game
+ * once per tick and describes all of them into one MosaicSnapshot at
+ * most once per display frame; the window thread draws the newest one
+ * through MosaicRenderer, one vertex buffer for all tiles. PageUp,
+ * PageDown and Home change the tick rate as in Game's turbo mode, and
+ * Escape closes the window.
+ */
+class MosaicViewer {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief One tile's game and its controller (simulation thread)
+     */
+    struct Tile {
+        GameSession session;                     ///< Game in progress
+        std::unique_ptr<Controller> controller;  ///< Agent playing it (null when a plugin plays every tile)
+        std::uint64_t seed;                      ///< Seed of the game in progress
+        std::uint64_t lastMeal;                  ///< Tick of the last food eaten
+        Clock::time_point endedAt;               ///< When the tile's previous game ended
+    };
+
+    sf::RenderWindow window;        ///< Mosaic window
+    sf::Font font;                  ///< Font for the header
+    MosaicRenderer renderer;        ///< Draws snapshots (window thread)
+    std::string agent;              ///< Controller name every tile plays
+    std::shared_ptr<const LevelPack> levels; ///< Pack to take each seed's level from, or null
+    std::vector<Tile> tiles;        ///< Games shown, in tile order (simulation thread)
+#ifdef SNAIKE_PLUGINS
+    std::unique_ptr<AgentPlugin> plugin;           ///< Plugin agent with one slot per tile, or null
+    std::vector<std::uint8_t> observations;        ///< Every tile's board for the plugin, tile-major
+    std::vector<const std::uint8_t*> observationSlots; ///< Per-tile pointers into observations
+    std::vector<std::uint8_t> actions;             ///< Plugin moves of the current tick
+#endif
+    TripleBuffer<MosaicSnapshot> frames; ///< Snapshots, simulation thread -> window thread
+    std::atomic<bool> running{false};    ///< Cleared to stop the simulation thread
+    std::atomic<int> speed;              ///< Tick rate multiplier, 0 for uncapped (set by the window thread)
+    FramePacer framePacer;               ///< Waits for display frames (window thread)
+    FramePacer tickPacer;                ///< Waits for ticks (simulation thread)
+    std::uint64_t nextSeed;              ///< Seed the next game to start plays
+    std::uint64_t gamesFinished{0};      ///< Games ended so far
+    std::uint64_t scoreTotal{0};         ///< Sum of finished games' scores
+    int bestScore{-1};                   ///< Best finished score, -1 before any game ends
+    std::uint64_t bestSeed{0};           ///< Seed of the best finished game
+    std::uint64_t snapshotsPublished{0}; ///< Snapshot counter (simulation thread)
+
+    /**
+     * @brief Starts the next seed on a tile
+     * @param index Tile (and plugin slot) to restart
+     */
+    void startGame(std::size_t index);
+
+    /**
+     * @brief Gets a tile's next move from its controller, or from the plugin's last batch
+     * @throws std::exception if the controller fails
+     */
+    Direction decide(std::size_t index);
+
+    /**
+     * @brief Checks whether a plugin plays every tile through one batch call
+     */
+    bool batched() const {
+#ifdef SNAIKE_PLUGINS
+        return plugin != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Steps every tile's game once, restarting the ones that end
+     */
+    void tick();
+
+    /**
+     * @brief Describes every tile and the header into the back slot and publishes it
+     * @param tickRate Measured ticks per second for the header
+     */
+    void publishSnapshot(double tickRate);
+
+    /**
+     * @brief Applies a turbo key (window thread)
+     * @return false if the key is not a speed control
+     */
+    bool handleSpeedKey(sf::Keyboard::Key key);
+
+public:
+    /**
+     * @brief Opens the window and starts a game on every tile
+     * @param numGames Tiles, each playing its own game
+     * @param options Agent playing every tile (registered controller or "plugin:<path>"),
+     *                level pack (seed s on level s % count), first seed, speed and pacing;
+     *                other fields are ignored
+     * @throws std::runtime_error if the agent cannot be created or the font cannot be loaded
+     */
+    MosaicViewer(int numGames, const GameOptions& options);
+
+    /**
+     * @brief Runs the window and simulation loops until the window closes
+     *
+     * Prints the finished games' statistics and the frame and tick jitter on exit
+     */
+    void run();
+
+    /**
+     * @brief Runs the simulation loop (simulation thread)
+     */
+    void simulate();
+
+    /**
+     * @brief Handles window events (window thread)
+     */
+    void processEvents();
+
+    /**
+     * @brief Draws the newest snapshot and displays it (window thread)
+     */
+    void render();
+};
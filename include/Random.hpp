@@ -0,0 +1,210 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Small-state, seedable random number generators
+ * 
+ * Every generator here:
+ * - Has 16 bytes of state, so games stay cheap to copy and clone
+ * - Is fully determined by a 64-bit seed (and optional stream id)
+ * - Satisfies UniformRandomBitGenerator, so std distributions still work
+ * - Offers bounded() for unbiased integers in [0, range)
+ * 
+ * GameRng selects the generator used by the game; swap the alias to
+ * change it everywhere.
+ */
+
+/**
+ * @brief SplitMix64 finalizer, used to expand and decorrelate seeds
+ * @param x Value to mix
+ * @return Well-mixed 64-bit value
+ */
+constexpr std::uint64_t mixSeed(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Derives an independent per-game seed from a master seed
+ * @param masterSeed Seed of the whole run (tournament, server, ...)
+ * @param stream Index of the game within the run
+ * @return Seed for that game
+ */
+constexpr std::uint64_t deriveSeed(std::uint64_t masterSeed, std::uint64_t stream) {
+    return mixSeed(masterSeed ^ mixSeed(stream + 0x632BE59BD9B4E019ull));
+}
+
+/**
+ * @brief Unbiased integer in [0, range) (Lemire's multiply-and-reject method)
+ * @param rng Generator producing uniform 32-bit values
+ * @param range Exclusive upper bound (> 0)
+ */
+template <typename Rng>
+std::uint32_t randomBounded(Rng& rng, std::uint32_t range) {
+    std::uint64_t product = static_cast<std::uint64_t>(rng()) * range;
+    auto low = static_cast<std::uint32_t>(product);
+    if (low < range) {
+        // Reject the few low words that would over-represent some results
+        const std::uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            product = static_cast<std::uint64_t>(rng()) * range;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+/**
+ * @brief Fills a buffer with unbiased integers in [0, range)
+ * @param rng Generator producing uniform 32-bit values
+ * @param out Output buffer of count values
+ * @param count Number of values to generate
+ * @param range Exclusive upper bound (> 0)
+ */
+template <typename Rng>
+void fillBounded(Rng& rng, std::uint32_t* out, std::size_t count, std::uint32_t range) {
+    const std::uint32_t threshold = (0u - range) % range;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t product = static_cast<std::uint64_t>(rng()) * range;
+        while (static_cast<std::uint32_t>(product) < threshold) {
+            product = static_cast<std::uint64_t>(rng()) * range;
+        }
+        out[i] = static_cast<std::uint32_t>(product >> 32);
+    }
+}
+
+/**
+ * @brief PCG32 (XSH-RR 64/32) generator with selectable stream
+ */
+class Pcg32 {
+private:
+    std::uint64_t state;      ///< LCG state
+    std::uint64_t increment;  ///< Odd LCG increment; selects the stream
+
+public:
+    using result_type = std::uint32_t;
+
+    /**
+     * @brief Seeds the generator
+     * @param seed 64-bit seed
+     * @param stream Stream id; different streams never overlap
+     */
+    explicit Pcg32(std::uint64_t seed = 0, std::uint64_t stream = 0) { this->seed(seed, stream); }
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0) {
+        state = 0;
+        increment = (mixSeed(stream) << 1) | 1u;
+        (*this)();
+        state += mixSeed(seed);
+        (*this)();
+    }
+
+    result_type operator()() {
+        const std::uint64_t old = state;
+        state = old * 6364136223846793005ull + increment;
+        const auto xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        const auto rot = static_cast<std::uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+    }
+
+    /**
+     * @brief Creates an independent generator for one game of a run
+     */
+    static Pcg32 forStream(std::uint64_t masterSeed, std::uint64_t stream) {
+        return Pcg32(masterSeed, stream);
+    }
+
+    std::uint32_t bounded(std::uint32_t range) { return randomBounded(*this, range); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Hashes the full generator state (for transposition tables)
+     */
+    std::uint64_t fingerprint() const { return mixSeed(state ^ mixSeed(increment)); }
+
+    bool operator==(const Pcg32& other) const { return state == other.state && increment == other.increment; }
+    bool operator!=(const Pcg32& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief xoshiro128++ generator
+ */
+class Xoshiro128pp {
+private:
+    std::uint32_t s[4];   ///< Generator state (never all zero)
+
+    static constexpr std::uint32_t rotl(std::uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+public:
+    using result_type = std::uint32_t;
+
+    /**
+     * @brief Seeds the generator
+     * @param seed 64-bit seed
+     * @param stream Stream id, mixed into the seed
+     */
+    explicit Xoshiro128pp(std::uint64_t seed = 0, std::uint64_t stream = 0) { this->seed(seed, stream); }
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0) {
+        const std::uint64_t a = mixSeed(deriveSeed(seed, stream));
+        const std::uint64_t b = mixSeed(a);
+        s[0] = static_cast<std::uint32_t>(a);
+        s[1] = static_cast<std::uint32_t>(a >> 32);
+        s[2] = static_cast<std::uint32_t>(b);
+        s[3] = static_cast<std::uint32_t>(b >> 32) | 1u;
+    }
+
+    result_type operator()() {
+        const std::uint32_t result = rotl(s[0] + s[3], 7) + s[0];
+        const std::uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+        return result;
+    }
+
+    /**
+     * @brief Creates an independent generator for one game of a run
+     */
+    static Xoshiro128pp forStream(std::uint64_t masterSeed, std::uint64_t stream) {
+        return Xoshiro128pp(masterSeed, stream);
+    }
+
+    std::uint32_t bounded(std::uint32_t range) { return randomBounded(*this, range); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Hashes the full generator state (for transposition tables)
+     */
+    std::uint64_t fingerprint() const {
+        const std::uint64_t low = s[0] | (static_cast<std::uint64_t>(s[1]) << 32);
+        const std::uint64_t high = s[2] | (static_cast<std::uint64_t>(s[3]) << 32);
+        return mixSeed(low ^ mixSeed(high));
+    }
+
+    bool operator==(const Xoshiro128pp& other) const {
+        return s[0] == other.s[0] && s[1] == other.s[1] && s[2] == other.s[2] && s[3] == other.s[3];
+    }
+    bool operator!=(const Xoshiro128pp& other) const { return !(*this == other); }
+};
+
+/// Generator used by GameSession, Arena and the built-in controllers
+using GameRng = Pcg32;
+
+static_assert(sizeof(GameRng) == 16, "game RNG state should stay at 16 bytes");
+
+/**
+ * @brief Draws a fresh 64-bit seed from std::random_device for interactive games
+ */
+std::uint64_t randomSeed();
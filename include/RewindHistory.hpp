@@ -0,0 +1,159 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameSession.hpp"
+
+/**
+ * @brief What one tick changed, enough to replay it forwards or undo it
+ *
+ * The new head is not stored: it is one step from the old head in the
+ * direction after the tick. When the snake ate, the food before the
+ * tick was the new head's cell.
+ */
+struct RewindDelta {
+    std::uint16_t tail;         ///< Cell the tail vacated (unused if growth was pending)
+    std::uint16_t food;         ///< Food cell after the tick
+    std::uint8_t directions;    ///< Direction before the tick (bits 0-1) and after it (bits 2-3)
+    std::uint8_t flags;         ///< WasGrowing | Ate
+};
+static_assert(sizeof(RewindDelta) == 6, "rewind deltas should stay 6 bytes");
+
+/**
+ * @brief Bounded history of a classic game for scrubbing backwards and forwards
+ *
+ * Recording keeps two fixed rings, allocated once:
+ * - one RewindDelta per tick (6 bytes) for the last `ticks` ticks
+ * - a full keyframe every `keyframeInterval` ticks: counters, food,
+ *   generator state and the body as a head cell plus 2-bit link
+ *   directions (about 300 bytes on the 40x30 board)
+ *
+ * Scrubbing moves a view snake one delta at a time, so each step back
+ * or forward is O(1). Long jumps and resuming start from the nearest
+ * keyframe at or before the target instead of the start of the game.
+ * Resuming replays at most one keyframe interval through the session
+ * itself, which also brings back the exact generator state, so the
+ * resumed game spawns the same food the recording did.
+ *
+ * Neither recording nor scrubbing allocates.
+ */
+class RewindHistory {
+public:
+    static constexpr std::uint8_t WasGrowing = 1;   ///< RewindDelta flag: growth was pending before the tick
+    static constexpr std::uint8_t Ate = 2;          ///< RewindDelta flag: the snake ate this tick
+
+private:
+    /**
+     * @brief Full state at one tick, body stored in the shared link pool
+     */
+    struct Keyframe {
+        std::uint64_t tick;         ///< Tick the state was taken after
+        GameRng rng;                ///< Food generator state
+        int score;                  ///< Food eaten so far
+        std::uint16_t head;         ///< Head cell
+        std::uint16_t food;         ///< Food cell
+        std::uint16_t length;       ///< Body segments
+        Direction direction;        ///< Movement direction
+        bool growing;               ///< Growth pending
+    };
+
+    std::size_t capacity;                   ///< Deltas kept
+    std::size_t keyframeInterval;           ///< Ticks between keyframes
+    std::vector<RewindDelta> deltas;        ///< Delta of tick t at t % capacity
+    std::vector<Keyframe> keyframes;        ///< Keyframe k (tick firstTick + k * interval) at k % size
+    std::vector<std::uint64_t> links;       ///< 2-bit link directions, linkWords per keyframe
+    std::size_t linkWords;                  ///< 64-bit words per keyframe body
+    std::vector<sf::Vector2i> segments;     ///< Scratch body for decoding a keyframe
+
+    std::uint64_t firstTick{0};             ///< Tick the recorded game started at
+    std::uint64_t oldest{0};                ///< Oldest tick that can still be viewed
+    std::uint64_t newest{0};                ///< Last recorded tick
+    RewindDelta pending{};                  ///< Delta being recorded between beginTick() and endTick()
+    int pendingScore{0};                    ///< Score before the tick being recorded
+
+    Snake view;                             ///< Snake at the viewed tick
+    sf::Vector2i viewFood;                  ///< Food at the viewed tick
+    int viewScore{0};                       ///< Score at the viewed tick
+    std::uint64_t cursor{0};                ///< Viewed tick
+
+    /**
+     * @brief Stores the session's current state as the keyframe of its tick
+     */
+    void writeKeyframe(const GameSession& session);
+
+    /**
+     * @brief Gets the keyframe at or before a recorded tick
+     */
+    const Keyframe& keyframeFor(std::uint64_t tick) const;
+
+    /**
+     * @brief Rebuilds a keyframe's body into the view snake
+     */
+    void loadKeyframe(const Keyframe& keyframe);
+
+public:
+    /**
+     * @brief Allocates the rings
+     * @param ticks Ticks of history to keep
+     * @param interval Ticks between keyframes (ticks is rounded up to a multiple of it)
+     */
+    explicit RewindHistory(std::size_t ticks = GameConfig::REWIND_TICKS,
+                           std::size_t interval = GameConfig::REWIND_KEYFRAME_INTERVAL);
+
+    /**
+     * @brief Forgets everything and starts recording a game at its current tick
+     */
+    void reset(const GameSession& session);
+
+    /**
+     * @brief Captures the state before a tick
+     *
+     * Call before the tick's direction change and step()
+     */
+    void beginTick(const GameSession& session);
+
+    /**
+     * @brief Records the tick begun by beginTick()
+     *
+     * Call after a step() the snake survived; a fatal tick is not recorded
+     */
+    void endTick(const GameSession& session);
+
+    /**
+     * @brief Moves the view one tick back
+     * @return false if the view is at the oldest recorded tick
+     */
+    bool stepBack();
+
+    /**
+     * @brief Moves the view one tick forward
+     * @return false if the view is at the newest recorded tick
+     */
+    bool stepForward();
+
+    /**
+     * @brief Moves the view to a tick, clamped to the recorded range
+     *
+     * Steps delta by delta when the target is within one keyframe
+     * interval of the view, otherwise starts from the nearest keyframe
+     */
+    void seek(std::uint64_t tick);
+
+    /**
+     * @brief Continues the game from the viewed tick
+     * @param session Session the history was recorded from
+     *
+     * Restores the session to the keyframe at or before the view and
+     * replays the recorded directions up to the view. The ticks after it
+     * are dropped from the history
+     */
+    void resume(GameSession& session);
+
+    std::uint64_t oldestTick() const { return oldest; }
+    std::uint64_t newestTick() const { return newest; }
+    std::uint64_t viewTick() const { return cursor; }
+    const Snake& getViewSnake() const { return view; }
+    const sf::Vector2i& getViewFood() const { return viewFood; }
+    int getViewScore() const { return viewScore; }
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Double-ended queue stored in one contiguous power-of-two ring
+ *
+ * Drop-in for the subset of std::deque the snake needs (push_front,
+ * pop_back, indexing, iteration), but popping never frees and pushing
+ * only allocates when the ring is full. Once reserve() covers the
+ * largest size reached, moving a snake performs no heap allocation,
+ * unlike std::deque which allocates and frees a block every time the
+ * ends cross a block boundary.
+ *
+ * @tparam T Element type (default-constructible, copyable)
+ */
+template <typename T>
+class RingDeque {
+private:
+    std::unique_ptr<T[]> slots;   ///< Ring storage
+    std::size_t mask{0};          ///< Capacity - 1 (capacity is a power of two, or 0)
+    std::size_t first{0};         ///< Slot of front()
+    std::size_t count{0};         ///< Number of elements
+
+    void grow(std::size_t minCapacity) {
+        std::size_t capacity = mask + 1 > 1 ? mask + 1 : 8;
+        while (capacity < minCapacity) capacity *= 2;
+
+        std::unique_ptr<T[]> larger(new T[capacity]);
+        for (std::size_t i = 0; i < count; ++i) {
+            larger[i] = std::move((*this)[i]);
+        }
+        slots = std::move(larger);
+        mask = capacity - 1;
+        first = 0;
+    }
+
+public:
+    /**
+     * @brief Random-access iterator from front() to back()
+     */
+    class const_iterator {
+    private:
+        const RingDeque* ring{nullptr};
+        std::size_t pos{0};
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        const_iterator(const RingDeque* owner, std::size_t index) : ring(owner), pos(index) {}
+
+        reference operator*() const { return (*ring)[pos]; }
+        pointer operator->() const { return &(*ring)[pos]; }
+        reference operator[](difference_type n) const { return (*ring)[pos + n]; }
+
+        const_iterator& operator++() { ++pos; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++pos; return old; }
+        const_iterator& operator--() { --pos; return *this; }
+        const_iterator operator--(int) { const_iterator old = *this; --pos; return old; }
+        const_iterator& operator+=(difference_type n) { pos += n; return *this; }
+        const_iterator& operator-=(difference_type n) { pos -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(ring, pos + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(ring, pos - n); }
+        difference_type operator-(const const_iterator& other) const {
+            return static_cast<difference_type>(pos) - static_cast<difference_type>(other.pos);
+        }
+
+        bool operator==(const const_iterator& other) const { return pos == other.pos; }
+        bool operator!=(const const_iterator& other) const { return pos != other.pos; }
+        bool operator<(const const_iterator& other) const { return pos < other.pos; }
+    };
+
+    RingDeque() = default;
+
+    RingDeque(const RingDeque& other) { *this = other; }
+    RingDeque(RingDeque&& other) noexcept { *this = std::move(other); }
+
+    RingDeque& operator=(RingDeque&& other) noexcept {
+        slots = std::move(other.slots);
+        mask = std::exchange(other.mask, 0);
+        first = std::exchange(other.first, 0);
+        count = std::exchange(other.count, 0);
+        return *this;
+    }
+
+    RingDeque& operator=(const RingDeque& other) {
+        if (this == &other) return *this;
+        clear();
+        if (other.count > capacity()) grow(other.count);
+        for (std::size_t i = 0; i < other.count; ++i) {
+            slots[i] = other[i];
+        }
+        count = other.count;
+        return *this;
+    }
+
+    /**
+     * @brief Ensures capacity for n elements without further allocation
+     */
+    void reserve(std::size_t n) {
+        if (n > capacity()) grow(n);
+    }
+
+    /**
+     * @brief Gets the number of elements the ring holds before it must grow
+     */
+    std::size_t capacity() const { return slots ? mask + 1 : 0; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Removes all elements, keeping the storage
+     */
+    void clear() {
+        first = 0;
+        count = 0;
+    }
+
+    void push_front(const T& value) {
+        if (count == capacity()) grow(count + 1);
+        first = (first - 1) & mask;
+        slots[first] = value;
+        ++count;
+    }
+
+    void push_back(const T& value) {
+        if (count == capacity()) grow(count + 1);
+        slots[(first + count) & mask] = value;
+        ++count;
+    }
+
+    void pop_front() {
+        first = (first + 1) & mask;
+        --count;
+    }
+
+    void pop_back() { --count; }
+
+    const T& operator[](std::size_t i) const { return slots[(first + i) & mask]; }
+    T& operator[](std::size_t i) { return slots[(first + i) & mask]; }
+
+    const T& front() const { return slots[first]; }
+    const T& back() const { return (*this)[count - 1]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
@@ -1,6 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <deque>
+#include "RingDeque.hpp"
 
 /**
  * @brief Represents possible movement directions for the snake
@@ -12,18 +12,46 @@ enum class Direction {
     Right   ///< Moving right (+x)
 };
 
+/**
+ * @brief Gets the grid offset of one step in a direction
+ * @param dir Direction of travel
+ * @return Unit vector for the direction
+ */
+inline sf::Vector2i directionOffset(Direction dir) {
+    switch (dir) {
+        case Direction::Up:    return sf::Vector2i(0, -1);
+        case Direction::Down:  return sf::Vector2i(0, 1);
+        case Direction::Left:  return sf::Vector2i(-1, 0);
+        case Direction::Right: return sf::Vector2i(1, 0);
+    }
+    return sf::Vector2i(0, 0);
+}
+
+/**
+ * @brief Gets the reverse of a direction
+ */
+inline Direction opposite(Direction dir) {
+    switch (dir) {
+        case Direction::Up:    return Direction::Down;
+        case Direction::Down:  return Direction::Up;
+        case Direction::Left:  return Direction::Right;
+        case Direction::Right: return Direction::Left;
+    }
+    return dir;
+}
+
 /**
  * @brief Represents the snake entity in the game
  * 
  * The Snake class manages:
- * - Snake body segments as a deque of positions
+ * - Snake body segments as a ring of positions (no allocation once reserved)
  * - Movement and direction control
  * - Collision detection with walls and self
  * - Growth mechanics when eating food
  */
 class Snake {
 private:
-    std::deque<sf::Vector2i> body;    ///< Snake body segments, front() is head
+    RingDeque<sf::Vector2i> body;     ///< Snake body segments, front() is head
     Direction direction;               ///< Current movement direction
     bool hasEaten;                    ///< Flag for pending growth
 
@@ -46,6 +74,18 @@ public:
      */
     Snake(const sf::Vector2i& startPos);
 
+    /**
+     * @brief Puts a fresh 3-segment snake at a position, reusing the body storage
+     * @param head Head position; the body trails to the left
+     */
+    void reset(const sf::Vector2i& head);
+
+    /**
+     * @brief Reserves body storage so growing up to n segments never allocates
+     * @param segments Longest length expected (e.g. the board's cell count)
+     */
+    void reserve(std::size_t segments) { body.reserve(segments); }
+
     /**
      * @brief Sets new movement direction
      * @param newDir New direction to move
@@ -53,6 +93,12 @@ public:
      */
     void setDirection(Direction newDir);
 
+    /**
+     * @brief Gets where the head will be after the next move
+     * @return Head position one step in the current direction
+     */
+    sf::Vector2i nextHead() const { return body.front() + directionOffset(direction); }
+
     /**
      * @brief Updates snake position based on current direction
      * Moves all body segments and handles growth if food was eaten
@@ -64,6 +110,23 @@ public:
      */
     void grow();
 
+    /**
+     * @brief Undoes the last move() in O(1)
+     * @param vacatedTail Cell the tail left (unused if growth was pending)
+     * @param previousDirection Direction before the move
+     * @param wasGrowing Whether growth was pending before the move
+     */
+    void unmove(const sf::Vector2i& vacatedTail, Direction previousDirection, bool wasGrowing);
+
+    /**
+     * @brief Replaces the whole snake, reusing the body storage
+     * @param segments Body positions, head first
+     * @param count Number of segments (at least 1)
+     * @param dir Movement direction
+     * @param growing Whether growth is pending
+     */
+    void restore(const sf::Vector2i* segments, std::size_t count, Direction dir, bool growing);
+
     /**
      * @brief Checks for collisions with walls or self
      * @param gridWidth Width of game grid
@@ -88,13 +151,53 @@ public:
 
     /**
      * @brief Gets const reference to snake body
-     * @return Deque of body segment positions
+     * @return Ring of body segment positions, head first
      */
-    const std::deque<sf::Vector2i>& getBody() const { return body; }
+    const RingDeque<sf::Vector2i>& getBody() const { return body; }
 
     /**
      * @brief Gets position of snake head
      * @return Vector representing head position
      */
     const sf::Vector2i& getHead() const { return body.front(); }
+
+    /**
+     * @brief Gets number of body segments
+     */
+    std::size_t length() const { return body.size(); }
+
+    /**
+     * @brief Calls fn(const sf::Vector2i&) for every segment, head first
+     */
+    template <typename Fn>
+    void forEachSegment(Fn&& fn) const {
+        for (const auto& segment : body) fn(segment);
+    }
+
+    /**
+     * @brief Checks whether any segment covers a cell
+     */
+    bool occupies(const sf::Vector2i& pos) const {
+        for (const auto& segment : body) {
+            if (segment == pos) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gets position of the last body segment
+     * @return Vector representing tail position
+     */
+    const sf::Vector2i& getTail() const { return body.back(); }
+
+    /**
+     * @brief Gets current movement direction
+     */
+    Direction getDirection() const { return direction; }
+
+    /**
+     * @brief Checks whether the tail will stay in place on the next move
+     * @return true if growth is pending
+     */
+    bool isGrowing() const { return hasEaten; }
 };
@@ -0,0 +1,18 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+
+/**
+ * @brief Gets the display colour for a snake
+ * @param id Snake index; 0 is the player and always green
+ * @return Colour used to draw the snake's segments
+ */
+inline sf::Color snakeColor(std::size_t id) {
+    static const sf::Color botColors[] = {
+        sf::Color(0, 160, 255), sf::Color(255, 200, 0), sf::Color(200, 0, 255),
+        sf::Color(255, 120, 0), sf::Color(0, 220, 200), sf::Color(255, 80, 160)
+    };
+    constexpr std::size_t numBotColors = sizeof(botColors) / sizeof(botColors[0]);
+
+    return id == 0 ? sf::Color::Green : botColors[(id - 1) % numBotColors];
+}
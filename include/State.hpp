@@ -2,6 +2,9 @@
 #include <SFML/Graphics.hpp>
 #include "GameResources.hpp"
 #include "GameConfig.hpp"
+#include "render/FrameSnapshot.hpp"
+#include "render/InputQueue.hpp"
+#include "states/StateTypes.hpp"
 
 class GameController;
 class StateMachine;
@@ -15,7 +18,9 @@ class StateMachine;
  * - Virtual methods for state lifecycle management
  * 
  * States represent different game modes (Menu, Playing, Paused, etc.)
- * and encapsulate the behavior and rendering for each mode.
+ * and encapsulate the behavior and rendering for each mode. States run
+ * on the simulation thread and never draw directly: render() describes
+ * the frame in a FrameSnapshot that the window thread draws later.
  */
 class State {
 protected:
@@ -37,8 +42,24 @@ public:
     
     virtual ~State() = default;
     virtual void handleInput(const sf::Event& event) = 0;
+
+    /**
+     * @brief Handles an input event together with the time it was polled
+     *
+     * Forwards to handleInput(); states that measure input latency
+     * override this instead.
+     */
+    virtual void handleTimedInput(const InputEvent& input) { handleInput(input.event); }
+
+    /**
+     * @brief Gets the type StateFactory builds this state for
+     *
+     * Used to describe transitions on the EventBus
+     */
+    virtual StateType getType() const = 0;
+
     virtual void update() = 0;
-    virtual void render(sf::RenderWindow& window) = 0;
+    virtual void render(FrameSnapshot& frame) const = 0;
     virtual void pause() {}
     virtual void resume() {}
 };
\ No newline at end of file
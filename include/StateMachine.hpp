@@ -1,7 +1,11 @@
 #pragma once
+#include <future>
+#include <map>
 #include <memory>
 #include <stack>
 #include "State.hpp"
+#include "events/EventBus.hpp"
+#include "states/StateTypes.hpp"
 
 /**
  * @brief Manages game state transitions and stack
@@ -11,6 +15,8 @@
  * - Safe state transitions (push, pop, replace)
  * - Deferred state changes through pending operations
  * - Access to current active state
+ * - States preloaded in the background (see StateFactory::preloadState)
+ * - An EventBus announcing every transition it applies
  */
 class StateMachine {
 private:
@@ -19,6 +25,8 @@ private:
     bool isRemoving{false};                        ///< Flag for pending pop operation
     bool isAdding{false};                          ///< Flag for pending push operation
     bool isReplacing{false};                       ///< Flag for pending replace operation
+    std::map<StateType, std::future<std::unique_ptr<State>>> preloads; ///< States being built ahead of time
+    EventBus events;                               ///< Engine events, published on the simulation thread
 
 public:
     /**
@@ -51,7 +59,9 @@ public:
      * - State additions
      * - State removals
      * - State replacements
-     * Also manages proper pause/resume of affected states
+     * Also manages proper pause/resume of affected states and
+     * publishes StatePopped, StatePushed or StateReplaced for each
+     * change applied
      */
     void processStateChanges();
 
@@ -72,12 +82,46 @@ public:
      * @brief Clears all states from the stack
      * 
      * Removes all states from the stack and clears pending changes
+     * and preloads (waiting for any still being built)
      */
     void clearStates();
+
+    /**
+     * @brief Stores a state being built on a worker thread
+     * @param type Type of the state
+     * @param state Future that yields the constructed state
+     * 
+     * Ignored if a preload of the same type is already stored
+     */
+    void addPreload(StateType type, std::future<std::unique_ptr<State>> state);
+
+    /**
+     * @brief Checks for a stored preload
+     * @param type Type of the state
+     * @return true if a state of this type is ready or being built
+     */
+    bool hasPreload(StateType type) const { return preloads.count(type) != 0; }
+
+    /**
+     * @brief Takes a preloaded state out of the machine for a transition
+     * @param type Type of the state
+     * @return The state (waiting for it if still being built), or null if none was preloaded
+     * @throws Whatever the state's constructor threw on the worker thread
+     *
+     * Every other preload is discarded (waiting for any still being
+     * built), found or not: preloads are the current state's candidate
+     * exits, so once it leaves by one the others can no longer be
+     * reached. The next state preloads its own exits.
+     */
+    std::unique_ptr<State> takePreload(StateType type);
+
+    /**
+     * @brief Gets the event bus shared by the machine and its states
+     * @return Bus to subscribe to or publish on (simulation thread only)
+     */
+    EventBus& getEvents() { return events; }
 };
 
-// TODO (1): Integrate observer pattern for state changes
-// TODO (2): Add state transition logging for debugging
 // TODO (3): Implement state stack clearing method
 // TODO (4): Add state stack size limit for safety
 // TODO (5): Implement state stack serialization for saving
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AgentPluginAbi.h"
+#include "Controller.hpp"
+
+/**
+ * @brief One instance of an agent loaded from a shared library
+ *
+ * Loads the library with dlopen, resolves the four entry points of
+ * AgentPluginAbi.h and creates an instance for a fixed number of slots.
+ * The library stays loaded for the lifetime of the object; several
+ * AgentPlugins may share one library (dlopen reference-counts it).
+ */
+class AgentPlugin {
+private:
+    void* library{nullptr};                   ///< dlopen handle
+    void* agent{nullptr};                     ///< Handle returned by init
+    SnaikeAgentResetFn resetFn{nullptr};      ///< Entry points
+    SnaikeAgentActBatchFn actBatchFn{nullptr};
+    SnaikeAgentShutdownFn shutdownFn{nullptr};
+    std::uint32_t slots;                      ///< max_batch given to init
+    std::string path;                         ///< Library path, for messages
+
+public:
+    /**
+     * @brief Loads a plugin and creates an instance
+     * @param libraryPath Path to the .so (a bare name is searched like any dlopen)
+     * @param maxBatch Slots; every actBatch() call passes exactly this many
+     * @throws std::runtime_error if the library or a symbol is missing, or init refuses
+     */
+    AgentPlugin(const std::string& libraryPath, std::uint32_t maxBatch);
+
+    /**
+     * @brief Destroys the instance and unloads the library
+     */
+    ~AgentPlugin();
+
+    AgentPlugin(const AgentPlugin&) = delete;
+    AgentPlugin& operator=(const AgentPlugin&) = delete;
+
+    /**
+     * @brief Tells the plugin a new game starts in a slot
+     */
+    void reset(std::uint32_t slot, std::uint64_t seed) { resetFn(agent, slot, seed); }
+
+    /**
+     * @brief Asks for one action per slot
+     * @param observations maxBatch() pointers into engine buffers (null for idle slots)
+     * @param actions Receives maxBatch() actions (0-3 in Direction order)
+     * @throws std::runtime_error if the plugin reports an error
+     */
+    void actBatch(const std::uint8_t* const* observations, std::uint8_t* actions);
+
+    std::uint32_t maxBatch() const { return slots; }
+    const std::string& getPath() const { return path; }
+};
+
+/**
+ * @brief Controller adapter driving a single game through a plugin
+ *
+ * For callers that play one game at a time (PlayingState, tournament
+ * replays); batched runners call AgentPlugin directly. Registered in
+ * ControllerRegistry under "plugin:<path>".
+ */
+class PluginController : public Controller {
+private:
+    AgentPlugin plugin;                     ///< Instance with one slot
+    std::vector<std::uint8_t> observation;  ///< Board written every decision
+
+public:
+    /**
+     * @brief Loads a plugin with one slot
+     * @throws std::runtime_error if the plugin cannot be loaded
+     */
+    explicit PluginController(const std::string& libraryPath);
+
+    void reset(std::uint64_t seed) override { plugin.reset(0, seed); }
+    Direction decide(const GameSession& session) override;
+};
+
+/**
+ * @brief Maps a plugin action to a direction
+ * @param action Value returned by act_batch
+ * @param current Direction to keep for invalid actions
+ */
+inline Direction actionDirection(std::uint8_t action, Direction current) {
+    return action < 4 ? static_cast<Direction>(action) : current;
+}
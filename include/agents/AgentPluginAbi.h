@@ -0,0 +1,92 @@
+#pragma once
+/*
+ * C ABI for agent plugins (shared libraries loaded with dlopen)
+ *
+ * A plugin exports the four functions below with C linkage. The engine
+ * calls them from one thread per agent instance; a plugin that keeps
+ * global state must make separate instances independent, because the
+ * tournament creates one instance per worker thread.
+ *
+ * Observations are the engine's own buffers, one byte per cell in
+ * row-major order with the values of SnaikeCell (the same layout as
+ * GameSession::writeObservation and the shared-memory environment).
+ * They are only valid during the call that receives them.
+ *
+ * This header must stay C-compatible and free of engine dependencies so
+ * plugins build without the game sources. Bump SNAIKE_AGENT_ABI_VERSION
+ * on any incompatible change.
+ */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SNAIKE_AGENT_ABI_VERSION 1u
+
+#if defined(_WIN32)
+#define SNAIKE_AGENT_EXPORT __declspec(dllexport)
+#else
+#define SNAIKE_AGENT_EXPORT __attribute__((visibility("default")))
+#endif
+
+/** Contents of one observation byte */
+enum SnaikeCell {
+    SNAIKE_CELL_EMPTY = 0,
+    SNAIKE_CELL_BODY = 1,
+    SNAIKE_CELL_HEAD = 2,
+    SNAIKE_CELL_FOOD = 3,
+    SNAIKE_CELL_WALL = 4         /* Only on obstacle levels (level packs) */
+};
+
+/** Action values (Direction order); anything else keeps the current direction */
+enum SnaikeAction {
+    SNAIKE_ACTION_UP = 0,
+    SNAIKE_ACTION_DOWN = 1,
+    SNAIKE_ACTION_LEFT = 2,
+    SNAIKE_ACTION_RIGHT = 3
+};
+
+/** Settings passed to snaike_agent_init */
+typedef struct SnaikeAgentConfig {
+    uint32_t abi_version;        /* SNAIKE_AGENT_ABI_VERSION of the engine */
+    uint32_t grid_width;         /* Board width in cells */
+    uint32_t grid_height;        /* Board height in cells */
+    uint32_t observation_size;   /* Bytes per observation (grid_width * grid_height) */
+    uint32_t max_batch;          /* Slots, and the n of every snaike_agent_act_batch call */
+} SnaikeAgentConfig;
+
+/*
+ * Creates an agent instance.
+ * Returns an opaque handle passed to the other functions, or NULL to
+ * refuse (for example an unsupported abi_version or board size).
+ */
+typedef void* (*SnaikeAgentInitFn)(const SnaikeAgentConfig* config);
+
+/*
+ * A new game starts in a slot (0 <= slot < max_batch); drop any state
+ * kept for the previous game there. seed is the game's seed.
+ */
+typedef void (*SnaikeAgentResetFn)(void* agent, uint32_t slot, uint64_t seed);
+
+/*
+ * Chooses one action per slot.
+ * observations[i] is the board of the game in slot i, or NULL if the
+ * slot is idle (its action is ignored). actions_out has n entries.
+ * Returns 0 on success; any other value aborts the affected games.
+ */
+typedef int (*SnaikeAgentActBatchFn)(void* agent, const uint8_t* const* observations, uint32_t n,
+                                     uint8_t* actions_out);
+
+/* Destroys an instance created by snaike_agent_init. */
+typedef void (*SnaikeAgentShutdownFn)(void* agent);
+
+/* Exported symbol names */
+#define SNAIKE_AGENT_INIT_SYMBOL "snaike_agent_init"
+#define SNAIKE_AGENT_RESET_SYMBOL "snaike_agent_reset"
+#define SNAIKE_AGENT_ACT_BATCH_SYMBOL "snaike_agent_act_batch"
+#define SNAIKE_AGENT_SHUTDOWN_SYMBOL "snaike_agent_shutdown"
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include "Controller.hpp"
+#include "../Bitboard.hpp"
+#include "../Random.hpp"
+
+/**
+ * @brief Moves randomly, avoiding walls and body cells when it can
+ */
+class RandomController : public Controller {
+private:
+    GameRng rng;   ///< Seeded per game in reset()
+
+public:
+    void reset(std::uint64_t seed) override { rng.seed(seed, 1); }
+    Direction decide(const GameSession& session) override;
+};
+
+/**
+ * @brief Heads straight for the food, avoiding immediately fatal moves
+ * 
+ * Among the safe directions it picks the one that most reduces the
+ * Manhattan distance to the food, preferring its current heading on ties.
+ */
+class GreedyController : public Controller {
+public:
+    void reset(std::uint64_t) override {}
+    Direction decide(const GameSession& session) override;
+};
+
+/**
+ * @brief Follows the shortest free path to the food without boxing itself in
+ * 
+ * Built on the BitboardGrid kernels: one distance map from the food over
+ * the free cells ranks the moves, and a bounded reachable-area count
+ * rejects moves into regions too small for the body. When every move is
+ * too tight it takes the one with the most room.
+ */
+class FloodFillController : public Controller {
+private:
+    BitboardGrid grid;                       ///< Kernels and scratch for the game board
+    Bitboard freeCells;                      ///< Scratch: cells the head may enter next tick
+    std::vector<std::uint16_t> distances;    ///< Scratch: path length to the food per cell
+
+public:
+    FloodFillController();
+    void reset(std::uint64_t) override {}
+    Direction decide(const GameSession& session) override;
+};
+
+/**
+ * @brief Checks whether moving one step in a direction kills the snake
+ * @param session Current game state
+ * @param dir Candidate direction
+ * @return true if the target cell is a wall or a body segment that will not move away
+ */
+bool isFatalMove(const GameSession& session, Direction dir);
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include "../GameSession.hpp"
+
+/**
+ * @brief Abstract base class for snake controllers (agents)
+ * 
+ * A controller picks the snake's direction once per tick from the
+ * current game session. Controllers may keep per-game state, which
+ * reset() clears; all randomness must derive from the reset seed so
+ * games are reproducible.
+ */
+class Controller {
+public:
+    virtual ~Controller() = default;
+
+    /**
+     * @brief Prepares for a new game
+     * @param seed Seed of the game about to start
+     */
+    virtual void reset(std::uint64_t seed) = 0;
+
+    /**
+     * @brief Chooses the direction for the next step
+     * @param session Current game state
+     * @return Direction to pass to GameSession::setDirection
+     */
+    virtual Direction decide(const GameSession& session) = 0;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Controller.hpp"
+
+/**
+ * @brief Name-based factory for controllers
+ * 
+ * Built-in controllers are registered on first use; tools look
+ * controllers up by name so new agents only need a registration.
+ * Names of the form "plugin:<path>" load an agent plugin (a shared
+ * library implementing AgentPluginAbi.h) instead; they need no
+ * registration and are not listed by names().
+ */
+class ControllerRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<Controller>()>;
+
+    static constexpr const char* PluginPrefix = "plugin:";   ///< Prefix of plugin names
+
+    /**
+     * @brief Registers a controller under a name, replacing any previous entry
+     * @param name Name used on command lines and in reports
+     * @param factory Creates a fresh controller instance
+     */
+    static void add(const std::string& name, Factory factory);
+
+    /**
+     * @brief Creates a controller by name
+     * @param name Registered controller name or "plugin:<path>"
+     * @return New controller instance
+     * @throws std::runtime_error if no controller has that name, or a plugin cannot be loaded
+     */
+    static std::unique_ptr<Controller> create(const std::string& name);
+
+    /**
+     * @brief Checks whether a name refers to an agent plugin
+     */
+    static bool isPluginName(const std::string& name);
+
+    /**
+     * @brief Gets the library path of a plugin name
+     */
+    static std::string pluginPath(const std::string& name);
+
+    /**
+     * @brief Gets all registered controller names in registration order
+     */
+    static std::vector<std::string> names();
+};
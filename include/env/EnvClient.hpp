@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "SharedEnvLayout.hpp"
+
+/**
+ * @brief Trainer-side handle to an EnvServer
+ * 
+ * Maps the server's shared memory segment and provides:
+ * - Non-blocking action submission for any game
+ * - Blocking receipt of step results
+ * - Zero-copy access to each game's observation
+ * 
+ * Keep at most one action outstanding per game: the observation slot
+ * is only stable between receiving a game's result and sending its
+ * next action.
+ */
+class EnvClient {
+private:
+    SharedEnvHeader* header;   ///< Mapped segment
+    std::size_t mappedBytes;   ///< Size of the mapping
+
+public:
+    /**
+     * @brief Attaches to a running server
+     * @param shmName POSIX shared memory name used by the server
+     * @param timeoutMs How long to wait for the server to become ready
+     * @throws std::runtime_error if the segment is missing or incompatible
+     */
+    explicit EnvClient(const std::string& shmName = SharedEnvDefaultName, int timeoutMs = 5000);
+
+    /**
+     * @brief Unmaps the segment (the server owns and unlinks it)
+     */
+    ~EnvClient();
+
+    EnvClient(const EnvClient&) = delete;
+    EnvClient& operator=(const EnvClient&) = delete;
+
+    /**
+     * @brief Checks that the server still serves the segment
+     * @return false once the server has shut down or its process has exited
+     */
+    bool serverAlive() const;
+
+    /**
+     * @brief Queues an action for one game
+     * @param envIndex Game to advance
+     * @param action Direction 0-3 or EnvActionReset
+     * @throws std::out_of_range if envIndex is not below numEnvs()
+     * @throws std::runtime_error if the server is gone while the action ring is full
+     */
+    void send(std::uint32_t envIndex, std::uint32_t action);
+
+    /**
+     * @brief Waits for the next step result from any game
+     * @return Result; the game's observation slot is up to date
+     * @throws std::runtime_error if the server is gone
+     */
+    EnvStepResult receive();
+
+    /**
+     * @brief Sends one action and waits for its result
+     * @param envIndex Game to advance
+     * @param action Direction 0-3 or EnvActionReset
+     * @return Result for that game
+     * @throws std::out_of_range if envIndex is not below numEnvs()
+     * @throws std::runtime_error if the server is gone
+     * @note Only valid when no other actions are outstanding
+     */
+    EnvStepResult step(std::uint32_t envIndex, std::uint32_t action);
+
+    /**
+     * @brief Gets a game's current observation (row-major CellType bytes)
+     */
+    const std::uint8_t* observation(std::uint32_t envIndex) const {
+        return sharedEnvObservation(header, envIndex);
+    }
+
+    std::uint32_t numEnvs() const { return header->numEnvs; }
+    std::uint32_t gridWidth() const { return header->gridWidth; }
+    std::uint32_t gridHeight() const { return header->gridHeight; }
+};
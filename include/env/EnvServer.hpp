@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameSession.hpp"
+#include "SharedEnvLayout.hpp"
+
+class SpectatorPublisher;
+
+/**
+ * @brief Exposes N headless games to another process over shared memory
+ * 
+ * The EnvServer:
+ * - Creates and maps a POSIX shared memory segment
+ * - Owns one CompactGameSession per game (under 400 bytes each, no heap)
+ * - Consumes EnvAction messages, steps the addressed game, writes its
+ *   observation in place and publishes an EnvStepResult
+ * 
+ * Games that end are reset automatically; the result carries done = 1
+ * and the observation slot already shows the first frame of the next game.
+ * A request for a game that does not exist is answered with status
+ * EnvStatusBadIndex instead of a step.
+ */
+class EnvServer {
+private:
+    std::string name;                   ///< Shared memory object name
+    SharedEnvHeader* header;            ///< Mapped segment
+    std::size_t mappedBytes;            ///< Size of the mapping
+    std::vector<CompactGameSession> sessions; ///< One game per slot
+    std::uint64_t masterSeed;           ///< Seed of the whole server run
+    std::uint64_t nextStream;           ///< Stream index for the next reset
+    std::atomic<bool> stopRequested{false}; ///< Set by stop()
+    SpectatorPublisher* spectator;      ///< Optional publisher for game 0
+
+    /**
+     * @brief Applies one action and publishes its result
+     * @param action Action received from the client
+     */
+    void handleAction(const EnvAction& action);
+
+    /**
+     * @brief Pushes a result, waiting while the client drains the ring
+     */
+    void publishResult(const EnvStepResult& result);
+
+public:
+    /**
+     * @brief Creates the shared memory segment and initial games
+     * @param shmName POSIX shared memory name (e.g. "/snaike_env")
+     * @param numEnvs Number of games to expose
+     * @param seed Master seed; every game's seed is derived from it with deriveSeed()
+     * @throws std::runtime_error if the segment cannot be created
+     */
+    EnvServer(const std::string& shmName, std::uint32_t numEnvs, std::uint64_t seed);
+
+    /**
+     * @brief Unmaps and unlinks the shared memory segment
+     */
+    ~EnvServer();
+
+    EnvServer(const EnvServer&) = delete;
+    EnvServer& operator=(const EnvServer&) = delete;
+
+    /**
+     * @brief Serves actions until stop() is called
+     * 
+     * Blocks on the action ring between requests, waking
+     * periodically to notice stop requests
+     */
+    void run();
+
+    /**
+     * @brief Streams game 0 to spectators after each of its steps
+     * @param publisher Publisher to use, or nullptr to stop streaming
+     */
+    void setSpectator(SpectatorPublisher* publisher) { spectator = publisher; }
+
+    /**
+     * @brief Asks run() to return; safe to call from a signal handler
+     */
+    void stop() { stopRequested.store(true, std::memory_order_relaxed); }
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief Thin wrappers around the Linux futex syscall
+ * 
+ * Used to park a thread on a 32-bit atomic that lives in memory shared
+ * between processes. The non-private futex operations are used so the
+ * kernel keys the wait queue on the physical page, not the mapping.
+ */
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+              "futex words must be plain 32-bit integers");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+              "futex words must be lock-free");
+
+/**
+ * @brief Blocks while *word == expected
+ * @param word Futex word
+ * @param expected Value observed before deciding to sleep
+ * @param timeoutNs Relative timeout in nanoseconds, or 0 to wait forever
+ * 
+ * Returns immediately if the word no longer holds expected. May also
+ * return spuriously, so callers must re-check their condition.
+ */
+inline void futexWait(std::atomic<std::uint32_t>* word, std::uint32_t expected, long timeoutNs = 0) {
+    timespec timeout{timeoutNs / 1000000000L, timeoutNs % 1000000000L};
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT, expected,
+            timeoutNs > 0 ? &timeout : nullptr, nullptr, 0);
+}
+
+/**
+ * @brief Wakes threads blocked in futexWait on word
+ * @param word Futex word
+ * @param count Maximum number of waiters to wake
+ */
+inline void futexWake(std::atomic<std::uint32_t>* word, int count = INT_MAX) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE, count,
+            nullptr, nullptr, 0);
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "SpscRing.hpp"
+
+/**
+ * @brief Wire format shared by EnvServer and EnvClient
+ * 
+ * A shared memory segment holds a SharedEnvHeader followed by one
+ * observation slot per game. Actions flow client -> server and step
+ * results flow server -> client through SpscRing instances in the header.
+ * Observations are never copied through the rings: the server writes
+ * them into the game's slot before publishing the step result.
+ * 
+ * This header deliberately has no SFML or game dependencies so a
+ * trainer can link the client without the rest of the game.
+ */
+
+constexpr std::uint32_t SharedEnvMagic = 0x534E4B45;       ///< "SNKE"
+constexpr std::uint32_t SharedEnvVersion = 2;
+constexpr std::uint32_t SharedEnvRingCapacity = 4096;      ///< Also the maximum number of games
+constexpr const char* SharedEnvDefaultName = "/snaike_env";
+
+/// Action value requesting a fresh game instead of a move
+constexpr std::uint32_t EnvActionReset = 0xFFFFFFFFu;
+
+/// EnvStepResult::status of a step that was carried out
+constexpr std::uint32_t EnvStatusOk = 0;
+/// EnvStepResult::status of a request naming a game the server does not have
+constexpr std::uint32_t EnvStatusBadIndex = 1;
+
+/**
+ * @brief Client -> server request for one game
+ */
+struct EnvAction {
+    std::uint32_t envIndex;   ///< Game to advance
+    std::uint32_t action;     ///< Direction as 0-3 (Up, Down, Left, Right) or EnvActionReset
+};
+
+/**
+ * @brief Server -> client result of one step
+ */
+struct EnvStepResult {
+    std::uint32_t envIndex;   ///< Game that was advanced
+    float reward;             ///< +1 for food, -1 for death, 0 otherwise
+    std::uint32_t done;       ///< Non-zero if the game ended on this step
+    std::uint32_t score;      ///< Score after this step (before any automatic reset)
+    std::uint32_t status;     ///< EnvStatusOk, or why the request was rejected (nothing else is set)
+    std::uint64_t tick;       ///< Tick counter after this step
+};
+
+/**
+ * @brief Control block at the start of the shared memory segment
+ */
+struct SharedEnvHeader {
+    std::uint32_t magic;                  ///< SharedEnvMagic once initialized
+    std::uint32_t version;                ///< SharedEnvVersion
+    std::uint32_t numEnvs;                ///< Number of games
+    std::uint32_t observationSize;        ///< Bytes per observation slot
+    std::uint32_t gridWidth;              ///< Board width in cells
+    std::uint32_t gridHeight;             ///< Board height in cells
+    std::int32_t serverPid;               ///< Server process, so clients notice it is gone
+    std::atomic<std::uint32_t> ready{0};  ///< Set by the server after initial observations are written
+
+    SpscRing<EnvAction, SharedEnvRingCapacity> actions;      ///< Client -> server
+    SpscRing<EnvStepResult, SharedEnvRingCapacity> results;  ///< Server -> client
+};
+
+/**
+ * @brief Offset of the first observation slot from the segment start
+ */
+constexpr std::size_t sharedEnvObservationOffset() {
+    return (sizeof(SharedEnvHeader) + 63) & ~static_cast<std::size_t>(63);
+}
+
+/**
+ * @brief Total segment size for a given configuration
+ */
+constexpr std::size_t sharedEnvBytes(std::uint32_t numEnvs, std::uint32_t observationSize) {
+    return sharedEnvObservationOffset() + static_cast<std::size_t>(numEnvs) * observationSize;
+}
+
+/**
+ * @brief Gets the observation slot for one game
+ */
+inline std::uint8_t* sharedEnvObservation(SharedEnvHeader* header, std::uint32_t envIndex) {
+    return reinterpret_cast<std::uint8_t*>(header) + sharedEnvObservationOffset() +
+           static_cast<std::size_t>(envIndex) * header->observationSize;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Futex.hpp"
+
+/**
+ * @brief Lock-free single-producer/single-consumer ring buffer
+ * 
+ * Designed to be placed in POSIX shared memory:
+ * - Fixed capacity, no pointers, trivially copyable payload
+ * - Head and tail are 32-bit counters that double as futex words
+ * - The consumer spins briefly, then sleeps on the head counter;
+ *   the producer only issues a wake syscall when a consumer is asleep
+ * 
+ * Exactly one thread may push and exactly one thread may pop.
+ * 
+ * @tparam T Message type (must be trivially copyable)
+ * @tparam Capacity Number of slots (must be a power of two)
+ */
+template <typename T, std::uint32_t Capacity>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "ring messages must be trivially copyable");
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+private:
+    static constexpr int SpinCount = 2000;                  ///< Polls before sleeping in popWait
+
+    alignas(64) std::atomic<std::uint32_t> head{0};         ///< Next slot to write (producer owned)
+    alignas(64) std::atomic<std::uint32_t> tail{0};         ///< Next slot to read (consumer owned)
+    alignas(64) std::atomic<std::uint32_t> consumerSleeping{0}; ///< Set while the consumer is in futexWait
+    alignas(64) T slots[Capacity];                          ///< Message storage
+
+public:
+    /**
+     * @brief Attempts to enqueue a message
+     * @param msg Message to copy into the ring
+     * @return false if the ring is full
+     */
+    bool tryPush(const T& msg) {
+        const std::uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[h & (Capacity - 1)] = msg;
+        head.store(h + 1, std::memory_order_seq_cst);
+        if (consumerSleeping.load(std::memory_order_seq_cst)) {
+            futexWake(&head);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Attempts to dequeue a message without blocking
+     * @param out Receives the message
+     * @return false if the ring is empty
+     */
+    bool tryPop(T& out) {
+        const std::uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        out = slots[t & (Capacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeues a message, sleeping on a futex when the ring stays empty
+     * @param out Receives the message
+     * @param timeoutNs Maximum time to sleep per wait, or 0 to wait forever
+     * @return false if the timeout elapsed with the ring still empty
+     */
+    bool popWait(T& out, long timeoutNs = 0) {
+        for (int i = 0; i < SpinCount; ++i) {
+            if (tryPop(out)) return true;
+        }
+
+        const std::uint32_t t = tail.load(std::memory_order_relaxed);
+        consumerSleeping.store(1, std::memory_order_seq_cst);
+        // Re-check after announcing the sleep so a concurrent push cannot be missed
+        if (head.load(std::memory_order_seq_cst) == t) {
+            futexWait(&head, t, timeoutNs);
+        }
+        consumerSleeping.store(0, std::memory_order_relaxed);
+        return tryPop(out);
+    }
+
+    /**
+     * @brief Gets the number of queued messages
+     * @return Approximate size when called concurrently with push/pop
+     */
+    std::uint32_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+};
@@ -0,0 +1,202 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include "../states/StateTypes.hpp"
+
+/**
+ * @brief A state was pushed on top of the stack
+ */
+struct StatePushed {
+    StateType state;        ///< State now on top
+    std::uint32_t depth;    ///< Stack size after the push
+};
+
+/**
+ * @brief The top state was popped
+ */
+struct StatePopped {
+    StateType state;        ///< State that was removed
+    std::uint32_t depth;    ///< Stack size after the pop
+};
+
+/**
+ * @brief The top state was replaced by another
+ */
+struct StateReplaced {
+    StateType from;         ///< State that was removed
+    StateType to;           ///< State now on top
+    std::uint32_t depth;    ///< Stack size (unchanged)
+};
+
+/**
+ * @brief The player's snake ate food
+ */
+struct FoodEaten {
+    std::uint64_t tick;     ///< Game tick of the step that ate it
+    int x;                  ///< Cell of the eaten food
+    int y;
+    int score;              ///< Player's score after eating
+};
+
+/**
+ * @brief The player's snake died and the game ends
+ */
+struct PlayerDied {
+    std::uint64_t tick;     ///< Game tick of the fatal step
+    int score;              ///< Final score
+};
+
+/**
+ * @brief GameController finished one simulation tick
+ */
+struct TickCompleted {
+    std::uint64_t tick;     ///< Ticks completed since the game started
+};
+
+/// Index of a subscription within its channel, for unsubscribe()
+using SubscriptionId = std::size_t;
+
+/**
+ * @brief Subscribers to one event type, called in subscription order
+ *
+ * Callbacks are stored inline: any trivially copyable callable of up to
+ * two pointers (a function, a captureless lambda, or a lambda capturing
+ * `this` or a reference) is copied into a fixed slot together with a
+ * plain function pointer that invokes it. Publishing is one indirect
+ * call per subscriber and never allocates, unlike std::function, and
+ * with no subscribers it costs a single compare.
+ *
+ * Not thread-safe: subscribe, unsubscribe and publish all run on the
+ * simulation thread (or before it starts). Consumers on other threads
+ * go through EventRecorder.
+ *
+ * @tparam Event Event struct delivered to the callbacks
+ */
+template <typename Event>
+class EventChannel {
+public:
+    static constexpr std::size_t MaxSubscribers = 8;            ///< Fixed slots per event type
+    static constexpr std::size_t InlineSize = 2 * sizeof(void*); ///< Largest callable stored
+
+private:
+    struct Subscriber {
+        void (*invoke)(const void* callback, const Event& event){nullptr}; ///< Null for a free slot
+        alignas(void*) unsigned char callback[InlineSize];                 ///< The callable itself
+    };
+
+    Subscriber subscribers[MaxSubscribers];  ///< Slots, used from the front
+    std::size_t count{0};                    ///< One past the last used slot
+
+public:
+    /**
+     * @brief Adds a callback
+     * @param callback Callable as `void(const Event&) const`
+     * @return Id for unsubscribe()
+     * @throws std::runtime_error if all MaxSubscribers slots are taken
+     */
+    template <typename Fn>
+    SubscriptionId subscribe(const Fn& callback) {
+        static_assert(std::is_trivially_copyable<Fn>::value && std::is_trivially_destructible<Fn>::value,
+                      "event callbacks must be trivially copyable (capture pointers, not objects)");
+        static_assert(sizeof(Fn) <= InlineSize && alignof(Fn) <= alignof(void*),
+                      "event callbacks must fit in two pointers");
+
+        SubscriptionId id = 0;
+        while (id < MaxSubscribers && subscribers[id].invoke) ++id;
+        if (id == MaxSubscribers) {
+            throw std::runtime_error("Too many subscribers for one event type");
+        }
+
+        Subscriber& slot = subscribers[id];
+        new (slot.callback) Fn(callback);
+        slot.invoke = [](const void* stored, const Event& event) {
+            (*static_cast<const Fn*>(stored))(event);
+        };
+        if (id >= count) count = id + 1;
+        return id;
+    }
+
+    /**
+     * @brief Removes a callback added by subscribe()
+     * @param id Value subscribe() returned
+     */
+    void unsubscribe(SubscriptionId id) {
+        subscribers[id].invoke = nullptr;
+        while (count > 0 && !subscribers[count - 1].invoke) --count;
+    }
+
+    /**
+     * @brief Calls every callback with the event
+     */
+    void publish(const Event& event) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (subscribers[i].invoke) {
+                subscribers[i].invoke(subscribers[i].callback, event);
+            }
+        }
+    }
+
+    /**
+     * @brief Checks for subscribers
+     * @return true if publish() would call nothing
+     */
+    bool empty() const { return count == 0; }
+};
+
+/**
+ * @brief Engine events, dispatched by type at compile time
+ *
+ * One EventChannel per event type, selected with std::get, so
+ * publish<FoodEaten>() compiles to a loop over the FoodEaten callbacks
+ * only, and publishing a type the bus does not carry is a compile
+ * error. The bus lives in the StateMachine; states reach it through
+ * their machine pointer. Telemetry, logging and recording subscribe
+ * here instead of being wired into processStateChanges() or
+ * PlayingState::update().
+ */
+class EventBus {
+private:
+    std::tuple<EventChannel<StatePushed>, EventChannel<StatePopped>, EventChannel<StateReplaced>,
+               EventChannel<FoodEaten>, EventChannel<PlayerDied>, EventChannel<TickCompleted>> channels;
+
+public:
+    /**
+     * @brief Gets the channel of one event type
+     */
+    template <typename Event>
+    EventChannel<Event>& channel() { return std::get<EventChannel<Event>>(channels); }
+
+    template <typename Event>
+    const EventChannel<Event>& channel() const { return std::get<EventChannel<Event>>(channels); }
+
+    /**
+     * @brief Subscribes a small callable, e.g. `[this](const FoodEaten& e) { ... }`
+     * @see EventChannel::subscribe
+     */
+    template <typename Event, typename Fn>
+    SubscriptionId subscribe(const Fn& callback) { return channel<Event>().subscribe(callback); }
+
+    /**
+     * @brief Subscribes a free function chosen at compile time
+     *
+     * The function is a template argument, so the stored callback is
+     * empty and the call inside it is direct.
+     */
+    template <typename Event, void (*Handler)(const Event&)>
+    SubscriptionId subscribe() {
+        return channel<Event>().subscribe([](const Event& event) { Handler(event); });
+    }
+
+    template <typename Event>
+    void unsubscribe(SubscriptionId id) { channel<Event>().unsubscribe(id); }
+
+    /**
+     * @brief Delivers an event to the subscribers of its type
+     */
+    template <typename Event>
+    void publish(const Event& event) const { channel<Event>().publish(event); }
+};
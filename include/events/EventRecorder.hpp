@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include "EventBus.hpp"
+#include "../metrics/Metrics.hpp"
+
+/**
+ * @brief Which member of an EventRecord is set
+ */
+enum class EventKind : std::uint8_t {
+    StatePushed,
+    StatePopped,
+    StateReplaced,
+    FoodEaten,
+    PlayerDied
+};
+
+/**
+ * @brief Any engine event except TickCompleted, as a tagged union
+ */
+struct EventRecord {
+    EventKind kind;
+    union {
+        StatePushed statePushed;
+        StatePopped statePopped;
+        StateReplaced stateReplaced;
+        FoodEaten foodEaten;
+        PlayerDied playerDied;
+    };
+};
+
+/**
+ * @brief The events of one simulation tick
+ */
+struct EventFrame {
+    static constexpr std::uint32_t MaxEvents = 16;   ///< A tick has at most a transition and a game event or two
+
+    std::uint64_t tick;                              ///< TickCompleted::tick that closed the frame
+    std::uint32_t count;                             ///< Events stored
+    std::uint32_t overflowed;                        ///< Events that did not fit
+    EventRecord events[MaxEvents];                   ///< Events in publish order
+};
+
+/**
+ * @brief Batches bus events per tick for a consumer on another thread
+ *
+ * Subscribes to every event type. Events are appended to the current
+ * frame on the simulation thread; TickCompleted closes the frame and,
+ * if anything happened, copies it into a wait-free ring (same head/tail
+ * scheme as InputQueue). Quiet ticks cost nothing beyond the
+ * TickCompleted call. When the consumer falls behind, whole frames are
+ * dropped and counted, and the simulation never waits.
+ *
+ * Exactly one thread may consume with tryPop().
+ */
+class EventRecorder {
+public:
+    static constexpr std::uint32_t Capacity = 64;    ///< Frames buffered (power of two)
+
+private:
+    alignas(64) std::atomic<std::uint32_t> head{0};  ///< Next slot to write (simulation thread)
+    alignas(64) std::atomic<std::uint32_t> tail{0};  ///< Next slot to read (consumer thread)
+    alignas(64) EventFrame slots[Capacity];          ///< Closed frames
+    EventFrame current{};                            ///< Frame being filled (simulation thread)
+    Counter& droppedFrames;                          ///< Frames lost to a full ring
+    EventBus& bus;                                   ///< Bus subscribed to
+    SubscriptionId subscriptions[6];                 ///< One per event type
+
+    void record(const EventRecord& event);
+    void closeFrame(std::uint64_t tick);
+
+public:
+    /**
+     * @brief Subscribes to every event type on a bus
+     * @param events Bus to record (must outlive the recorder)
+     * @throws std::runtime_error if a channel has no free subscriber slot
+     */
+    explicit EventRecorder(EventBus& events);
+
+    /**
+     * @brief Unsubscribes from the bus
+     * @note Call on the simulation thread, or once it has stopped
+     */
+    ~EventRecorder();
+
+    EventRecorder(const EventRecorder&) = delete;
+    EventRecorder& operator=(const EventRecorder&) = delete;
+
+    /**
+     * @brief Takes the oldest closed frame
+     * @param out Receives the frame
+     * @return false if no frame is waiting
+     */
+    bool tryPop(EventFrame& out);
+};
+
+/**
+ * @brief Writes one event as a single human-readable line (no newline)
+ */
+std::ostream& operator<<(std::ostream& out, const EventRecord& event);
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "../Snake.hpp"
+
+/**
+ * @brief One requested turn, stamped with when its source issued it
+ *
+ * Keyboard input, recorded games and agent controllers all steer the
+ * player through MoveCommands, so every source goes through the same
+ * one-per-tick application and latency accounting.
+ */
+struct MoveCommand {
+    Direction direction;                            ///< Requested direction
+    std::chrono::steady_clock::time_point issued;   ///< When the key was polled (or the agent decided)
+};
+
+/**
+ * @brief Small lock-free queue of MoveCommands consumed one per tick
+ *
+ * Holds the turns requested since the last tick instead of letting the
+ * newest overwrite the rest, so two quick turns within one tick are
+ * both played, on consecutive ticks. Same head/tail counter scheme as
+ * InputQueue: exactly one thread may push and exactly one may pop, and
+ * both finish in a bounded number of steps.
+ */
+class CommandQueue {
+public:
+    static constexpr std::uint32_t Capacity = 8;    ///< Slots (power of two); players rarely queue more than two turns
+
+private:
+    alignas(64) std::atomic<std::uint32_t> head{0};  ///< Next slot to write (producer owned)
+    alignas(64) std::atomic<std::uint32_t> tail{0};  ///< Next slot to read (consumer owned)
+    MoveCommand slots[Capacity];                     ///< Command storage
+
+public:
+    /**
+     * @brief Attempts to enqueue a command
+     * @return false if the queue is full (the command is dropped)
+     */
+    bool tryPush(const MoveCommand& command) {
+        const std::uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[h & (Capacity - 1)] = command;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Attempts to dequeue the oldest command
+     * @return false if the queue is empty
+     */
+    bool tryPop(MoveCommand& out) {
+        const std::uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        out = slots[t & (Capacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Takes the oldest command that would change a moving snake's direction
+     * @param current Direction the snake moved on its last tick
+     * @param out Receives the command
+     * @return false if no queued command turns the snake
+     *
+     * Commands that repeat the current direction or reverse it could
+     * never take effect, so they are discarded instead of costing a tick.
+     * Consumer side only.
+     */
+    bool popTurn(Direction current, MoveCommand& out) {
+        while (tryPop(out)) {
+            if (out.direction != current && out.direction != opposite(current)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Discards every queued command (consumer side only)
+     */
+    void clear() {
+        tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+/**
+ * @brief Read-only view of one obstacle level
+ *
+ * Points into a LevelPack (usually straight into the mapped file), so a
+ * Level is cheap to copy and stays valid as long as its pack. The
+ * default-constructed Level is the open board: no walls, the snake
+ * starts at the centre and food may appear on any cell.
+ *
+ * Walls use the Bitboard cell layout (cell y * width + x is bit
+ * cell % 64 of word cell / 64), so testing a cell is a single bit test.
+ * The free-cell list holds every non-wall cell in increasing order, so
+ * food can be drawn uniformly from it without ever sampling a wall.
+ */
+struct Level {
+    int width{0};                            ///< Board width in cells (0 for the open board)
+    int height{0};                           ///< Board height in cells
+    sf::Vector2i spawn;                      ///< Snake head at the start of a game (body trails left)
+    const std::uint64_t* walls{nullptr};     ///< Wall bits, null for the open board
+    const std::uint16_t* freeCells{nullptr}; ///< Non-wall cells in increasing order
+    std::uint32_t freeCount{0};              ///< Entries in freeCells
+
+    /**
+     * @brief Checks for the open board
+     */
+    bool isOpen() const { return walls == nullptr; }
+
+    /**
+     * @brief Checks whether a cell is a wall
+     * @param cell y * width + x of a cell on the board (not the open board)
+     */
+    bool isWall(int cell) const { return (walls[cell >> 6] >> (cell & 63)) & 1; }
+
+    /**
+     * @brief Gets the position of an entry of the free-cell list
+     */
+    sf::Vector2i freeCell(std::uint32_t index) const {
+        const int cell = freeCells[index];
+        return sf::Vector2i(cell % width, cell / width);
+    }
+};
@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Level.hpp"
+#include "../Bitboard.hpp"
+
+/**
+ * @brief First 64 bytes of a level pack file
+ *
+ * File layout (all integers in the writer's byte order, checked with
+ * byteOrder):
+ * - this header
+ * - levelCount LevelPackEntry records at indexOffset
+ * - per level, 8-byte aligned: wallWords 64-bit wall words, then
+ *   freeCount 16-bit free cells
+ * Every level of a pack has the same board size.
+ */
+struct LevelPackHeader {
+    char magic[8];              ///< "SNKLVLP1"
+    std::uint32_t version;      ///< LevelPack::Version
+    std::uint32_t byteOrder;    ///< LevelPack::ByteOrderTag as written
+    std::uint32_t levelCount;   ///< Levels in the pack
+    std::uint16_t width;        ///< Board width in cells
+    std::uint16_t height;       ///< Board height in cells
+    std::uint32_t wallWords;    ///< 64-bit words per wall bitboard
+    std::uint32_t reserved0;
+    std::uint64_t indexOffset;  ///< File offset of the entries
+    std::uint8_t reserved[24];
+};
+static_assert(sizeof(LevelPackHeader) == 64, "level pack header must stay 64 bytes");
+
+/**
+ * @brief Index record of one level
+ */
+struct LevelPackEntry {
+    std::uint64_t offset;       ///< File offset of the wall words (multiple of 8)
+    std::uint32_t freeCount;    ///< Non-wall cells
+    std::uint16_t spawnX;       ///< Snake head at the start of a game
+    std::uint16_t spawnY;
+};
+static_assert(sizeof(LevelPackEntry) == 16, "level pack entries must stay 16 bytes");
+
+/**
+ * @brief A level as built by a tool before it is written to a pack
+ */
+struct LevelSource {
+    Bitboard walls;             ///< Wall cells
+    sf::Vector2i spawn;         ///< Snake head at the start of a game
+};
+
+/**
+ * @brief Obstacle levels read from a binary level pack
+ *
+ * The file is memory-mapped read-only (read into memory on platforms
+ * without mmap) and the Levels returned point straight into it. Opening
+ * checks the header and the index but touches no level data, so a pack
+ * of thousands of levels opens in microseconds and pages are only read
+ * for the levels actually played. Levels keep pointing into the pack,
+ * so it must outlive every session using them. A pack is immutable and
+ * may be shared between threads.
+ */
+class LevelPack {
+public:
+    static constexpr std::uint32_t Version = 1;                 ///< Format version written and accepted
+    static constexpr std::uint32_t ByteOrderTag = 0x01020304;   ///< Reads back differently on the other endianness
+    static constexpr int MaxCells = 65536;                      ///< Free cells are stored as 16-bit indices
+
+private:
+    const std::uint8_t* bytes{nullptr};     ///< Start of the file contents
+    std::size_t size{0};                    ///< File size in bytes
+    bool mapped{false};                     ///< bytes comes from mmap (else from buffer)
+    std::vector<std::uint64_t> buffer;      ///< File contents where mmap is unavailable
+    const LevelPackHeader* header{nullptr}; ///< Validated header
+    const LevelPackEntry* entries{nullptr}; ///< Validated index
+    std::string path;                       ///< File path, for messages
+
+    void validate();
+
+public:
+    /**
+     * @brief Opens and maps a level pack
+     * @param packPath File written by write()
+     * @throws std::runtime_error if the file cannot be read or is not a valid pack
+     */
+    explicit LevelPack(const std::string& packPath);
+
+    /**
+     * @brief Unmaps the file
+     */
+    ~LevelPack();
+
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    std::uint32_t levelCount() const { return header->levelCount; }
+    int getWidth() const { return header->width; }
+    int getHeight() const { return header->height; }
+    const std::string& getPath() const { return path; }
+
+    /**
+     * @brief Gets one level
+     * @param index Level number, below levelCount()
+     */
+    Level level(std::uint32_t index) const;
+
+    /**
+     * @brief Gets the level a seed plays on
+     *
+     * Seed s plays level s % levelCount(), so a seed alone replays a game
+     */
+    Level levelForSeed(std::uint64_t seed) const {
+        return level(static_cast<std::uint32_t>(seed % header->levelCount));
+    }
+
+    /**
+     * @brief Writes levels to a pack file, computing the free-cell lists
+     * @param packPath Output file (replaced)
+     * @param levels Levels of one board size, at most MaxCells cells
+     * @throws std::runtime_error if the sizes differ, a spawn cell or the two
+     *         body cells to its left are walls, or the file cannot be written
+     */
+    static void write(const std::string& packPath, const std::vector<LevelSource>& levels);
+
+    /**
+     * @brief Parses a text level: '#' wall, 'S' snake head, anything else free
+     * @param text One line per row, all rows the same length
+     * @throws std::runtime_error if there is not exactly one 'S'
+     */
+    static LevelSource parse(const std::string& text);
+};
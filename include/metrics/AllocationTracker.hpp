@@ -0,0 +1,105 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+
+/**
+ * @brief Part of a frame that a heap allocation is attributed to
+ */
+enum class AllocPhase : std::uint8_t {
+    Other,      ///< Outside any AllocationScope
+    Input,      ///< Applying queued input to the current state
+    Update,     ///< Simulation tick
+    Snapshot,   ///< Describing the frame in a FrameSnapshot
+    Render,     ///< Drawing a snapshot on the window thread
+    Count       ///< Number of phases
+};
+
+/**
+ * @brief Gets a lowercase name for a phase (for logs and metric labels)
+ */
+const char* allocPhaseName(AllocPhase phase);
+
+/**
+ * @brief Opt-in global operator new counter
+ *
+ * Compiled in when SNAIKE_TRACK_ALLOCATIONS is defined (the default for
+ * Debug builds, see CMakeLists.txt). In that configuration the global
+ * operator new/delete are replaced by versions that count every
+ * allocation per thread and per AllocPhase before forwarding to malloc.
+ * Otherwise every query returns 0 and the scopes compile to nothing.
+ */
+class AllocationTracker {
+public:
+    /**
+     * @brief Checks whether allocations are being counted
+     */
+    static constexpr bool isEnabled() {
+#ifdef SNAIKE_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Gets the allocations made by the calling thread so far
+     */
+    static std::uint64_t threadAllocations();
+
+    /**
+     * @brief Gets the allocations attributed to a phase, over all threads
+     */
+    static std::uint64_t phaseAllocations(AllocPhase phase);
+
+    /**
+     * @brief Gets the calling thread's current phase
+     */
+    static AllocPhase currentPhase();
+
+    /**
+     * @brief Sets the calling thread's current phase
+     * @return The previous phase
+     */
+    static AllocPhase setPhase(AllocPhase phase);
+};
+
+/**
+ * @brief Attributes the calling thread's allocations to a phase for a scope
+ *
+ * Scopes nest; the previous phase is restored on destruction.
+ */
+class AllocationScope {
+private:
+    AllocPhase previous;       ///< Phase to restore
+    std::uint64_t start;       ///< Thread allocation count at construction
+
+public:
+    explicit AllocationScope(AllocPhase phase)
+        : previous(AllocationTracker::setPhase(phase))
+        , start(AllocationTracker::threadAllocations()) {}
+
+    ~AllocationScope() { AllocationTracker::setPhase(previous); }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    /**
+     * @brief Gets the allocations made by this thread since the scope began
+     */
+    std::uint64_t allocations() const { return AllocationTracker::threadAllocations() - start; }
+};
+
+#ifndef SNAIKE_TRACK_ALLOCATIONS
+inline std::uint64_t AllocationTracker::threadAllocations() { return 0; }
+inline std::uint64_t AllocationTracker::phaseAllocations(AllocPhase) { return 0; }
+inline AllocPhase AllocationTracker::currentPhase() { return AllocPhase::Other; }
+inline AllocPhase AllocationTracker::setPhase(AllocPhase) { return AllocPhase::Other; }
+#endif
+
+/**
+ * @brief Asserts (in debug builds) that a scope has not allocated
+ *
+ * Used to enforce that steady-state ticks and snapshots are allocation free.
+ */
+#define SNAIKE_ASSERT_NO_ALLOCATIONS(scope) \
+    assert((scope).allocations() == 0 && "steady-state code allocated on the heap")
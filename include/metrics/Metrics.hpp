@@ -0,0 +1,292 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Number of per-thread shards behind every counter and histogram
+ *
+ * Each recording thread is assigned a shard once, so threads on
+ * different shards never contend on the same cache line.
+ */
+constexpr unsigned MetricShards = 8;
+
+/**
+ * @brief Gets the calling thread's shard index
+ * @return Index in [0, MetricShards), fixed for the thread's lifetime
+ */
+unsigned metricShard();
+
+/**
+ * @brief Index of the highest set bit
+ * @param value Non-zero value
+ */
+inline int highestBit(std::uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+/**
+ * @brief Monotonic counter sharded per thread
+ *
+ * add() is one relaxed fetch_add on a cache line owned by the calling
+ * thread's shard; value() sums the shards and is only needed at export.
+ */
+class Counter {
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+    Shard shards[MetricShards];  ///< One padded slot per thread shard
+
+public:
+    /**
+     * @brief Adds to the counter
+     * @param n Amount to add
+     */
+    void add(std::uint64_t n = 1) {
+        shards[metricShard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the total over all shards
+     */
+    std::uint64_t value() const;
+};
+
+/**
+ * @brief Last-written value (rates, sizes, configuration)
+ */
+class Gauge {
+private:
+    std::atomic<double> current{0.0};  ///< Value as last set
+
+public:
+    /**
+     * @brief Sets the gauge
+     */
+    void set(double value) { current.store(value, std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the gauge
+     */
+    double value() const { return current.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Log-linear (HDR-style) histogram of unsigned integer samples
+ *
+ * Values below 16 get exact buckets; above that each power of two is
+ * split into 16 linear sub-buckets, so every bucket is within 6.25% of
+ * the values it holds across the whole uint64 range. Recording is a
+ * bit scan plus two relaxed fetch_adds on the calling thread's shard.
+ */
+class Histogram {
+public:
+    static constexpr int SubBucketBits = 4;                          ///< log2 of sub-buckets per power of two
+    static constexpr int SubBuckets = 1 << SubBucketBits;            ///< Linear sub-buckets per power of two
+    static constexpr int BucketCount = (64 - SubBucketBits + 1) * SubBuckets; ///< Buckets covering all of uint64
+
+    /**
+     * @brief Gets the bucket holding a value
+     */
+    static int bucketIndex(std::uint64_t value) {
+        if (value < static_cast<std::uint64_t>(SubBuckets)) {
+            return static_cast<int>(value);
+        }
+        const int exponent = highestBit(value);
+        const int shift = exponent - SubBucketBits;
+        const int mantissa = static_cast<int>((value >> shift) & (SubBuckets - 1));
+        return (shift + 1) * SubBuckets + mantissa;
+    }
+
+    /**
+     * @brief Gets the smallest value stored in a bucket
+     */
+    static std::uint64_t bucketLowerBound(int index);
+
+    /**
+     * @brief Gets the largest value stored in a bucket
+     */
+    static std::uint64_t bucketUpperBound(int index);
+
+    /**
+     * @brief Point-in-time copy of a histogram, merged over shards
+     */
+    struct Snapshot {
+        std::uint64_t counts[BucketCount]{};  ///< Samples per bucket
+        std::uint64_t count{0};               ///< Total samples
+        std::uint64_t sum{0};                 ///< Sum of all samples
+
+        /**
+         * @brief Estimates a quantile
+         * @param q Quantile in [0, 1]
+         * @return Upper bound of the bucket holding the quantile, or 0 when empty
+         */
+        std::uint64_t quantile(double q) const;
+    };
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> sum{0};
+        std::atomic<std::uint64_t> counts[BucketCount];
+        Shard();
+    };
+    std::unique_ptr<Shard[]> shards;  ///< One slot per thread shard (heap: ~8 KiB each)
+
+public:
+    Histogram();
+
+    /**
+     * @brief Records one sample
+     * @param value Sample, in the unit named by the metric
+     */
+    void record(std::uint64_t value) {
+        Shard& shard = shards[metricShard()];
+        shard.counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Merges all shards into a snapshot
+     */
+    void snapshot(Snapshot& out) const;
+};
+
+/**
+ * @brief Records the lifetime of a scope into a histogram
+ *
+ * The unit is microseconds or nanoseconds depending on Duration.
+ */
+template <typename Duration = std::chrono::nanoseconds>
+class ScopedTimer {
+private:
+    Histogram& histogram;                                 ///< Destination
+    std::chrono::steady_clock::time_point start;          ///< Construction time
+
+public:
+    explicit ScopedTimer(Histogram& target)
+        : histogram(target), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        const auto elapsed = std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - start);
+        histogram.record(static_cast<std::uint64_t>(elapsed.count()));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+/**
+ * @brief Process-wide set of named metrics
+ *
+ * Metrics are created on first lookup and live until exit, so callers
+ * cache the returned reference (typically in a function-local static)
+ * and record without touching the registry again. Names follow
+ * Prometheus conventions and may carry a label set, for example
+ * "snaike_state_transitions_total{op=\"push\"}".
+ */
+class MetricsRegistry {
+private:
+    struct Entry {
+        std::string help;                     ///< Description for exports
+        std::unique_ptr<Counter> counter;     ///< Set for counters
+        std::unique_ptr<Gauge> gauge;         ///< Set for gauges
+        std::unique_ptr<Histogram> histogram; ///< Set for histograms
+    };
+
+    mutable std::mutex mutex;                 ///< Guards the map (lookups only, not recording)
+    std::map<std::string, Entry> entries;     ///< Metrics by full name
+
+    Entry& entry(const std::string& name, const std::string& help);
+
+public:
+    /**
+     * @brief Gets the process-wide registry
+     */
+    static MetricsRegistry& instance();
+
+    /**
+     * @brief Gets or creates a counter
+     * @throws std::runtime_error if name is registered as another kind
+     */
+    Counter& counter(const std::string& name, const std::string& help = "");
+
+    /**
+     * @brief Gets or creates a gauge
+     * @throws std::runtime_error if name is registered as another kind
+     */
+    Gauge& gauge(const std::string& name, const std::string& help = "");
+
+    /**
+     * @brief Gets or creates a histogram
+     * @throws std::runtime_error if name is registered as another kind
+     */
+    Histogram& histogram(const std::string& name, const std::string& help = "");
+
+    /**
+     * @brief Writes all metrics in the Prometheus text exposition format
+     *
+     * Histograms are coarsened to one cumulative bucket per power of two;
+     * every histogram always has the same bounds, empty or not
+     */
+    void writePrometheus(std::ostream& out) const;
+
+    /**
+     * @brief Writes all metrics as one JSON object
+     *
+     * Histograms are summarised as count, sum, mean and p50/p90/p99/p999/max.
+     */
+    void writeJson(std::ostream& out) const;
+};
+
+/**
+ * @brief Background thread that periodically dumps the registry to disk
+ *
+ * Writes <basePath>.prom and <basePath>.json every interval, and once more
+ * on destruction. Each file is written to a temporary name and renamed
+ * into place, so readers never see a partial export.
+ */
+class MetricsExporter {
+private:
+    std::string basePath;                 ///< Output path without extension
+    std::chrono::milliseconds interval;   ///< Time between exports
+    std::mutex mutex;                     ///< Guards stopping
+    std::condition_variable wake;         ///< Signalled on stop
+    bool stopping{false};                 ///< Set by the destructor
+    std::thread worker;                   ///< Export loop
+
+    void exportNow() const;
+
+public:
+    /**
+     * @brief Starts exporting
+     * @param path Output path without extension
+     * @param period Time between exports
+     */
+    explicit MetricsExporter(const std::string& path,
+                             std::chrono::milliseconds period = std::chrono::seconds(5));
+
+    /**
+     * @brief Stops the thread after a final export
+     */
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include "../metrics/Metrics.hpp"
+
+/**
+ * @brief How a FramePacer waits for a deadline, trading CPU for precision
+ */
+enum class PacingMode {
+    Sleep,      ///< Sleep until the deadline; no spinning, wakes as late as the OS timer allows
+    Yield,      ///< Sleep until shortly before the deadline, then yield the core until it passes
+    Spin        ///< Sleep until shortly before the deadline, then busy-wait on the clock
+};
+
+/**
+ * @brief Parses a pacing mode name ("sleep", "yield" or "spin")
+ * @throws std::runtime_error for any other name
+ */
+PacingMode parsePacingMode(const std::string& name);
+
+/**
+ * @brief Waits for frame and tick deadlines on std::chrono::steady_clock
+ *
+ * OS sleeps overshoot by anything from tens of microseconds to a full
+ * timer quantum, which is visible as uneven motion at 10 ticks per
+ * second. In Yield and Spin mode the pacer only sleeps until a margin
+ * before the deadline and waits out the rest on the clock. The margin
+ * tracks the recent worst oversleep (decaying by 1/16 per sleep), so it
+ * stays small on systems with fine timers and grows where sleeps are
+ * coarse, up to MaxMargin.
+ *
+ * Callers report how late each scheduled event actually ran through
+ * record(), which feeds a jitter histogram in the metrics registry.
+ *
+ * Not thread-safe: one pacer per waiting thread.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Clock::duration MinMargin = std::chrono::microseconds(200);   ///< Smallest spin window
+    static constexpr Clock::duration MaxMargin = std::chrono::milliseconds(4);     ///< Largest spin window (a quarter frame)
+
+private:
+    PacingMode mode;                ///< How waits end
+    Histogram& jitter;              ///< Lateness of scheduled events, microseconds
+    Clock::duration margin;         ///< How long before a deadline sleeping stops
+    Clock::duration oversleep;      ///< Decaying peak of observed sleep overshoot
+
+public:
+    /**
+     * @brief Creates a pacer
+     * @param pacingMode How to wait
+     * @param jitterHistogram Histogram that record() feeds
+     */
+    FramePacer(PacingMode pacingMode, Histogram& jitterHistogram);
+
+    /**
+     * @brief Waits until a deadline
+     * @return When the wait ended (never before the deadline)
+     */
+    Clock::time_point waitUntil(Clock::time_point deadline);
+
+    /**
+     * @brief Records how late a scheduled event ran
+     * @param lateness Time between the event's deadline and when it ran
+     */
+    void record(Clock::duration lateness);
+
+    /**
+     * @brief Describes the jitter recorded so far, e.g. "p50 40us  p99 310us  max 1.1ms (600 samples)"
+     * @return Description, or an empty string if nothing was recorded
+     */
+    std::string summary() const;
+
+    PacingMode getMode() const { return mode; }
+
+    /**
+     * @brief Gets how long before a deadline the pacer stops sleeping (zero in Sleep mode)
+     */
+    Clock::duration getMargin() const { return mode == PacingMode::Sleep ? Clock::duration::zero() : margin; }
+};
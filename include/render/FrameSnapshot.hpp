@@ -0,0 +1,87 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "../MonotonicArena.hpp"
+
+/**
+ * @brief How a snapshot text is placed relative to its position
+ */
+enum class TextAnchor : std::uint8_t {
+    TopLeft,       ///< Position is the top-left corner
+    TopCenter,     ///< Position is the middle of the top edge
+    Center         ///< Position is the middle of the text box
+};
+
+/**
+ * @brief One filled board cell
+ */
+struct SnapshotCell {
+    std::int16_t x;   ///< Column in board cells
+    std::int16_t y;   ///< Row in board cells
+    sf::Color color;  ///< Fill colour
+};
+
+/**
+ * @brief One line of overlay text
+ */
+struct SnapshotText {
+    std::string_view text;   ///< UTF-8 string to draw (owned by the snapshot's text arena)
+    unsigned size;           ///< Character size in pixels
+    sf::Color color;         ///< Fill colour
+    sf::Vector2f position;   ///< Window position in pixels (see anchor)
+    TextAnchor anchor;       ///< Which point of the text sits at position
+};
+
+/**
+ * @brief Immutable description of one frame, produced by the simulation
+ *
+ * States fill a snapshot instead of drawing to the window, so the
+ * simulation thread never touches SFML graphics objects:
+ * - Board cells are in cell units; the renderer scales the board
+ *   (boardWidth x boardHeight) to fit the window
+ * - Texts are in window pixels and laid out by the renderer, which
+ *   owns the font
+ *
+ * Buffers are reused between frames so a steady-state frame does not
+ * allocate: clear() keeps the vectors' capacity, reserves room for a
+ * full board, and resets the arena that holds the text characters.
+ */
+struct FrameSnapshot {
+    std::uint64_t sequence{0};         ///< Publish counter, increases by one per snapshot
+    int boardWidth{0};                 ///< Board width in cells
+    int boardHeight{0};                ///< Board height in cells
+    std::vector<SnapshotCell> cells;   ///< Filled cells, drawn in order
+    std::vector<SnapshotText> texts;   ///< Overlay texts, drawn after the cells
+    MonotonicArena textArena{1024};    ///< Characters of this frame's texts
+
+    /**
+     * @brief Empties the snapshot for a new frame
+     * @param width Board width in cells
+     * @param height Board height in cells
+     */
+    void clear(int width, int height) {
+        boardWidth = width;
+        boardHeight = height;
+        cells.clear();
+        cells.reserve(static_cast<std::size_t>(width) * height);
+        texts.clear();
+        textArena.reset();
+    }
+
+    /**
+     * @brief Appends a filled cell
+     */
+    void addCell(int x, int y, sf::Color color) {
+        cells.push_back({static_cast<std::int16_t>(x), static_cast<std::int16_t>(y), color});
+    }
+
+    /**
+     * @brief Appends an overlay text
+     */
+    void addText(std::string_view text, unsigned size, sf::Color color,
+                 sf::Vector2f position, TextAnchor anchor = TextAnchor::TopLeft) {
+        texts.push_back({textArena.copy(text), size, color, position, anchor});
+    }
+};
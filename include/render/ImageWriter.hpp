@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Encodes an RGBA framebuffer as a binary PPM (P6, alpha dropped)
+ * @param pixels width * height RGBA pixels, row-major
+ * @param out Receives the file contents (capacity is reused)
+ */
+void encodePpm(const std::uint32_t* pixels, int width, int height, std::vector<std::uint8_t>& out);
+
+/**
+ * @brief Encodes an RGBA framebuffer as an 8-bit RGB PNG
+ * @param pixels width * height RGBA pixels, row-major
+ * @param out Receives the file contents (capacity is reused)
+ *
+ * Self-contained deflate with the fixed Huffman code and two match
+ * candidates per byte, the previous pixel and the pixel above. That
+ * suits game frames (flat colours, repeated rows) well and needs no zlib.
+ */
+void encodePng(const std::uint32_t* pixels, int width, int height, std::vector<std::uint8_t>& out);
+
+/**
+ * @brief Writes bytes to a file, replacing it
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeFile(const std::string& path, const std::vector<std::uint8_t>& bytes);
+
+/**
+ * @brief Raw video frames piped into an encoder process's stdin
+ *
+ * Starts the command through the shell (popen), so any local encoder
+ * works, e.g.
+ * `ffmpeg -f rawvideo -pix_fmt rgba -s 800x600 -r 10 -i - out.mp4`.
+ */
+class EncoderPipe {
+private:
+    std::FILE* pipe;   ///< Encoder stdin
+
+public:
+    /**
+     * @brief Starts the encoder
+     * @param command Shell command reading raw frames from stdin
+     * @throws std::runtime_error if the command cannot be started
+     */
+    explicit EncoderPipe(const std::string& command);
+
+    /**
+     * @brief Closes the pipe and waits for the encoder if close() was not called
+     */
+    ~EncoderPipe();
+
+    EncoderPipe(const EncoderPipe&) = delete;
+    EncoderPipe& operator=(const EncoderPipe&) = delete;
+
+    /**
+     * @brief Sends one frame of RGBA pixels
+     * @throws std::runtime_error if the encoder stopped reading
+     */
+    void write(const std::uint32_t* pixels, int width, int height);
+
+    /**
+     * @brief Closes the pipe and waits for the encoder
+     * @return Encoder exit status
+     */
+    int close();
+};
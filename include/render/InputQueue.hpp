@@ -0,0 +1,65 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Window event with the time the window thread polled it
+ */
+struct InputEvent {
+    sf::Event event;                              ///< Event as reported by SFML
+    std::chrono::steady_clock::time_point time;   ///< When it was polled
+};
+
+/**
+ * @brief Wait-free queue carrying window events to the simulation thread
+ *
+ * Same head/tail counter scheme as SpscRing, minus the futex parking:
+ * the simulation thread polls once per loop iteration, so it never needs
+ * to sleep on the queue, and this builds on every platform SFML does.
+ *
+ * Exactly one thread may push (the window thread) and exactly one may
+ * pop (the simulation thread). Both operations finish in a bounded
+ * number of steps.
+ */
+class InputQueue {
+public:
+    static constexpr std::uint32_t Capacity = 256;   ///< Slots (power of two)
+
+private:
+    alignas(64) std::atomic<std::uint32_t> head{0};  ///< Next slot to write (producer owned)
+    alignas(64) std::atomic<std::uint32_t> tail{0};  ///< Next slot to read (consumer owned)
+    alignas(64) InputEvent slots[Capacity];          ///< Event storage
+
+public:
+    /**
+     * @brief Attempts to enqueue an event
+     * @param event Event to copy into the queue
+     * @return false if the queue is full (the event is dropped)
+     */
+    bool tryPush(const InputEvent& event) {
+        const std::uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[h & (Capacity - 1)] = event;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Attempts to dequeue an event
+     * @param out Receives the event
+     * @return false if the queue is empty
+     */
+    bool tryPop(InputEvent& out) {
+        const std::uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        out = slots[t & (Capacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+};
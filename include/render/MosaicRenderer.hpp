@@ -0,0 +1,64 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "MosaicSnapshot.hpp"
+#include "SnapshotRenderer.hpp"
+
+/**
+ * @brief Draws MosaicSnapshots on the window thread in a handful of draw calls
+ *
+ * All tiles go into one vertex array, two triangles per board
+ * background and per cell, which is streamed into a single
+ * sf::VertexBuffer and drawn with one call; only the overlay texts
+ * are drawn separately. Drawing 256 boards therefore costs about as
+ * much as drawing one, instead of one draw call per cell.
+ *
+ * Tiles are laid out in the grid that gives the largest square cells
+ * for the window size and tile count. Vertices are only rebuilt when a
+ * new snapshot arrives or the window is resized; otherwise the
+ * uploaded buffer is drawn again as it is. Without GPU vertex buffers
+ * the same vertex array is drawn from memory, still in one call.
+ */
+class MosaicRenderer {
+public:
+    static constexpr float TileGap = 4.0f;   ///< Pixels between tiles and around the mosaic
+
+private:
+    SnapshotRenderer textRenderer;           ///< Lays out and draws the overlay texts
+    std::vector<sf::Vertex> vertices;        ///< Triangles of the last built snapshot
+    std::size_t vertexCount{0};              ///< Vertices in use
+    sf::VertexBuffer buffer;                 ///< GPU copy of vertices
+    bool useBuffer;                          ///< Whether vertex buffers are available
+    std::uint64_t builtSequence{0};          ///< Snapshot the vertices were built from
+    sf::Vector2u builtSize;                  ///< Window size the vertices were built for
+
+    /**
+     * @brief Lays out the tiles and fills vertices from a snapshot
+     */
+    void build(const MosaicSnapshot& mosaic, sf::Vector2u size);
+
+    /**
+     * @brief Appends two triangles covering a rectangle
+     */
+    void addQuad(float left, float top, float width, float height, sf::Color color);
+
+public:
+    /**
+     * @brief Constructs the renderer (needs an active window for the vertex buffer check)
+     * @param textFont Font for overlay texts
+     */
+    explicit MosaicRenderer(const sf::Font& textFont);
+
+    /**
+     * @brief Draws a mosaic (no clear/display)
+     * @param window Window to draw to
+     * @param mosaic Snapshot to draw
+     */
+    void draw(sf::RenderWindow& window, const MosaicSnapshot& mosaic);
+
+    /**
+     * @brief Gets the number of vertices drawn for the last snapshot
+     */
+    std::size_t getVertexCount() const { return vertexCount; }
+};
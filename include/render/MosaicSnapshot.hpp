@@ -0,0 +1,51 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "FrameSnapshot.hpp"
+
+/**
+ * @brief One board of a mosaic: a run of MosaicSnapshot cells and a background
+ */
+struct MosaicTile {
+    std::uint32_t cellEnd;    ///< One past the tile's last cell in MosaicSnapshot::frame.cells
+    sf::Color background;     ///< Board colour behind the cells
+};
+
+/**
+ * @brief Description of many boards at once, produced by the mosaic's simulation thread
+ *
+ * Every tile's cells are described into the one FrameSnapshot, back to
+ * back and in board coordinates (frame.boardWidth x frame.boardHeight),
+ * so PlayingState::describeSession() fills tiles exactly like the game
+ * fills the window. tiles[i] ends where tiles[i + 1] begins. The frame's
+ * texts are window overlays, placed within the HeaderHeight strip the
+ * renderer leaves above the tiles.
+ *
+ * Like FrameSnapshot, clear() keeps every buffer's capacity, so once
+ * the mosaic has grown a steady-state snapshot does not allocate.
+ */
+struct MosaicSnapshot {
+    static constexpr float HeaderHeight = 28.0f;   ///< Window pixels above the tiles for overlay texts
+
+    FrameSnapshot frame;              ///< Cells of all tiles, then overlay texts
+    std::vector<MosaicTile> tiles;    ///< Tiles in display order (row-major)
+
+    /**
+     * @brief Empties the snapshot for a new frame
+     * @param width Board width of every tile, in cells
+     * @param height Board height of every tile, in cells
+     */
+    void clear(int width, int height) {
+        frame.clear(width, height);
+        tiles.clear();
+    }
+
+    /**
+     * @brief Closes the current tile: cells added since the previous tile belong to it
+     * @param background Board colour of the tile
+     */
+    void endTile(sf::Color background) {
+        tiles.push_back({static_cast<std::uint32_t>(frame.cells.size()), background});
+    }
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "FrameSnapshot.hpp"
+
+/**
+ * @brief Draws FrameSnapshots on the window thread
+ * 
+ * The only code that turns snapshots into SFML draw calls:
+ * - Scales the snapshot's board to fit the window, keeping cells square
+ * - Lays out texts with the global font (glyph loading stays on this thread)
+ * - Keeps one laid-out sf::Text per text slot and only rebuilds it when the
+ *   string, size or colour changes, so static texts cost no allocation
+ */
+class SnapshotRenderer {
+private:
+    const sf::Font& font;             ///< Font used for all snapshot texts
+    /**
+     * @brief Laid-out text for one slot of FrameSnapshot::texts
+     */
+    struct CachedText {
+        std::string text;             ///< String the drawable was built from
+        unsigned size{0};             ///< Character size it was built with
+        sf::Color color;              ///< Colour it was built with
+        sf::Text drawable;            ///< Laid-out text
+        sf::FloatRect bounds;         ///< Local bounds of drawable
+    };
+
+    sf::RectangleShape cellShape;     ///< Reused shape for board cells
+    std::vector<CachedText> textCache; ///< One entry per text slot seen so far
+
+public:
+    /**
+     * @brief Constructs the renderer
+     * @param textFont Font for snapshot texts
+     */
+    explicit SnapshotRenderer(const sf::Font& textFont);
+
+    /**
+     * @brief Draws a snapshot (no clear/display)
+     * @param window Window to draw to
+     * @param frame Snapshot to draw
+     */
+    void draw(sf::RenderWindow& window, const FrameSnapshot& frame);
+
+    /**
+     * @brief Draws only a snapshot's texts, for views that draw the cells themselves
+     * @param window Window to draw to
+     * @param frame Snapshot whose texts to draw
+     */
+    void drawTexts(sf::RenderWindow& window, const FrameSnapshot& frame);
+};
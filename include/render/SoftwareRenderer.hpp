@@ -0,0 +1,78 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "FrameSnapshot.hpp"
+#include "TrueTypeFont.hpp"
+
+/**
+ * @brief Draws FrameSnapshots into a CPU framebuffer
+ *
+ * The headless counterpart of SnapshotRenderer for machines without a
+ * GPU or display: same board scaling, cell insets, text anchors and
+ * glyph placement as sf::Text, but every pixel is written on the CPU:
+ * - Cells are solid rectangles, filled row by row with 128-bit stores
+ *   (SSE2 on x86-64, a plain loop elsewhere)
+ * - Texts are alpha-blended coverage bitmaps from a TrueTypeFont, cached
+ *   per character and size so static texts are rasterized once
+ *
+ * Pixels are RGBA with 8 bits per channel, row-major without padding,
+ * which is what encoders expect as "rgba" raw video.
+ */
+class SoftwareRenderer {
+private:
+    /**
+     * @brief Rasterized glyph of one character at one size
+     */
+    struct CachedGlyph {
+        int index;            ///< Glyph index in the font (for kerning)
+        GlyphBitmap bitmap;   ///< Coverage and metrics
+    };
+
+    const TrueTypeFont& font;                              ///< Font for snapshot texts
+    int width;                                             ///< Framebuffer width in pixels
+    int height;                                            ///< Framebuffer height in pixels
+    std::vector<std::uint32_t> pixels;                     ///< RGBA pixels, row-major
+    std::unordered_map<std::uint64_t, CachedGlyph> glyphs; ///< Glyphs by (size, code point)
+
+    /**
+     * @brief Gets a cached glyph, rasterizing it on first use
+     */
+    const CachedGlyph& glyph(char32_t codepoint, unsigned size);
+
+    /**
+     * @brief Fills the pixels whose centres lie inside a rectangle
+     */
+    void fillRect(float left, float top, float right, float bottom, std::uint32_t color);
+
+    /**
+     * @brief Lays out and blends one text like sf::Text at the given anchor
+     */
+    void drawText(const SnapshotText& text);
+
+public:
+    /**
+     * @brief Creates a renderer with a black framebuffer
+     * @param textFont Font for snapshot texts
+     * @param frameWidth Framebuffer width in pixels
+     * @param frameHeight Framebuffer height in pixels
+     */
+    SoftwareRenderer(const TrueTypeFont& textFont, int frameWidth, int frameHeight);
+
+    /**
+     * @brief Clears the framebuffer and draws a snapshot
+     * @param frame Snapshot to draw
+     * @param background Clear colour, black like the game window
+     */
+    void draw(const FrameSnapshot& frame, sf::Color background = sf::Color::Black);
+
+    /**
+     * @brief Packs a colour into the framebuffer's pixel format
+     */
+    static std::uint32_t packColor(sf::Color color);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const std::uint32_t* data() const { return pixels.data(); }
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Fixed-rate tick schedule of a simulation loop, with a measured tick rate
+ *
+ * Shared by the loops that run ticks at a (possibly turbo) period and
+ * wait for them through a FramePacer. Ticks follow a fixed schedule
+ * rather than "period after the last one", so waking late does not
+ * drift the rate; but after a stall the schedule restarts from now
+ * instead of bursting the missed ticks. The ticks actually run are
+ * counted over one-second windows for a ticks/s readout.
+ *
+ * Not thread-safe: owned by the simulation thread.
+ */
+class TickSchedule {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    Clock::time_point nextTick;     ///< When the next tick is due
+    Clock::time_point windowStart;  ///< Start of the current rate window
+    std::uint64_t ticksInWindow{0}; ///< Ticks run in the current rate window
+    double measuredRate{0};         ///< Ticks per second over the last full window
+
+public:
+    /**
+     * @brief Starts a schedule whose first tick is due right away
+     */
+    explicit TickSchedule(Clock::time_point start = Clock::now());
+
+    /**
+     * @brief Counts a tick run at now and schedules the next one
+     * @param now When the tick ran
+     * @param period Time between ticks, zero to run them back to back
+     * @param slack How far the schedule may fall behind now before it restarts from now
+     * @return true if a rate window closed and rate() changed
+     */
+    bool ticked(Clock::time_point now, Clock::duration period, Clock::duration slack = Clock::duration::zero());
+
+    bool due(Clock::time_point now) const { return now >= nextTick; }
+    Clock::time_point next() const { return nextTick; }
+    double rate() const { return measuredRate; }
+};
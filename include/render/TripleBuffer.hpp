@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free triple buffer for handing the latest value between two threads
+ *
+ * Three slots rotate between a writer, a reader and a shared "middle":
+ * - The writer fills its back slot, then swaps it with the middle
+ * - The reader swaps the middle into its front slot only when the
+ *   writer has published something newer
+ *
+ * Neither side ever waits. The reader always sees the most recent
+ * complete value; intermediate values it was too slow to pick up are
+ * overwritten. Exactly one thread may write and exactly one may read.
+ *
+ * @tparam T Slot type (slots are reused, never reallocated)
+ */
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr std::uint8_t IndexMask = 0x3;  ///< Slot index bits of middle
+    static constexpr std::uint8_t FreshBit = 0x4;   ///< Set when middle holds an unread value
+
+    T slots[3];                              ///< Storage
+    std::uint8_t back{0};                    ///< Writer's slot (writer owned)
+    std::uint8_t front{1};                   ///< Reader's slot (reader owned)
+    alignas(64) std::atomic<std::uint8_t> middle{2}; ///< Shared slot index | FreshBit
+
+public:
+    /**
+     * @brief Gets the slot the writer may fill
+     * @return Back slot; holds whatever was written there three publishes ago
+     */
+    T& writeBuffer() { return slots[back]; }
+
+    /**
+     * @brief Makes the back slot visible to the reader
+     */
+    void publish() {
+        back = middle.exchange(back | FreshBit, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    /**
+     * @brief Picks up the newest published value, if any
+     * @return true if readBuffer() changed since the last call
+     */
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FreshBit)) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Gets the reader's current value
+     * @return Front slot, stable until the next update()
+     */
+    const T& readBuffer() const { return slots[front]; }
+};
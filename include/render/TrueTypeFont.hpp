@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Coverage bitmap of one glyph at one pixel size
+ */
+struct GlyphBitmap {
+    int width{0};                        ///< Bitmap width in pixels
+    int height{0};                       ///< Bitmap height in pixels
+    int left{0};                         ///< Offset from the pen position to the left edge
+    int top{0};                          ///< Offset from the baseline to the top edge (negative is above)
+    int advance{0};                      ///< Pen advance in whole pixels
+    std::vector<std::uint8_t> coverage;  ///< width * height coverage values, 255 = fully inside
+};
+
+/**
+ * @brief Minimal TrueType reader and rasterizer for headless text
+ *
+ * Reads the outline tables of a .ttf file (cmap formats 4 and 12, hmtx,
+ * loca/glyf with simple and compound glyphs, kern format 0) and turns
+ * glyphs into anti-aliased coverage bitmaps with a signed-area scanline
+ * rasterizer. Sizes follow SFML's character size (pixels per em), so
+ * text lays out like sf::Text does with the same font; only FreeType's
+ * hinting is missing, which moves edges by a fraction of a pixel.
+ *
+ * Needs neither FreeType nor a graphics context, so it works on machines
+ * where sf::Font cannot create glyph textures.
+ */
+class TrueTypeFont {
+private:
+    std::vector<std::uint8_t> data;   ///< Whole font file
+    std::uint32_t glyf{0};            ///< Offset of the glyf table
+    std::uint32_t loca{0};            ///< Offset of the loca table
+    std::uint32_t hmtx{0};            ///< Offset of the hmtx table
+    std::uint32_t kern{0};            ///< Offset of the first kern subtable (0 if none)
+    std::uint32_t cmap{0};            ///< Offset of the chosen cmap subtable
+    int unitsPerEm{0};                ///< Font units per em
+    int numGlyphs{0};                 ///< Glyphs in the font
+    int numHMetrics{0};               ///< Entries in hmtx with their own advance
+    bool longOffsets{false};          ///< loca holds 32-bit offsets
+
+    /**
+     * @brief Outline point in font units
+     */
+    struct OutlinePoint {
+        float x;
+        float y;
+        bool onCurve;
+    };
+
+    std::uint16_t u16(std::uint32_t offset) const;
+    std::int16_t i16(std::uint32_t offset) const { return static_cast<std::int16_t>(u16(offset)); }
+    std::uint32_t u32(std::uint32_t offset) const;
+
+    /**
+     * @brief Gets the byte range of a glyph in the glyf table
+     * @return false for glyphs without an outline (such as space)
+     */
+    bool glyphRange(int glyph, std::uint32_t& begin, std::uint32_t& end) const;
+
+    /**
+     * @brief Appends a glyph's contours, transformed by the 2x3 matrix m
+     * @param contourEnds Receives the index one past the last point of each contour
+     */
+    void appendOutline(int glyph, const float m[6], int depth,
+                       std::vector<OutlinePoint>& points, std::vector<std::size_t>& contourEnds) const;
+
+public:
+    /**
+     * @brief Loads a font file
+     * @param path Path to a .ttf file
+     * @throws std::runtime_error if the file cannot be read or is not a TrueType font
+     */
+    explicit TrueTypeFont(const std::string& path);
+
+    /**
+     * @brief Maps a Unicode code point to a glyph index (0 = missing glyph)
+     */
+    int glyphIndex(char32_t codepoint) const;
+
+    /**
+     * @brief Gets the kerning between two glyphs
+     * @return Adjustment in whole pixels at the given size
+     */
+    int kerning(int left, int right, unsigned size) const;
+
+    /**
+     * @brief Rasterizes a glyph
+     * @param glyph Glyph index
+     * @param size Character size in pixels per em
+     * @param bitmap Receives the coverage bitmap and metrics
+     */
+    void rasterize(int glyph, unsigned size, GlyphBitmap& bitmap) const;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One key press of a recorded session
+ */
+struct SessionEvent {
+    std::uint64_t tick;         ///< GameController ticks completed before the key was handled
+    sf::Keyboard::Key key;      ///< Key pressed
+};
+
+/**
+ * @brief Key presses of a whole game session, replayable through GameController
+ *
+ * Games take their seed from GameController::setGameSeed() while a
+ * session is recorded, so feeding the same keys before the same ticks
+ * replays menus, games, pauses and rewinds exactly. Only key presses
+ * are kept; turbo keys are handled by the window and never reach the
+ * controller.
+ *
+ * Text format, one item per line ('#' starts a comment):
+ *
+ *     snaike-session 1
+ *     seed 1234
+ *     agent flood            (optional: controller playing classic games)
+ *     levels path/to.pack    (optional: level pack of classic games)
+ *     rewind-on-death 1      (optional: deaths froze classic games in rewind)
+ *     ticks 5000             (ticks the session ran for)
+ *     3 Enter                (ticks since the previous key, key name)
+ *     12 Up
+ *
+ * Keys the game uses are written by name (Up, Down, Left, Right, Enter,
+ * Escape, Backspace), any other by its sf::Keyboard::Key number.
+ */
+class Session {
+public:
+    std::uint64_t seed{0};              ///< Seed of every game in the session
+    std::string agent;                  ///< Controller playing classic games (empty for the keyboard)
+    std::string levels;                 ///< Level pack of classic games (empty for the open board)
+    bool rewindOnDeath{false};          ///< Deaths froze classic games in rewind (GameController::setRewindOnDeath)
+    std::uint64_t ticks{0};             ///< Ticks the session lasted
+    std::vector<SessionEvent> events;   ///< Key presses in order
+    std::string name;                   ///< File name without directory or extension (set by load())
+
+    /**
+     * @brief Appends a key press
+     * @param tick Ticks completed before the key is handled (not less than the previous event's)
+     */
+    void record(std::uint64_t tick, sf::Keyboard::Key key) { events.push_back({tick, key}); }
+
+    /**
+     * @brief Reads a session file
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    static Session load(const std::string& path);
+
+    /**
+     * @brief Writes the session file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& path) const;
+};
@@ -0,0 +1,186 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One finished game as stored in a run log
+ *
+ * Fixed 64 bytes, so the log is an array of records that appenders in
+ * different processes can extend with a single write each.
+ */
+struct RunRecord {
+    std::uint64_t seed;         ///< Game seed
+    std::uint64_t ticks;        ///< Ticks played
+    std::uint64_t finishedAt;   ///< When the game ended, Unix time in milliseconds
+    std::uint32_t durationMs;   ///< Wall-clock length of the game, milliseconds
+    std::int32_t score;         ///< Food eaten
+    std::uint32_t length;       ///< Final snake length
+    std::uint32_t tag;          ///< RunLog::RecordTag; anything else is not a record
+    char agent[24];             ///< Controller name ("keyboard" for human play), NUL-padded, truncated
+};
+static_assert(sizeof(RunRecord) == 64, "run log records must stay 64 bytes");
+
+/**
+ * @brief Header of a run log index file
+ */
+struct RunIndexHeader {
+    char magic[8];              ///< "SNKRUNI1"
+    std::uint32_t version;      ///< RunLog::IndexVersion
+    std::uint32_t byteOrder;    ///< RunLog::ByteOrderTag as written
+    std::uint64_t records;      ///< Log records covered (the first `records` of the log)
+    std::uint64_t entries;      ///< Entries following the header (covered records that are valid)
+};
+static_assert(sizeof(RunIndexHeader) == 32, "run index header must stay 32 bytes");
+
+/**
+ * @brief One index entry: a score and the log record it came from
+ */
+struct RunIndexEntry {
+    std::int32_t score;         ///< Record's score
+    std::uint32_t record;       ///< Record number in the log
+};
+
+/**
+ * @brief Shared append-only log of finished games with a sorted score index
+ *
+ * Any number of processes may append to the same log at once without
+ * locks: the log is opened with O_APPEND and every record goes out in
+ * one 64-byte write(), which the kernel places atomically at the end of
+ * the file.
+ *
+ * Queries never scan the log. <path>.idx holds the scores of the first
+ * N records sorted best first and is memory-mapped read-only; refresh()
+ * reads only the records appended after those N (the tail) and sorts
+ * them in memory. Ranks, percentiles and top-N lists are binary
+ * searches or short merges over the two sorted runs, so they take
+ * microseconds however long the log is. Once the tail grows past
+ * IndexSlack records, refresh() merges it into a new index, written to
+ * a temporary file and renamed over the old one. Processes racing to do
+ * this all produce valid indexes and the last rename wins; readers
+ * holding the old mapping keep using it until their next refresh().
+ *
+ * Without mmap (Windows) the index is read into memory and appends go
+ * through a stream opened for appending, which is only safe for a
+ * single process.
+ *
+ * One RunLog object per thread; the files may be shared by any number
+ * of processes.
+ */
+class RunLog {
+public:
+    static constexpr std::uint32_t RecordTag = 0x52554E31;        ///< "RUN1" (little endian) in every record
+    static constexpr std::uint32_t IndexVersion = 1;              ///< Index format written and accepted
+    static constexpr std::uint32_t ByteOrderTag = 0x01020304;     ///< Reads back differently on the other endianness
+    static constexpr std::size_t IndexSlack = 1024;               ///< Unindexed records tolerated before reindexing
+
+private:
+    std::string path;                       ///< Log file
+    std::string indexPath;                  ///< <path>.idx
+    int fd{-1};                             ///< Log opened for appending and reading (POSIX)
+    const RunIndexEntry* index{nullptr};    ///< Sorted entries of the current index (mapped or buffered)
+    std::uint64_t indexed{0};               ///< Entries in index
+    std::uint64_t covered{0};               ///< Log records the index covers; the tail starts here
+    void* mapping{nullptr};                 ///< Mapped index file, or null
+    std::size_t mappingSize{0};             ///< Bytes mapped
+    std::vector<RunIndexEntry> buffer;      ///< Index contents where mmap is unavailable
+    std::vector<RunIndexEntry> tail;        ///< Records after the index, sorted like it
+    std::uint64_t tailEnd{0};               ///< Log records read, indexed or in the tail
+
+    /**
+     * @brief Maps the index file if it is valid, else falls back to an empty index
+     */
+    void loadIndex();
+
+    /**
+     * @brief Releases the current index mapping
+     */
+    void unloadIndex();
+
+    /**
+     * @brief Reads log records [first, first + count)
+     * @return Records read; fewer at the end of the log
+     */
+    std::size_t readRecords(std::uint64_t first, RunRecord* out, std::size_t count) const;
+
+    /**
+     * @brief Counts log records (complete ones only)
+     */
+    std::uint64_t logRecords() const;
+
+    /**
+     * @brief Writes index plus tail as a new index file (a failure leaves the old one)
+     */
+    void reindex();
+
+    /**
+     * @brief Counts runs with a score above (strictly) or at least a value
+     */
+    std::uint64_t countAbove(int score, bool inclusive) const;
+
+public:
+    /**
+     * @brief Opens a run log, creating it if missing, and loads its index
+     * @param logPath Log file; the index lives next to it as <logPath>.idx
+     * @throws std::runtime_error if the log cannot be opened
+     */
+    explicit RunLog(const std::string& logPath);
+
+    /**
+     * @brief Closes the log and unmaps the index
+     */
+    ~RunLog();
+
+    RunLog(const RunLog&) = delete;
+    RunLog& operator=(const RunLog&) = delete;
+
+    /**
+     * @brief Fills a record's tag and truncated agent name
+     * @param agent Controller name ("keyboard" for human play)
+     */
+    static RunRecord makeRecord(const std::string& agent);
+
+    /**
+     * @brief Appends a finished game to the log
+     * @param record Record from makeRecord() with its fields filled
+     * @throws std::runtime_error if the write fails
+     *
+     * Queries see it after the next refresh()
+     */
+    void append(const RunRecord& record);
+
+    /**
+     * @brief Catches up with records appended by any process since the last refresh
+     *
+     * Reads only the unindexed tail of the log, and rewrites the index
+     * once the tail exceeds IndexSlack records
+     */
+    void refresh();
+
+    /**
+     * @brief Gets the number of runs as of the last refresh()
+     */
+    std::uint64_t size() const { return indexed + tail.size(); }
+
+    /**
+     * @brief Gets the rank a score would have
+     * @return 1 + the number of runs that scored strictly more
+     */
+    std::uint64_t rank(int score) const { return countAbove(score, false) + 1; }
+
+    /**
+     * @brief Gets the score below which a fraction of the runs fall
+     * @param q Fraction in [0, 1]; 0.5 is the median, 1 the best score
+     * @return Score, or 0 if the log is empty
+     */
+    int scoreAt(double q) const;
+
+    /**
+     * @brief Gets the best runs, best first (earlier runs first on ties)
+     * @param count Runs wanted
+     */
+    std::vector<RunRecord> top(std::size_t count) const;
+
+    const std::string& getPath() const { return path; }
+};
@@ -0,0 +1,185 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../Random.hpp"
+#include "../Snake.hpp"
+
+/**
+ * @brief Settings for one solver run
+ */
+struct SolverConfig {
+    int width = 6;                      ///< Board width in cells (4..8)
+    int height = 6;                     ///< Board height in cells (4..8)
+    std::uint64_t seed = 1;             ///< Food seed, as for GameSession
+    unsigned threads = 0;               ///< Search threads (0 = hardware concurrency)
+    std::uint32_t maxTicks = 0;         ///< Search horizon in ticks (0 = cells squared)
+    std::uint64_t maxNodes = 0;         ///< Give up after this many nodes (0 = no limit)
+    std::size_t tableMegabytes = 256;   ///< Transposition table size
+    bool fewestTicks = true;            ///< Also minimise ticks among lines with the best score
+};
+
+/**
+ * @brief Best line found by the solver
+ */
+struct SolverResult {
+    bool proven = false;              ///< Search finished, so the line is optimal within the horizon
+    int score = 0;                    ///< Food eaten on the best line
+    int length = 3;                   ///< Snake length the best line reaches
+    bool filled = false;              ///< The best line fills the whole board
+    std::uint32_t ticks = 0;          ///< Tick of the last food on the best line
+    std::vector<Direction> moves;     ///< Direction for every tick of the best line
+    std::uint64_t nodes = 0;          ///< Positions expanded over all threads
+    std::uint64_t tableHits = 0;      ///< Positions pruned by the transposition table
+    double seconds = 0.0;             ///< Wall time
+};
+
+/**
+ * @brief Exhaustive solver for the snake game on small boards
+ *
+ * Finds, for one food seed, the line that eats the most food and among
+ * those the one that gets there in the fewest ticks, so it answers both
+ * "what is the longest snake possible?" and "how fast can the board be
+ * filled?". The second question is far harder; with fewestTicks off the
+ * search stops at the first line that reaches the best score. Food appears exactly as in GameSession::spawnFood (rejection
+ * sampling with the game RNG), so a line is fully determined by its moves
+ * and serves as ground truth for agents on the same board and seed.
+ *
+ * The search is a depth-first search over Position, a copy of the
+ * Snake rules on a single 64-bit occupancy bitboard (hence at most 8x8):
+ * - Every position carries an incrementally updated Zobrist key over body
+ *   links, head, direction, food, pending growth and the RNG state
+ * - A position already searched at the same or an earlier tick is pruned
+ *   through a lock-free TranspositionTable shared by all threads, as is
+ *   a position repeated on the current path
+ * - A bit-parallel flood fill that frees body cells as the tail moves
+ *   gives a lower bound on the ticks to the food; positions that cannot
+ *   reach it at all, or cannot beat the best line so far, are cut
+ *
+ * Threads search the same root with different move orders (Lazy SMP) and
+ * share the table and the best line; the first to finish proves the
+ * result optimal within the horizon.
+ */
+class SmallBoardSolver {
+public:
+    static constexpr int MaxCells = 64;                       ///< Cells in one bitboard word
+    static constexpr std::uint8_t NoFood = MaxCells;          ///< Food value once the board is full
+
+    /**
+     * @brief Snake, food and RNG state of one solver node
+     *
+     * Trivially copyable (about 100 bytes), so the search steps by
+     * copying and keeps the expanded moves of every depth.
+     */
+    struct Position {
+        std::uint64_t occupied;               ///< Body cells, bit y * width + x
+        std::uint64_t key;                    ///< Zobrist key
+        std::uint8_t body[MaxCells];          ///< Ring of body cells from tail to head
+        std::uint8_t tail;                    ///< Ring slot of the tail
+        std::uint8_t length;                  ///< Body cells
+        std::uint8_t food;                    ///< Food cell, or NoFood
+        bool growing;                         ///< Tail stays put on the next move
+        Direction direction;                  ///< Direction of the last move
+        GameRng rng;                          ///< Food generator
+        int score;                            ///< Food eaten
+        std::uint32_t tick;                   ///< Ticks played
+
+        std::uint8_t head() const { return body[(tail + length - 1) & (MaxCells - 1)]; }
+    };
+
+private:
+    struct Shared;
+    struct Worker;
+
+    SolverConfig config;                              ///< Board, seed and limits
+    int cells;                                        ///< width * height
+    std::uint64_t boardMask;                          ///< Bits of cells on the board
+    std::uint64_t notFirstColumn;                     ///< Board bits with x > 0
+    std::uint64_t notLastColumn;                      ///< Board bits with x < width - 1
+    std::uint64_t segmentKeys[MaxCells][5];           ///< Per cell: link towards the head (4 directions) or head
+    std::uint64_t directionKeys[4];                   ///< Per direction of travel
+    std::uint64_t foodKeys[MaxCells + 1];             ///< Per food cell, plus NoFood
+    std::uint64_t growingKey;                         ///< Growth pending
+
+    /**
+     * @brief Draws food like GameSession::spawnFood and updates the key
+     */
+    void spawnFood(Position& position) const;
+
+    /**
+     * @brief Gets the link key of a body cell pointing at the next cell
+     */
+    std::uint64_t linkKey(std::uint8_t from, std::uint8_t to) const;
+
+    /**
+     * @brief Computes a lower bound on the ticks until the head can reach the food
+     * @return Ticks, or -1 if the food can never be reached
+     *
+     * Layered flood fill on bitboards: layer d holds every cell the head
+     * could be on after d moves, where body cells count as walls only
+     * until the tail has passed them. Cells the moving head would cover
+     * itself are ignored, so the bound is optimistic and pruning is sound.
+     */
+    int foodDistance(const Position& position) const;
+
+    /**
+     * @brief Searches below a position
+     * @param depth Ticks since the root (index into the worker's stacks)
+     * @param distance foodDistance() of the position, computed by the caller
+     * @return false if the search was stopped before finishing
+     */
+    bool search(Worker& worker, Shared& shared, std::uint32_t depth,
+                const Position& position, int distance) const;
+
+    /**
+     * @brief Runs one search thread from the root
+     */
+    void runWorker(Worker& worker, Shared& shared) const;
+
+public:
+    /**
+     * @brief Prepares a solver
+     * @param settings Board size, seed and limits
+     * @throws std::runtime_error if the board is smaller than 4x4 or larger than 64 cells
+     */
+    explicit SmallBoardSolver(const SolverConfig& settings);
+
+    /**
+     * @brief Gets the starting position (snake in the centre facing right)
+     */
+    Position start() const;
+
+    /**
+     * @brief Advances a position by one tick
+     * @param position Position to update in place
+     * @param direction Direction of the move (reversing is a collision)
+     * @return false if the snake died
+     */
+    bool step(Position& position, Direction direction) const;
+
+    /**
+     * @brief Recomputes a position's Zobrist key from scratch (for checking)
+     */
+    std::uint64_t computeKey(const Position& position) const;
+
+    /**
+     * @brief Searches for the best line
+     */
+    SolverResult solve() const;
+
+    /**
+     * @brief Plays a line with the regular Snake class and GameSession's food rule
+     * @param moves Direction for every tick
+     * @return Food eaten
+     * @throws std::runtime_error if the snake dies
+     *
+     * Used to check solver lines against the game's own rules.
+     */
+    int replay(const std::vector<Direction>& moves) const;
+
+    /**
+     * @brief Gets the highest possible score (snake covering the board)
+     */
+    int maxScore() const { return cells - 2; }
+
+    const SolverConfig& getConfig() const { return config; }
+};
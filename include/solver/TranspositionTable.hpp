@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Lock-free table of fully searched solver positions
+ *
+ * The solver only needs one fact per position: the earliest tick at
+ * which the whole subtree below it has been searched. Reaching the same
+ * position again at that tick or later cannot lead anywhere better, so
+ * the second visit is pruned.
+ *
+ * Each entry packs the upper 47 bits of the Zobrist key and a 16-bit
+ * tick into one std::atomic<uint64_t>, so readers and writers on any
+ * number of threads never see a torn entry and need no locks. Entries
+ * are grouped in 4-way buckets of one cache line half; a store either
+ * lowers the tick of a matching entry or evicts the entry with the
+ * latest tick (the one least likely to prune anything).
+ *
+ * A false match needs two positions that agree on the bucket index and
+ * all 47 check bits; at the table sizes used here that is rare enough
+ * to ignore, as in chess engines.
+ */
+class TranspositionTable {
+public:
+    static constexpr std::size_t BucketSize = 4;            ///< Entries per bucket
+    static constexpr std::uint32_t MaxTick = 0xFFFF;        ///< Largest storable tick
+
+private:
+    std::unique_ptr<std::atomic<std::uint64_t>[]> entries;  ///< Bucket-major entries, 0 = empty
+    std::size_t bucketMask;                                 ///< Bucket count - 1 (power of two)
+
+    static constexpr std::uint64_t TickBits = 16;
+    static constexpr std::uint64_t TickMask = (std::uint64_t{1} << TickBits) - 1;
+
+    // The top bit is forced on so a stored entry is never 0 (empty)
+    static std::uint64_t check(std::uint64_t key) { return (key & ~TickMask) | (std::uint64_t{1} << 63); }
+
+    std::atomic<std::uint64_t>* bucket(std::uint64_t key) const {
+        return &entries[(key & bucketMask) * BucketSize];
+    }
+
+public:
+    /**
+     * @brief Allocates the table
+     * @param megabytes Memory budget, rounded down to a power-of-two bucket count
+     */
+    explicit TranspositionTable(std::size_t megabytes);
+
+    /**
+     * @brief Checks whether a position was fully searched at or before a tick
+     * @param key Zobrist key of the position
+     * @param tick Tick at which the position is reached now
+     */
+    bool searchedBy(std::uint64_t key, std::uint32_t tick) const;
+
+    /**
+     * @brief Records that a position was fully searched when reached at a tick
+     * @param key Zobrist key of the position
+     * @param tick Tick at which it was reached (ignored above MaxTick)
+     */
+    void store(std::uint64_t key, std::uint32_t tick);
+
+    /**
+     * @brief Gets the number of entries
+     */
+    std::size_t size() const { return (bucketMask + 1) * BucketSize; }
+};
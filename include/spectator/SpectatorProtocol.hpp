@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * @brief Wire format of the spectator stream
+ * 
+ * The stream is a sequence of frames, each a varint payload length
+ * followed by the payload. A payload starts with a FrameType byte:
+ * 
+ * - Keyframe: tick, width, height, snake count, then per snake its id,
+ *   length and cells (head first), then food count and food cells
+ * - Tick: tick, event count, then events (SpectatorOp + arguments)
+ * 
+ * Every integer is an unsigned LEB128 varint and every position is a
+ * cell index (y * width + x), so a tick costs a few bytes per moving
+ * snake no matter how long the snakes are.
+ */
+
+enum class SpectatorFrameType : std::uint8_t {
+    Keyframe = 1,   ///< Full board, resets the viewer
+    Tick = 2        ///< Changes since the previous frame
+};
+
+enum class SpectatorOp : std::uint8_t {
+    HeadAdded = 1,      ///< id, cell: snake moved its head onto cell
+    TailRemoved = 2,    ///< id: snake dropped its last segment
+    SnakeSpawned = 3,   ///< id, length, cells: snake (re)appeared
+    SnakeRemoved = 4,   ///< id: snake died and left the board
+    FoodAdded = 5,      ///< cell
+    FoodRemoved = 6     ///< cell
+};
+
+/**
+ * @brief Appends an unsigned LEB128 varint
+ */
+inline void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * @brief Reads an unsigned LEB128 varint
+ * @param pos Read cursor, advanced past the varint
+ * @param end End of the buffer
+ * @param value Receives the decoded value
+ * @return false if the buffer ends mid-varint or the varint is malformed
+ */
+inline bool readVarint(const std::uint8_t*& pos, const std::uint8_t* end, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos == end) return false;
+        const std::uint8_t byte = *pos++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Viewer-side reconstruction of the published board
+ * 
+ * Applies keyframes and tick frames in order. Snake bodies are stored
+ * as cell indices, head first, so head/tail deltas are O(1).
+ */
+class SpectatorBoard {
+private:
+    int width = 0;                              ///< Board width in cells
+    int height = 0;                             ///< Board height in cells
+    std::uint64_t tick = 0;                     ///< Tick of the last applied frame
+    bool synced = false;                        ///< True once a keyframe was applied
+    std::vector<std::deque<std::uint32_t>> snakes; ///< Cells per snake id, head first
+    std::vector<std::uint8_t> present;          ///< Non-zero if the snake id is on the board
+    std::vector<std::uint8_t> food;             ///< Non-zero for cells holding food
+
+    bool applyKeyframe(const std::uint8_t* pos, const std::uint8_t* end);
+    bool applyTick(const std::uint8_t* pos, const std::uint8_t* end);
+    bool validCell(std::uint64_t cell) const { return cell < food.size(); }
+    std::deque<std::uint32_t>* snakeFor(std::uint64_t id);
+
+public:
+    /**
+     * @brief Applies one frame payload (without its length prefix)
+     * @return false if the payload is malformed; the board then needs a new keyframe
+     */
+    bool applyFrame(const std::uint8_t* payload, std::size_t size);
+
+    bool isSynced() const { return synced; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    std::uint64_t getTick() const { return tick; }
+    std::size_t snakeSlots() const { return snakes.size(); }
+    bool hasSnake(std::size_t id) const { return id < present.size() && present[id]; }
+    const std::deque<std::uint32_t>& getSnakeCells(std::size_t id) const { return snakes[id]; }
+    const std::vector<std::uint8_t>& getFood() const { return food; }
+};
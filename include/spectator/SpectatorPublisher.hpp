@@ -0,0 +1,135 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SpectatorProtocol.hpp"
+#include "../GameSession.hpp"
+
+class Arena;
+
+/**
+ * @brief Publishes a game to local viewers over a Unix domain socket
+ * 
+ * The SpectatorPublisher:
+ * - Listens on a non-blocking Unix stream socket
+ * - Sends each new viewer a keyframe, then one delta frame per publish
+ * - Queues output per viewer and never waits for a viewer to read
+ * 
+ * A viewer whose backlog exceeds MaxBacklogBytes has its queue dropped
+ * and is resynchronised with a fresh keyframe, so a slow viewer costs
+ * the simulation nothing but memory bounded by the backlog limit.
+ * 
+ * Call publish() once after every simulation step.
+ */
+class SpectatorPublisher {
+public:
+    static constexpr std::size_t MaxBacklogBytes = 256 * 1024;
+
+private:
+    /**
+     * @brief Per-viewer connection state
+     */
+    struct Viewer {
+        int fd = -1;                        ///< Connected socket
+        std::vector<std::uint8_t> pending;  ///< Bytes not yet accepted by the socket
+        std::size_t sent = 0;               ///< Bytes of pending already written
+        bool needsKeyframe = true;          ///< Send a keyframe before the next delta
+    };
+
+    /**
+     * @brief Last published state of one snake, used to derive deltas
+     */
+    struct SnakeMirror {
+        bool present = false;               ///< Snake was on the board
+        std::uint32_t generation = 0;       ///< Spawn counter (arena only)
+        std::size_t length = 0;             ///< Body length
+        std::uint32_t head = 0;             ///< Head cell
+    };
+
+    std::string path;                       ///< Socket path
+    int listenFd;                           ///< Listening socket
+    std::vector<Viewer> viewers;            ///< Connected viewers
+    std::vector<SnakeMirror> mirror;        ///< Published snake state
+    std::uint32_t foodCell;                 ///< Published food cell (classic only)
+    std::uint64_t lastTick;                 ///< Tick of the last publish
+    std::vector<std::uint8_t> delta;        ///< Scratch: current delta frame
+    std::vector<std::uint8_t> keyframe;     ///< Scratch: current keyframe
+    std::size_t deltaEvents;                ///< Events written to delta
+    std::size_t deltaCountAt;               ///< Offset of the event count placeholder in delta
+
+    /**
+     * @brief Accepts pending connections; new viewers start with a keyframe
+     * @return true if any connected viewer needs a keyframe
+     */
+    bool acceptViewers();
+
+    /**
+     * @brief Forces every viewer to resynchronise with a keyframe
+     */
+    void resyncAll();
+
+    void beginDelta(std::uint64_t tick);
+    void addEvent(SpectatorOp op) { delta.push_back(static_cast<std::uint8_t>(op)); ++deltaEvents; }
+    template <typename SnakeType>
+    void addSnakeSpawned(std::uint32_t id, const SnakeType& snake, int width);
+
+    template <typename SnakeType>
+    void publishSession(const BasicGameSession<SnakeType>& session);
+    void beginKeyframe(std::uint64_t tick, int width, int height);
+
+    /**
+     * @brief Queues the delta (or keyframe, where needed) for every viewer and flushes
+     */
+    void broadcast();
+
+    /**
+     * @brief Writes as much queued output as the socket accepts without blocking
+     * @return false if the viewer disconnected
+     */
+    bool flush(Viewer& viewer);
+
+    /**
+     * @brief Drops queued frames a viewer has not started receiving
+     */
+    void dropBacklog(Viewer& viewer);
+
+public:
+    /**
+     * @brief Creates the listening socket
+     * @param socketPath Filesystem path for the socket; an existing socket file is replaced
+     * @throws std::runtime_error if the socket cannot be created
+     */
+    explicit SpectatorPublisher(const std::string& socketPath);
+
+    /**
+     * @brief Disconnects all viewers and removes the socket file
+     */
+    ~SpectatorPublisher();
+
+    SpectatorPublisher(const SpectatorPublisher&) = delete;
+    SpectatorPublisher& operator=(const SpectatorPublisher&) = delete;
+
+    /**
+     * @brief Publishes the current state of a classic game
+     * 
+     * A tick counter lower than the previous publish is treated as a
+     * new game and sent to everyone as a keyframe
+     */
+    void publish(const GameSession& session);
+
+    /**
+     * @brief Publishes the current state of a compact classic game
+     */
+    void publish(const CompactGameSession& session);
+
+    /**
+     * @brief Publishes the current state of an arena
+     */
+    void publish(const Arena& arena);
+
+    /**
+     * @brief Gets the number of connected viewers
+     */
+    std::size_t viewerCount() const { return viewers.size(); }
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SpectatorProtocol.hpp"
+
+/**
+ * @brief Viewer-side connection to a SpectatorPublisher
+ * 
+ * Connects to the publisher's Unix socket, reads whatever has arrived
+ * without blocking, and applies complete frames to a SpectatorBoard.
+ */
+class SpectatorSubscriber {
+private:
+    std::string path;                   ///< Socket path
+    int fd;                             ///< Connected socket, or -1
+    std::vector<std::uint8_t> inbox;    ///< Received bytes not yet forming a whole frame
+    SpectatorBoard board;               ///< Reconstructed board
+
+public:
+    /**
+     * @brief Creates a disconnected subscriber
+     * @param socketPath Path the publisher listens on
+     */
+    explicit SpectatorSubscriber(const std::string& socketPath);
+
+    /**
+     * @brief Closes the connection
+     */
+    ~SpectatorSubscriber();
+
+    SpectatorSubscriber(const SpectatorSubscriber&) = delete;
+    SpectatorSubscriber& operator=(const SpectatorSubscriber&) = delete;
+
+    /**
+     * @brief Attempts to connect if not already connected
+     * @return true if connected
+     */
+    bool connect();
+
+    /**
+     * @brief Reads available data and applies every complete frame
+     * @return Number of frames applied
+     * 
+     * Disconnects on error or end of stream; call connect() to retry
+     */
+    int poll();
+
+    bool isConnected() const { return fd >= 0; }
+    const SpectatorBoard& getBoard() const { return board; }
+};
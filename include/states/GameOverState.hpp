@@ -1,10 +1,14 @@
 #pragma once
 #include "../State.hpp"
 #include "../GameResources.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
 
 // Forward declarations
 class GameController;
 class StateMachine;
+class RunLog;
 
 /**
  * @brief Game over screen state
@@ -12,12 +16,16 @@ class StateMachine;
  * Displays when the player loses and shows:
  * - Game over message
  * - Final score
+ * - With a run log, the game's rank among all logged runs and the best runs
  * - Press Enter to return to menu prompt
  */
 class GameOverState : public State {
+public:
+    static constexpr std::size_t TopRuns = 5;   ///< Best runs listed from the run log
+
 private:
-    sf::Text gameOverText;    ///< Main "Game Over" message
-    sf::Text scoreText;       ///< Displays final score
+    std::string scoreText;    ///< Final score line (drawn below the message when set)
+    std::vector<std::string> details;   ///< Rank and best runs, one line each (empty without a run log)
 
 public:
     /**
@@ -30,6 +38,17 @@ public:
      */
     GameOverState(GameController* controller, const GameResources& resources, StateMachine* machine);
 
+    /**
+     * @brief Sets the result of the game that just ended
+     * @param score Final score
+     * @param log Run log the game was appended to, or null
+     *
+     * Called by PlayingState before switching here. With a log, it is
+     * refreshed and queried for the score's rank, the median and best
+     * scores and the TopRuns best runs
+     */
+    void setResult(int score, RunLog* log);
+
     /**
      * @brief Handles input events
      * @param event SFML event to process
@@ -39,22 +58,35 @@ public:
      */
     void handleInput(const sf::Event& event) override;
 
+    StateType getType() const override { return StateType::GameOver; }
+
     /**
      * @brief Updates game over state
      * 
-     * Currently empty as state is static
+     * Preloads the menu state
      */
     void update() override;
 
     /**
      * @brief Renders game over screen
-     * @param window SFML window to render to
+     * @param frame Snapshot to describe the frame in
      * 
      * Draws:
      * - Game over message
      * - Final score
      */
-    void render(sf::RenderWindow& window) override;
+    void render(FrameSnapshot& frame) const override;
+
+    /**
+     * @brief Describes the game over screen
+     * @param scoreText Final score line (omitted when empty)
+     * @param frame Snapshot to add the texts to
+     * @param detailLines Smaller lines drawn below the score
+     *
+     * Static so headless tools can produce the same frames as the game
+     */
+    static void describe(std::string_view scoreText, FrameSnapshot& frame,
+                         const std::vector<std::string>& detailLines = {});
 
     /**
      * @brief Called when state is paused
@@ -1,6 +1,7 @@
 #pragma once
 #include "../State.hpp"
 #include "../GameResources.hpp"
+#include <string>
 #include <vector>
 
 // Forward declarations
@@ -12,15 +13,14 @@ class StateMachine;
  * 
  * Provides the main menu interface with:
  * - Game title
- * - Selectable menu options (Play, Quit)
+ * - Selectable menu options (Play, Arena, Quit)
  * - Keyboard navigation
  * - Visual feedback for selection
  */
 class MenuState : public State {
 private:
-    sf::Text titleText;                ///< Game title text
-    std::vector<sf::Text> menuOptions; ///< List of menu options
-    int selectedOption;                ///< Currently selected menu item index
+    std::vector<std::string> menuOptions; ///< Labels of the menu options
+    int selectedOption;                   ///< Currently selected menu item index
 
 public:
     /**
@@ -44,22 +44,24 @@ public:
      */
     void handleInput(const sf::Event& event) override;
 
+    StateType getType() const override { return StateType::Menu; }
+
     /**
      * @brief Updates menu state
      * 
-     * Currently empty as menu is static
+     * Preloads the state behind the highlighted option
      */
     void update() override;
 
     /**
      * @brief Renders menu screen
-     * @param window SFML window to render to
+     * @param frame Snapshot to describe the frame in
      * 
      * Draws:
      * - Game title
      * - Menu options with selected item highlighted
      */
-    void render(sf::RenderWindow& window) override;
+    void render(FrameSnapshot& frame) const override;
 
     /**
      * @brief Called when menu is paused
@@ -16,9 +16,6 @@ class StateMachine;
  * - Semi-transparent overlay
  */
 class PausedState : public State {
-private:
-    sf::Text pausedText;    ///< Centered "PAUSED" message
-
 public:
     /**
      * @brief Constructs pause state
@@ -39,6 +36,8 @@ public:
      */
     void handleInput(const sf::Event& event) override;
 
+    StateType getType() const override { return StateType::Paused; }
+
     /**
      * @brief Updates pause state
      * 
@@ -48,11 +47,11 @@ public:
 
     /**
      * @brief Renders pause overlay
-     * @param window SFML window to render to
+     * @param frame Snapshot to describe the frame in
      * 
      * Draws:
      * - Centered pause message
      * - Optional: semi-transparent overlay
      */
-    void render(sf::RenderWindow& window) override;
+    void render(FrameSnapshot& frame) const override;
 };
\ No newline at end of file
@@ -1,13 +1,28 @@
 #pragma once
 #include "../State.hpp"
-#include "../Snake.hpp"
+#include "../GameSession.hpp"
+#include "../Arena.hpp"
 #include "../GameResources.hpp"
-#include <random>
+#include "../RewindHistory.hpp"
+#include "../trajectory/TrajectoryWriter.hpp"
+#include "../agents/Controller.hpp"
+#include "../input/CommandQueue.hpp"
+#include "../metrics/Metrics.hpp"
+#include <chrono>
+#include <memory>
 
 // Forward declarations
 class GameController;
 class StateMachine;
 
+/**
+ * @brief Rule set used by PlayingState
+ */
+enum class PlayMode {
+    Classic,  ///< One snake, one food
+    Arena     ///< Player snake 0 against autopilot snakes on a shared board with expiring, weighted food
+};
+
 /**
  * @brief Main gameplay state
  * 
@@ -20,19 +35,59 @@ class StateMachine;
  */
 class PlayingState : public State {
 private:
-    Snake snake;              ///< Player-controlled snake entity
-    sf::Vector2i food;       ///< Current food position
-    std::mt19937 rng;        ///< Random number generator for food placement
+    PlayMode mode;                ///< Which rule set is active
+    GameSession session;          ///< Snake, food and rules for a classic game
+    std::unique_ptr<Arena> arena; ///< Shared board for arena games (null in classic mode)
+    std::unique_ptr<Controller> autopilot; ///< Steers the player instead of the keyboard (classic mode, optional)
+    std::unique_ptr<RewindHistory> history; ///< Recent ticks for rewinding (classic mode)
+    TrajectoryWriter* trajectories{nullptr}; ///< Controller's step recorder (classic mode, optional)
+    bool recordedSteps{false};    ///< This game has committed rows to trajectories
+    std::uint64_t gameSeed{0};    ///< Seed of the classic game, recorded with its steps
+    std::chrono::steady_clock::time_point startedAt; ///< First tick of the game, for the run log
+    bool rewinding{false};        ///< The game is frozen and the history view is shown
+    bool runLogged{false};        ///< The game's death was appended to the run log
+    bool ended{false};            ///< The player died and the game froze in rewind; leaving the rewind ends the game
+    CommandQueue commands;        ///< Player turns waiting for their tick
+    Histogram& inputLatency;      ///< Turn issued -> tick that moves that way
+    Counter& droppedCommands;     ///< Turns lost to a full queue
 
     /**
-     * @brief Spawns new food in valid position
-     * 
-     * Places food:
-     * - Randomly on grid
-     * - Not on snake body
-     * - Within grid bounds
+     * @brief Routes a direction to the player's snake
+     * @param dir Requested direction
+     */
+    void steerPlayer(Direction dir);
+
+    /**
+     * @brief Applies the oldest queued turn the snake can take this tick
+     *
+     * Called once per tick before the step, so each turn is checked
+     * against the direction the snake actually moved in
+     */
+    void applyNextCommand();
+
+    /**
+     * @brief Handles a key while the game is rewound
+     *
+     * Left/Right step one tick, Up/Down jump RewindJump ticks,
+     * Enter or Backspace resume from the shown tick and Escape returns
+     * to the live game (or to GameOverState once the player has died)
      */
-    void spawnFood();
+    void handleRewindKey(sf::Keyboard::Key key);
+
+    /**
+     * @brief Leaves the game for GameOverState, which ranks classic games against the run log
+     */
+    void endGame();
+
+    /**
+     * @brief Appends the classic game to the controller's run log, if any
+     *
+     * Called when the snake dies, before any rewind freeze, so
+     * unattended runs are logged without waiting for a key. Only the
+     * first death of a game is logged; play resumed from the rewind
+     * after it is inspection, not a new run.
+     */
+    void logRun();
 
 public:
     /**
@@ -40,50 +95,115 @@ public:
      * @param controller Pointer to game controller
      * @param resources Reference to game resources
      * @param machine Pointer to state machine
+     * @param playMode Classic single-snake game or arena
      * 
-     * Initializes:
-     * - Snake at starting position
-     * - Random number generator
-     * - Initial food placement
+     * Starts a fresh game session with the snake at the
+     * centre of the grid and initial food placed, or an arena
+     * with GameConfig::ARENA_BOTS autopilot opponents. Classic
+     * games are played on a random level of the controller's level
+     * pack, and by its agent, when those are set
+     * @throws std::runtime_error if the agent cannot be created
      */
-    PlayingState(GameController* controller, const GameResources& resources, StateMachine* machine);
+    PlayingState(GameController* controller, const GameResources& resources, StateMachine* machine,
+                 PlayMode playMode = PlayMode::Classic);
+
+    /**
+     * @brief Ends the recorded trajectory with CutOff if the game is left before it ends
+     */
+    ~PlayingState() override;
 
     /**
      * @brief Handles input events
      * @param event SFML event to process
      * 
-     * Processes:
-     * - Arrow keys for snake direction
-     * - Escape for pause
+     * Stamps the event with the current time and handles it
+     * like handleTimedInput()
      */
     void handleInput(const sf::Event& event) override;
 
+    StateType getType() const override { return mode == PlayMode::Arena ? StateType::Arena : StateType::Playing; }
+
+    /**
+     * @brief Handles an input event stamped with its poll time
+     * @param input Event and poll time
+     *
+     * Arrow keys become MoveCommands carrying the poll time, so the
+     * latency to the move can be measured; Escape pauses and
+     * Backspace freezes a classic game to rewind it
+     */
+    void handleTimedInput(const InputEvent& input) override;
+
+    /**
+     * @brief Queues a turn for the player's snake
+     * @param command Direction and issue time
+     * @return false if the queue was full and the command was dropped
+     *
+     * The single entry point for steering: keyboard input, recorded
+     * command streams and agents all queue commands here, and update()
+     * applies at most one per tick
+     */
+    bool enqueue(const MoveCommand& command);
+
     /**
      * @brief Updates game logic
      * 
-     * Handles:
-     * - Snake movement
-     * - Collision detection
-     * - Food collection
-     * - Game over conditions
+     * Applies at most one queued turn, advances the game
+     * session (or arena) by one tick, records it in the rewind
+     * history (and the trajectory writer, if any), publishes FoodEaten and PlayerDied on the state
+     * machine's EventBus and switches to GameOverState when the
+     * player's snake dies or fills the board. With rewind on death
+     * (--rewind-on-death, GameController::isRewindOnDeath()) a
+     * classic game's death instead freezes it in rewind, whoever was
+     * steering, so it can be inspected: Enter plays on from the shown
+     * tick, Escape ends the game.
+     * Nothing advances while rewinding.
+     * PausedState and GameOverState are preloaded so either
+     * transition is instant
      */
     void update() override;
 
     /**
      * @brief Renders game elements
-     * @param window SFML window to render to
+     * @param frame Snapshot to describe the frame in
      * 
      * Draws:
      * - Snake body
      * - Food
      * - Score (if implemented)
+     * - While rewinding, the shown tick and the recorded range
+     */
+    void render(FrameSnapshot& frame) const override;
+
+    /**
+     * @brief Describes a classic game: grey walls, green snake, red food
+     * @param session Game to describe
+     * @param frame Snapshot to add the cells to
+     *
+     * Static so headless tools can produce the same frames as the game
+     */
+    static void describeSession(const GameSession& session, FrameSnapshot& frame);
+
+    /**
+     * @brief Describes a classic board from its parts
+     * @param level Walls to draw
+     * @param snake Snake to draw
+     * @param food Food position
+     * @param frame Snapshot to add the cells to
+     */
+    static void describeBoard(const Level& level, const Snake& snake, const sf::Vector2i& food,
+                              FrameSnapshot& frame);
+
+    /**
+     * @brief Describes the arena occupancy grid, one cell per owner colour, bonus food in gold
+     * @param arena Arena to describe
+     * @param frame Snapshot to add the cells to
      */
-    void render(sf::RenderWindow& window) override;
+    static void describeArena(const Arena& arena, FrameSnapshot& frame);
 
     /**
      * @brief Called when game is paused
      * 
-     * Preserves current game state
+     * Discards queued turns
      */
     void pause() override;
 
@@ -0,0 +1,54 @@
+#pragma once
+#include "../State.hpp"
+#include "../GameResources.hpp"
+#include "../spectator/SpectatorSubscriber.hpp"
+#include <string>
+
+// Forward declarations
+class GameController;
+class StateMachine;
+
+/**
+ * @brief Read-only viewer for a game published by another process
+ * 
+ * Shows the board reconstructed from a SpectatorPublisher stream:
+ * - Connects to GameController::getSpectateSource()
+ * - Retries while the publisher is not running
+ * - Scales boards of any size to fit the window
+ */
+class SpectatorState : public State {
+private:
+    SpectatorSubscriber subscriber;   ///< Stream connection and reconstructed board
+    std::string statusText;           ///< Connection status / tick readout
+
+public:
+    /**
+     * @brief Constructs spectator state
+     * @param controller Pointer to game controller
+     * @param resources Reference to game resources
+     * @param machine Pointer to state machine
+     */
+    SpectatorState(GameController* controller, const GameResources& resources, StateMachine* machine);
+
+    /**
+     * @brief Handles input events
+     * @param event SFML event to process
+     * 
+     * Processes:
+     * - Escape to quit the viewer
+     */
+    void handleInput(const sf::Event& event) override;
+
+    StateType getType() const override { return StateType::Spectator; }
+
+    /**
+     * @brief Reconnects if needed and applies all received frames
+     */
+    void update() override;
+
+    /**
+     * @brief Renders the reconstructed board and status line
+     * @param frame Snapshot to describe the frame in
+     */
+    void render(FrameSnapshot& frame) const override;
+};
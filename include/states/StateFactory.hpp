@@ -7,12 +7,59 @@ class GameController;
 class GameResources;
 class StateMachine;
 
+/**
+ * @brief Builds game states, synchronously or ahead of time
+ * 
+ * A state that knows which state is likely to come next can call
+ * preloadState() so that the next state is constructed on a worker
+ * thread. When the transition happens, createState() hands over the
+ * preloaded instance instead of building one on the simulation thread,
+ * and discards the preloads of every other exit.
+ */
 class StateFactory {
+private:
+    /**
+     * @brief Constructs a state of the given type
+     */
+    static std::unique_ptr<State> buildState(
+        StateType type,
+        GameController* controller,
+        const GameResources& resources,
+        StateMachine* machine
+    );
+
 public:
+    /**
+     * @brief Gets a state for a transition
+     * @param type Type of state to create
+     * @param controller Pointer to game controller
+     * @param resources Reference to game resources (must outlive the state)
+     * @param machine State machine the state will be pushed to
+     * @return The preloaded instance stored in machine, or a newly built one
+     * @throws std::runtime_error for unknown state types
+     */
     static std::unique_ptr<State> createState(
         StateType type,
         GameController* controller,
         const GameResources& resources,
         StateMachine* machine
     );
-};
\ No newline at end of file
+
+    /**
+     * @brief Starts building a state on a worker thread
+     * @param type Type of state to build
+     * @param controller Pointer to game controller
+     * @param resources Reference to game resources (must outlive the state)
+     * @param machine State machine that stores the preload until createState() takes it
+     * 
+     * Does nothing if machine already holds a preload of this type, so it
+     * is cheap to call every tick. The state's constructor must not touch
+     * anything the simulation thread is mutating.
+     */
+    static void preloadState(
+        StateType type,
+        GameController* controller,
+        const GameResources& resources,
+        StateMachine* machine
+    );
+};
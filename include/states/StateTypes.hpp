@@ -3,6 +3,23 @@
 enum class StateType {
     Menu,
     Playing,
+    Arena,
     Paused,
-    GameOver
-};
\ No newline at end of file
+    GameOver,
+    Spectator
+};
+
+/**
+ * @brief Gets a state type's name for logs
+ */
+inline const char* stateTypeName(StateType type) {
+    switch (type) {
+        case StateType::Menu: return "Menu";
+        case StateType::Playing: return "Playing";
+        case StateType::Arena: return "Arena";
+        case StateType::Paused: return "Paused";
+        case StateType::GameOver: return "GameOver";
+        case StateType::Spectator: return "Spectator";
+    }
+    return "Unknown";
+}
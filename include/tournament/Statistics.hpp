@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Descriptive statistics of one sample
+ */
+struct SampleSummary {
+    std::size_t count = 0;   ///< Number of observations
+    double mean = 0.0;       ///< Arithmetic mean
+    double stddev = 0.0;     ///< Sample standard deviation (n - 1)
+    double ciLow = 0.0;      ///< Lower bound of the 95% confidence interval of the mean
+    double ciHigh = 0.0;     ///< Upper bound of the 95% confidence interval of the mean
+};
+
+/**
+ * @brief Result of a two-sided t-test
+ */
+struct TTestResult {
+    double t = 0.0;          ///< Test statistic
+    double df = 0.0;         ///< Degrees of freedom
+    double pValue = 1.0;     ///< Two-sided p-value
+};
+
+/**
+ * @brief Summarizes a sample with a Student-t 95% confidence interval
+ * @param values Observations
+ */
+SampleSummary summarize(const std::vector<double>& values);
+
+/**
+ * @brief Paired two-sided t-test on a[i] - b[i]
+ * @param a First sample
+ * @param b Second sample, same length and pairing as a (e.g. same seeds)
+ */
+TTestResult pairedTTest(const std::vector<double>& a, const std::vector<double>& b);
+
+/**
+ * @brief Welch's unequal-variance two-sided t-test
+ * @param a First sample
+ * @param b Second sample
+ */
+TTestResult welchTTest(const std::vector<double>& a, const std::vector<double>& b);
+
+/**
+ * @brief Two-sided tail probability P(|T| >= |t|) for Student's t distribution
+ * @param t Test statistic
+ * @param df Degrees of freedom (> 0)
+ */
+double studentTwoSidedP(double t, double df);
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../GameSession.hpp"
+#include "../agents/Controller.hpp"
+#include "../levels/LevelPack.hpp"
+#include "../trajectory/TrajectoryWriter.hpp"
+#ifdef SNAIKE_PLUGINS
+#include "../agents/AgentPlugin.hpp"
+#endif
+
+/**
+ * @brief How a tournament game ended
+ */
+enum class GameEnd {
+    Died,       ///< Snake crashed (the normal outcome)
+    Filled,     ///< Snake covered every free cell (a perfect game)
+    MaxTicks,   ///< Hit the tick limit
+    Starved,    ///< Went too long without eating (usually a loop)
+    Error       ///< Controller threw an exception
+};
+
+/**
+ * @brief Gets the report name of a game end
+ */
+const char* gameEndName(GameEnd end);
+
+/**
+ * @brief Result of one agent playing one seed
+ */
+struct GameRecord {
+    std::string agent;               ///< Controller name
+    std::uint64_t seed = 0;          ///< Game seed; replays the game exactly
+    int score = 0;                   ///< Food eaten
+    std::uint64_t ticks = 0;         ///< Ticks survived
+    double ticksPerFood = 0.0;       ///< ticks / score, or 0 if nothing was eaten
+    double nsPerDecision = 0.0;      ///< Mean wall time of Controller::decide
+    GameEnd end = GameEnd::Died;     ///< How the game ended
+    std::string error;               ///< Exception message for GameEnd::Error
+};
+
+/**
+ * @brief Tournament settings
+ */
+struct TournamentConfig {
+    std::vector<std::string> agents;          ///< Registered controller names to compare
+    std::uint64_t firstSeed = 1;              ///< Seeds are firstSeed .. firstSeed + numSeeds - 1
+    std::uint32_t numSeeds = 200;             ///< Games per agent
+    unsigned threads = 0;                     ///< Worker threads (0 = hardware concurrency)
+    std::uint64_t maxTicks = 200000;          ///< Tick limit per game
+    std::uint64_t starveTicks = 4 * GameSession::ObservationSize; ///< Ticks without food before giving up
+    std::uint32_t batchSize = 64;             ///< Games per act_batch call for plugin agents
+    std::string levelPack;                    ///< Level pack to play (seed s on level s % count), empty for the open board
+    std::string trajectoryDir;                ///< Directory to stream every step to as .npy chunks, empty to not record
+};
+
+/**
+ * @brief Evaluates controllers over a fixed seed set on many cores
+ * 
+ * Each worker thread owns one GameSession and one controller instance
+ * per agent, and resets them between games instead of rebuilding them.
+ * Plugin agents ("plugin:<path>") are instead played batchSize games at
+ * a time in lockstep, with one act_batch call per tick for the whole
+ * batch. Results are ordered by agent, then seed, regardless of thread
+ * timing. When recording trajectories, each worker streams each agent's
+ * steps through its own TrajectoryWriter ("<agent>-w<worker>" files).
+ */
+class Tournament {
+private:
+    TournamentConfig config;   ///< Settings for this run
+    std::unique_ptr<LevelPack> levels; ///< Mapped config.levelPack (null for the open board)
+
+public:
+    /**
+     * @brief Creates a tournament
+     * @param settings Agents, seeds and limits
+     * @throws std::runtime_error if an agent name is not registered or the level pack is invalid
+     */
+    explicit Tournament(const TournamentConfig& settings);
+
+    /**
+     * @brief Plays every agent on every seed
+     * @return One record per game, agent-major in config order
+     */
+    std::vector<GameRecord> run() const;
+
+    /**
+     * @brief Plays a single game, reusing an existing session and controller
+     * @param session Session to reset and play in
+     * @param controller Controller to reset and consult every tick
+     * @param agent Name recorded in the result
+     * @param seed Game seed
+     * @param maxTicks Tick limit
+     * @param starveTicks Ticks without food before the game is abandoned
+     * @param levels Pack to take the seed's level from, or null for the open board
+     * @param trajectories Writer to record every step to, or null
+     */
+    static GameRecord playGame(GameSession& session, Controller& controller, const std::string& agent,
+                               std::uint64_t seed, std::uint64_t maxTicks, std::uint64_t starveTicks,
+                               const LevelPack* levels = nullptr, TrajectoryWriter* trajectories = nullptr);
+
+#ifdef SNAIKE_PLUGINS
+    /**
+     * @brief Plays consecutive seeds with a plugin, one act_batch call per tick
+     * @param plugin Plugin instance; its slots are the batch width
+     * @param agent Name recorded in the results
+     * @param firstSeed Seed of the first game
+     * @param records One record per game, filled in seed order
+     * @param numGames Number of games (and records)
+     * @param maxTicks Tick limit per game
+     * @param starveTicks Ticks without food before a game is abandoned
+     * @param levels Pack to take each seed's level from, or null for the open board
+     * @param trajectories Writer to record every step to, or null
+     *
+     * Every slot plays its own game; a slot whose game ends starts the
+     * next seed, and goes idle (null observation) once none are left.
+     * Recorded steps are held per slot and written when the slot's game
+     * ends, so each game's rows reach the writer as one consecutive run.
+     */
+    static void playBatch(AgentPlugin& plugin, const std::string& agent, std::uint64_t firstSeed,
+                          GameRecord* records, std::uint32_t numGames,
+                          std::uint64_t maxTicks, std::uint64_t starveTicks,
+                          const LevelPack* levels = nullptr, TrajectoryWriter* trajectories = nullptr);
+#endif
+
+    const TournamentConfig& getConfig() const { return config; }
+};
+
+/**
+ * @brief Writes one CSV row per game
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeTournamentCsv(const std::string& path, const std::vector<GameRecord>& records);
+
+/**
+ * @brief Writes per-agent statistics, pairwise tests and failing seeds as JSON
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeTournamentJson(const std::string& path, const TournamentConfig& config,
+                         const std::vector<GameRecord>& records);
+
+/**
+ * @brief Prints per-agent statistics and pairwise score tests
+ */
+void printTournamentSummary(std::ostream& out, const TournamentConfig& config,
+                            const std::vector<GameRecord>& records);
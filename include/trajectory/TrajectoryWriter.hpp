@@ -0,0 +1,191 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../GameConfig.hpp"
+#include "../metrics/Metrics.hpp"
+#include "../Snake.hpp"
+
+/**
+ * @brief How a recorded step left the game
+ */
+enum class TrajectoryDone : std::uint8_t {
+    Running = 0,    ///< The game goes on
+    Died = 1,       ///< The snake crashed or filled the board (terminal)
+    CutOff = 2      ///< The game was stopped by a limit (truncated, not terminal)
+};
+
+/**
+ * @brief Streams (observation, action, reward, done, tick, seed) rows to .npy chunk files
+ *
+ * Rows are gathered column by column into fixed-size chunk buffers. A
+ * full chunk is handed to a background thread, which writes one .npy
+ * file per column:
+ *
+ *     <directory>/<prefix>-<chunk>.observations.npy  uint8   (rows, height, width), CellType values
+ *     <directory>/<prefix>-<chunk>.actions.npy       uint8   (rows,), Direction moved in
+ *     <directory>/<prefix>-<chunk>.rewards.npy       float32 (rows,), food score gained by the step
+ *     <directory>/<prefix>-<chunk>.dones.npy         uint8   (rows,), TrajectoryDone
+ *     <directory>/<prefix>-<chunk>.ticks.npy         uint64  (rows,), tick the observation was taken at
+ *     <directory>/<prefix>-<chunk>.seeds.npy         uint64  (rows,), game seed
+ *
+ * Headers are padded to 64 bytes, so numpy.load(path, mmap_mode="r")
+ * maps the data in place. A chunk's files are written under temporary
+ * names and renamed once all six are complete, so readers never see a
+ * partial chunk.
+ *
+ * Rows of one game are consecutive and the game's last row is never
+ * Running: it is Died, or CutOff when the game was stopped early. That
+ * includes a game left from the pause menu, and a game the window
+ * rewound and resumed from an earlier tick. The abandoned branch ends
+ * in CutOff (or Died, if it died), and the resumed play follows as a
+ * new run of rows for the same seed, with ticks starting again from the
+ * resume point. Split games on dones != 0; ticks are not monotonic
+ * across that boundary.
+ *
+ * A full chunk is handed off when the next row starts rather than when
+ * its last row is committed, so cutOff() can always reach the last row.
+ *
+ * Memory is bounded by bufferCount chunks no matter how long the run is.
+ * The producer blocks (counted in snaike_trajectory_stalls_total) only
+ * when every spare buffer is still waiting for the disk. Filling a
+ * row does not allocate.
+ *
+ * Single producer: one writer per simulation thread.
+ */
+class TrajectoryWriter {
+public:
+    static constexpr std::size_t DefaultChunkRows = 8192;   ///< About 10 MB per chunk on the 40x30 board
+
+private:
+    /**
+     * @brief Column buffers of one chunk
+     */
+    struct Chunk {
+        std::vector<std::uint8_t> observations;
+        std::vector<std::uint8_t> actions;
+        std::vector<float> rewards;
+        std::vector<std::uint8_t> dones;
+        std::vector<std::uint64_t> ticks;
+        std::vector<std::uint64_t> seeds;
+        std::size_t rows{0};            ///< Rows filled
+        std::uint64_t index{0};         ///< Chunk number in the file names
+        bool full{false};               ///< Waiting for the background thread
+    };
+
+    std::string directory;              ///< Output directory
+    std::string prefix;                 ///< File name prefix
+    int width;                          ///< Observation columns
+    int height;                         ///< Observation rows
+    std::size_t chunkRows;              ///< Rows per chunk
+    std::vector<Chunk> chunks;          ///< Buffer pool
+    Chunk* filling{nullptr};            ///< Chunk the producer writes to (producer only)
+    std::uint64_t nextIndex{0};         ///< Number of the next chunk handed out (producer only)
+    std::uint64_t totalRows{0};         ///< Rows committed (producer only)
+    Counter& stalls;                    ///< Chunks that had to wait for a free buffer
+
+    std::mutex mutex;                   ///< Guards full flags, stopping and error
+    std::condition_variable wake;       ///< Signals full chunks, freed chunks and stopping
+    bool stopping{false};               ///< Set by close()
+    bool closed{false};                 ///< close() has run (producer only)
+    std::exception_ptr error;           ///< First write failure, rethrown to the producer
+    std::thread worker;                 ///< Background writer
+
+    /**
+     * @brief Background thread: writes full chunks in order until stopped
+     */
+    void writeLoop();
+
+    /**
+     * @brief Writes the six column files of a chunk
+     */
+    void writeChunk(const Chunk& chunk) const;
+
+    /**
+     * @brief Hands the filling chunk to the writer and takes a free one
+     * @throws std::runtime_error if a write failed
+     */
+    void rotate();
+
+public:
+    /**
+     * @brief Starts a writer
+     * @param outputDirectory Directory for the chunk files (created if missing)
+     * @param filePrefix Name prefix, so several writers can share a directory
+     * @param chunkSize Rows per chunk file
+     * @param bufferCount Chunks in memory (at least 2: one filling, one writing)
+     * @param boardWidth Observation width in cells
+     * @param boardHeight Observation height in cells
+     * @throws std::runtime_error if the directory cannot be created
+     */
+    TrajectoryWriter(const std::string& outputDirectory, const std::string& filePrefix,
+                     std::size_t chunkSize = DefaultChunkRows, std::size_t bufferCount = 2,
+                     int boardWidth = GameConfig::GRID_WIDTH, int boardHeight = GameConfig::GRID_HEIGHT);
+
+    /**
+     * @brief Flushes and stops the writer, reporting (not throwing) write errors
+     */
+    ~TrajectoryWriter();
+
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+    /**
+     * @brief Gets the observation buffer of the next row
+     * @return width * height bytes to fill (e.g. with GameSession::writeObservation) before commit()
+     * @throws std::runtime_error if an earlier chunk failed to write
+     */
+    std::uint8_t* observation() {
+        if (filling->rows == chunkRows) {
+            rotate();
+        }
+        return filling->observations.data() + filling->rows * static_cast<std::size_t>(width) * height;
+    }
+
+    /**
+     * @brief Completes the row whose observation was just filled
+     * @param action Direction the snake moved in
+     * @param reward Score gained by the move
+     * @param done Whether and how the move ended the game
+     * @param tick Tick the observation was taken at
+     * @param seed Seed of the game
+     * @throws std::runtime_error if an earlier chunk failed to write
+     */
+    void commit(Direction action, float reward, TrajectoryDone done, std::uint64_t tick, std::uint64_t seed) {
+        Chunk& chunk = *filling;
+        chunk.actions[chunk.rows] = static_cast<std::uint8_t>(action);
+        chunk.rewards[chunk.rows] = reward;
+        chunk.dones[chunk.rows] = static_cast<std::uint8_t>(done);
+        chunk.ticks[chunk.rows] = tick;
+        chunk.seeds[chunk.rows] = seed;
+        ++chunk.rows;
+        ++totalRows;
+    }
+
+    /**
+     * @brief Ends the game of the last committed row early, unless that row already ends it
+     *
+     * Marks the row CutOff if it is Running; called when a game is
+     * left or rewound to an earlier tick, so its rows stop there
+     */
+    void cutOff() {
+        Chunk& chunk = *filling;
+        if (chunk.rows > 0 && chunk.dones[chunk.rows - 1] == static_cast<std::uint8_t>(TrajectoryDone::Running)) {
+            chunk.dones[chunk.rows - 1] = static_cast<std::uint8_t>(TrajectoryDone::CutOff);
+        }
+    }
+
+    /**
+     * @brief Writes the partial last chunk and waits for all files
+     * @throws std::runtime_error if any chunk failed to write
+     */
+    void close();
+
+    std::uint64_t rows() const { return totalRows; }
+    const std::string& getDirectory() const { return directory; }
+};
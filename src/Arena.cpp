@@ -0,0 +1,274 @@
+#include "Arena.hpp"
+#include "metrics/Metrics.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+    constexpr int SpawnAttempts = 64;   // Random probes before giving up until the next tick
+    constexpr int TurnChance = 8;       // Autopilot turns voluntarily one tick in TurnChance
+    constexpr int RoomMargin = 4;       // Free cells beyond its length an autopilot wants ahead
+    constexpr int FoodSight = 24;       // Autopilots head for food at most this many cells away
+
+    Direction turnLeft(Direction dir) {
+        switch (dir) {
+            case Direction::Up:    return Direction::Left;
+            case Direction::Left:  return Direction::Down;
+            case Direction::Down:  return Direction::Right;
+            case Direction::Right: return Direction::Up;
+        }
+        return dir;
+    }
+
+    Direction turnRight(Direction dir) {
+        switch (dir) {
+            case Direction::Up:    return Direction::Right;
+            case Direction::Right: return Direction::Down;
+            case Direction::Down:  return Direction::Left;
+            case Direction::Left:  return Direction::Up;
+        }
+        return dir;
+    }
+}
+
+Arena::Arena(int gridWidth, int gridHeight, std::size_t numSnakes, int foodCount, std::uint64_t seed,
+             const ArenaFoodRules& rules)
+    : width(gridWidth)
+    , height(gridHeight)
+    , foodTarget(foodCount)
+    , foodRules(rules)
+    , tick(0)
+    , snakes(numSnakes)
+    , alive(numSnakes, 0)
+    , autopilot(numSnakes, 1)
+    , scores(numSnakes, 0)
+    , generations(numSnakes, 0)
+    , cells(static_cast<std::size_t>(gridWidth) * gridHeight, NoOwner)
+    , food(gridWidth, gridHeight, static_cast<std::size_t>(foodCount), rules.lifetime)
+    , freeCells(gridWidth, gridHeight)
+    , grid(gridWidth, gridHeight)
+    , claimTick(cells.size(), 0)
+    , claimOwner(cells.size(), 0)
+    , nextHeads(numSnakes)
+    , dying(numSnakes, 0)
+    , rng(seed)
+{
+    if (numSnakes > MaxSnakes) {
+        throw std::runtime_error("Arena supports at most " + std::to_string(MaxSnakes) + " snakes");
+    }
+    freeCells.fill();
+    deadList.reserve(numSnakes);
+    foodSpawned.reserve(static_cast<std::size_t>(foodCount));
+    foodEaten.reserve(static_cast<std::size_t>(foodCount));
+
+    // Small boards reserve full-board bodies so steps never allocate; big
+    // boards let bodies grow on demand (capacity is kept across respawns)
+    if (numSnakes * cells.size() <= BodyReserveBudget) {
+        for (Snake& snake : snakes) {
+            snake.reserve(cells.size());
+        }
+    }
+
+    for (std::size_t id = 0; id < snakes.size(); ++id) {
+        spawnSnake(id);
+    }
+    while (static_cast<int>(food.size()) < foodTarget && spawnFood()) {
+    }
+}
+
+bool Arena::spawnSnake(std::size_t id) {
+    // Keep a free column ahead of the head so the first move is never fatal
+    if (width < 4) return false;
+    for (int attempt = 0; attempt < SpawnAttempts; ++attempt) {
+        sf::Vector2i head(2 + static_cast<int>(rng.bounded(static_cast<std::uint32_t>(width - 3))),
+                          static_cast<int>(rng.bounded(static_cast<std::uint32_t>(height))));
+        bool free = true;
+        for (int dx = -2; dx <= 1 && free; ++dx) {
+            free = cells[index(sf::Vector2i(head.x + dx, head.y))] == NoOwner;
+        }
+        if (!free) continue;
+
+        snakes[id].reset(head);
+        const auto owner = static_cast<std::uint16_t>(id + 1);
+        for (const auto& segment : snakes[id].getBody()) {
+            setCell(index(segment), owner);
+        }
+        alive[id] = 1;
+        scores[id] = 0;
+        ++generations[id];
+        return true;
+    }
+    return false;
+}
+
+bool Arena::spawnFood() {
+    static Counter& retries = MetricsRegistry::instance().counter(
+        "snaike_food_spawn_retries_total{mode=\"arena\"}",
+        "Food positions redrawn because the cell was occupied");
+
+    for (int attempt = 0; attempt < SpawnAttempts; ++attempt) {
+        const int cell = static_cast<int>(rng.bounded(static_cast<std::uint32_t>(width * height)));
+        if (cells[cell] == NoOwner) {
+            const bool bonus = foodRules.bonusChance > 0 && rng.bounded(foodRules.bonusChance) == 0;
+            food.add(cell, bonus ? foodRules.bonusWeight : 1,
+                     foodRules.lifetime > 0 ? tick + foodRules.lifetime : FoodField::Never);
+            setCell(cell, FoodCell);
+            foodSpawned.push_back(cell);
+            if (attempt > 0) retries.add(static_cast<std::uint64_t>(attempt));
+            return true;
+        }
+    }
+    retries.add(SpawnAttempts);
+    return false;
+}
+
+void Arena::steer(std::size_t id) {
+    const Snake& snake = snakes[id];
+    const Direction current = snake.getDirection();
+    const bool leftFirst = (rng() & 1) != 0;
+    const Direction options[3] = {
+        current,
+        leftFirst ? turnLeft(current) : turnRight(current),
+        leftFirst ? turnRight(current) : turnLeft(current)
+    };
+
+    // Occasionally prefer a turn so bots do not all run straight into walls
+    int order[3] = {0, 1, 2};
+    if (rng.bounded(TurnChance) == 0) {
+        order[0] = 1;
+        order[1] = 2;
+        order[2] = 0;
+    }
+
+    // Food in sight takes priority: try the moves that get closer to it first
+    FoodHit nearest;
+    if (food.nearest(snake.getHead(), &nearest, 1, FoodSight) == 1) {
+        const sf::Vector2i goal(nearest.cell % width, nearest.cell / width);
+        int distance[3];
+        for (int i = 0; i < 3; ++i) {
+            const sf::Vector2i target = snake.getHead() + directionOffset(options[i]);
+            distance[i] = std::abs(target.x - goal.x) + std::abs(target.y - goal.y);
+        }
+        // Insertion sort in place: std::stable_sort would allocate a buffer every tick
+        for (int i = 1; i < 3; ++i) {
+            for (int j = i; j > 0 && distance[order[j]] < distance[order[j - 1]]; --j) {
+                std::swap(order[j], order[j - 1]);
+            }
+        }
+    }
+
+    const int room = static_cast<int>(snake.length()) + RoomMargin;
+    Direction roomiest = current;
+    int roomiestArea = -1;
+    for (int i = 0; i < 3; ++i) {
+        const Direction dir = options[order[i]];
+        const sf::Vector2i target = snake.getHead() + directionOffset(dir);
+        if (!inBounds(target) || !freeCells.test(index(target))) continue;
+
+        // Bounded fill: stops as soon as there is enough room
+        const int area = grid.reachableArea(index(target), freeCells, room);
+        if (area >= room) {
+            snakes[id].setDirection(dir);
+            return;
+        }
+        if (area > roomiestArea) {
+            roomiest = dir;
+            roomiestArea = area;
+        }
+    }
+    if (roomiestArea >= 0) {
+        snakes[id].setDirection(roomiest);
+    }
+}
+
+void Arena::clearSnake(std::size_t id) {
+    // Only clear cells still owned by this snake; a vacated tail may already hold another head
+    const auto owner = static_cast<std::uint16_t>(id + 1);
+    for (const auto& segment : snakes[id].getBody()) {
+        if (inBounds(segment) && cells[index(segment)] == owner) {
+            setCell(index(segment), NoOwner);
+        }
+    }
+}
+
+ArenaTickStats Arena::step() {
+    ArenaTickStats stats;
+    ++tick;
+    foodSpawned.clear();
+    foodEaten.clear();
+    const std::size_t count = snakes.size();
+
+    food.expire(tick, [this](int cell) {
+        setCell(cell, NoOwner);
+        foodEaten.push_back(cell);
+    });
+
+    // Pass 1: steer autopilots, compute targets and vacate tails that will move
+    for (std::size_t id = 0; id < count; ++id) {
+        if (!alive[id]) continue;
+        if (autopilot[id]) steer(id);
+        nextHeads[id] = snakes[id].nextHead();
+        if (!snakes[id].isGrowing()) {
+            setCell(index(snakes[id].getTail()), NoOwner);
+        }
+    }
+
+    // Pass 2: claim target cells; detects walls, head-to-head and head-to-body
+    for (std::size_t id = 0; id < count; ++id) {
+        if (!alive[id]) continue;
+        const sf::Vector2i& target = nextHeads[id];
+        if (!inBounds(target)) {
+            dying[id] = 1;
+            continue;
+        }
+        const int cell = index(target);
+        if (claimTick[cell] == tick) {
+            dying[id] = 1;
+            dying[claimOwner[cell]] = 1;
+        } else {
+            claimTick[cell] = tick;
+            claimOwner[cell] = static_cast<std::uint16_t>(id);
+        }
+        const std::uint16_t owner = cells[cell];
+        if (owner != NoOwner && owner != FoodCell) {
+            dying[id] = 1;
+        }
+    }
+
+    // Pass 3: move survivors and collect the dead
+    for (std::size_t id = 0; id < count; ++id) {
+        if (!alive[id]) continue;
+        if (dying[id]) {
+            deadList.push_back(static_cast<std::uint16_t>(id));
+            continue;
+        }
+        const int cell = index(nextHeads[id]);
+        const bool ate = cells[cell] == FoodCell;
+        snakes[id].move();
+        setCell(cell, static_cast<std::uint16_t>(id + 1));
+        if (ate) {
+            snakes[id].grow();
+            scores[id] += food.remove(cell);
+            ++stats.foodEaten;
+            foodEaten.push_back(cell);
+        }
+    }
+
+    for (std::uint16_t id : deadList) {
+        clearSnake(id);
+        alive[id] = 0;
+        dying[id] = 0;
+        ++stats.deaths;
+    }
+    deadList.clear();
+
+    // Refill the board; autopilot snakes come back, human snakes stay dead
+    for (std::size_t id = 0; id < count; ++id) {
+        if (!alive[id] && autopilot[id] && spawnSnake(id)) {
+            ++stats.respawns;
+        }
+    }
+    while (static_cast<int>(food.size()) < foodTarget && spawnFood()) {
+    }
+    return stats;
+}
@@ -0,0 +1,319 @@
+#include "Bitboard.hpp"
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+Bitboard::Bitboard(int boardWidth, int boardHeight)
+    : width(boardWidth)
+    , height(boardHeight)
+    , words((static_cast<std::size_t>(boardWidth) * boardHeight + 63) / 64)
+    , paddedWords((words + 3) & ~std::size_t{3})
+    , guard(static_cast<std::size_t>(boardWidth) / 64 + 1)
+    , storage(guard + paddedWords + guard, 0) {}
+
+void Bitboard::clear() {
+    std::fill(storage.begin(), storage.end(), 0);
+}
+
+void Bitboard::fill() {
+    clear();
+    const int cells = cellCount();
+    std::uint64_t* bits = data();
+    for (int i = 0; i < cells / 64; ++i) {
+        bits[i] = ~std::uint64_t{0};
+    }
+    if (cells % 64 != 0) {
+        bits[cells / 64] = (std::uint64_t{1} << (cells % 64)) - 1;
+    }
+}
+
+int Bitboard::count() const {
+    const std::uint64_t* bits = data();
+    int total = 0;
+    for (std::size_t i = 0; i < words; ++i) {
+        total += popCount(bits[i]);
+    }
+    return total;
+}
+
+bool Bitboard::any() const {
+    const std::uint64_t* bits = data();
+    std::uint64_t combined = 0;
+    for (std::size_t i = 0; i < words; ++i) {
+        combined |= bits[i];
+    }
+    return combined != 0;
+}
+
+bool Bitboard::intersects(const Bitboard& other) const {
+    const std::uint64_t* a = data();
+    const std::uint64_t* b = other.data();
+    for (std::size_t i = 0; i < words; ++i) {
+        if (a[i] & b[i]) return true;
+    }
+    return false;
+}
+
+Bitboard& Bitboard::operator|=(const Bitboard& other) {
+    std::uint64_t* a = data();
+    const std::uint64_t* b = other.data();
+    for (std::size_t i = 0; i < words; ++i) a[i] |= b[i];
+    return *this;
+}
+
+Bitboard& Bitboard::operator&=(const Bitboard& other) {
+    std::uint64_t* a = data();
+    const std::uint64_t* b = other.data();
+    for (std::size_t i = 0; i < words; ++i) a[i] &= b[i];
+    return *this;
+}
+
+Bitboard& Bitboard::andNot(const Bitboard& other) {
+    return andNot(other.data());
+}
+
+Bitboard& Bitboard::andNot(const std::uint64_t* bits) {
+    std::uint64_t* a = data();
+    for (std::size_t i = 0; i < words; ++i) a[i] &= ~bits[i];
+    return *this;
+}
+
+void Bitboard::assign(const Bitboard& other) {
+    std::copy(other.storage.begin(), other.storage.end(), storage.begin());
+}
+
+namespace {
+    // Bits of a word-shifted board: word i of (board << shift) for shift = words * 64 + bits
+    inline std::uint64_t shiftedUp(const std::uint64_t* in, std::ptrdiff_t i,
+                                   std::ptrdiff_t wordShift, unsigned bitShift) {
+        if (bitShift == 0) return in[i - wordShift];
+        return (in[i - wordShift] << bitShift) | (in[i - wordShift - 1] >> (64 - bitShift));
+    }
+
+    // Word i of (board >> shift)
+    inline std::uint64_t shiftedDown(const std::uint64_t* in, std::ptrdiff_t i,
+                                     std::ptrdiff_t wordShift, unsigned bitShift) {
+        if (bitShift == 0) return in[i + wordShift];
+        return (in[i + wordShift] >> bitShift) | (in[i + wordShift + 1] << (64 - bitShift));
+    }
+
+    bool cpuHasAvx2() {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+}
+
+BitboardGrid::BitboardGrid(int boardWidth, int boardHeight)
+    : width(boardWidth)
+    , height(boardHeight)
+    , board(boardWidth, boardHeight)
+    , notFirstColumn(boardWidth, boardHeight)
+    , notLastColumn(boardWidth, boardHeight)
+    , frontier(boardWidth, boardHeight)
+    , nextLayer(boardWidth, boardHeight)
+    , visited(boardWidth, boardHeight)
+    , layerKernel(&BitboardGrid::layerScalar)
+{
+    board.fill();
+    for (int cell = 0; cell < boardWidth * boardHeight; ++cell) {
+        if (cell % boardWidth != 0) notFirstColumn.set(cell);
+        if (cell % boardWidth != boardWidth - 1) notLastColumn.set(cell);
+    }
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    if (cpuHasAvx2()) {
+        layerKernel = &BitboardGrid::layerAvx2;
+    }
+#endif
+}
+
+bool BitboardGrid::usesAvx2() const {
+    return layerKernel != &BitboardGrid::layerScalar;
+}
+
+int BitboardGrid::layerScalar(const BitboardGrid& grid, std::size_t begin, std::size_t end,
+                              const std::uint64_t* in, const std::uint64_t* allowed,
+                              std::uint64_t* visited, std::uint64_t* out) {
+    const std::uint64_t* notFirst = grid.notFirstColumn.data();
+    const std::uint64_t* notLast = grid.notLastColumn.data();
+    const std::uint64_t* all = grid.board.data();
+    const auto wordShift = static_cast<std::ptrdiff_t>(grid.width / 64);
+    const auto bitShift = static_cast<unsigned>(grid.width % 64);
+
+    int reached = 0;
+    for (auto i = static_cast<std::ptrdiff_t>(begin); i < static_cast<std::ptrdiff_t>(end); ++i) {
+        // Mask the source column before shifting so rows never wrap
+        const std::uint64_t east = ((in[i] & notLast[i]) << 1) | ((in[i - 1] & notLast[i - 1]) >> 63);
+        const std::uint64_t west = ((in[i] & notFirst[i]) >> 1) | ((in[i + 1] & notFirst[i + 1]) << 63);
+        const std::uint64_t south = shiftedUp(in, i, wordShift, bitShift);
+        const std::uint64_t north = shiftedDown(in, i, wordShift, bitShift);
+
+        const std::uint64_t layer = (east | west | south | north) & allowed[i] & all[i] & ~visited[i];
+        out[i] = layer;
+        visited[i] |= layer;
+        reached += popCount(layer);
+    }
+    return reached;
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+namespace {
+    __attribute__((target("avx2")))
+    inline __m256i load(const std::uint64_t* words) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+    }
+}
+
+__attribute__((target("avx2")))
+int BitboardGrid::layerAvx2(const BitboardGrid& grid, std::size_t begin, std::size_t end,
+                            const std::uint64_t* in, const std::uint64_t* allowed,
+                            std::uint64_t* visited, std::uint64_t* out) {
+    const std::uint64_t* notFirst = grid.notFirstColumn.data();
+    const std::uint64_t* notLast = grid.notLastColumn.data();
+    const std::uint64_t* all = grid.board.data();
+    const auto wordShift = static_cast<std::ptrdiff_t>(grid.width / 64);
+    const auto bitShift = static_cast<unsigned>(grid.width % 64);
+    // Whole vectors only; the padding words are zero and stay zero
+    const auto first = static_cast<std::ptrdiff_t>(begin & ~std::size_t{3});
+    const auto last = static_cast<std::ptrdiff_t>((end + 3) & ~std::size_t{3});
+
+    // Variable-count shifts yield 0 for counts >= 64, so bitShift == 0 needs no branch
+    const __m128i up = _mm_cvtsi32_si128(static_cast<int>(bitShift));
+    const __m128i carryDown = _mm_cvtsi32_si128(static_cast<int>(64 - bitShift));
+
+    int reached = 0;
+    for (std::ptrdiff_t i = first; i < last; i += 4) {
+        const __m256i east = _mm256_or_si256(
+            _mm256_slli_epi64(_mm256_and_si256(load(in + i), load(notLast + i)), 1),
+            _mm256_srli_epi64(_mm256_and_si256(load(in + i - 1), load(notLast + i - 1)), 63));
+        const __m256i west = _mm256_or_si256(
+            _mm256_srli_epi64(_mm256_and_si256(load(in + i), load(notFirst + i)), 1),
+            _mm256_slli_epi64(_mm256_and_si256(load(in + i + 1), load(notFirst + i + 1)), 63));
+        const __m256i south = _mm256_or_si256(
+            _mm256_sll_epi64(load(in + i - wordShift), up),
+            _mm256_srl_epi64(load(in + i - wordShift - 1), carryDown));
+        const __m256i north = _mm256_or_si256(
+            _mm256_srl_epi64(load(in + i + wordShift), up),
+            _mm256_sll_epi64(load(in + i + wordShift + 1), carryDown));
+
+        const __m256i neighbours = _mm256_or_si256(_mm256_or_si256(east, west), _mm256_or_si256(south, north));
+        const __m256i seen = load(visited + i);
+        const __m256i layer = _mm256_andnot_si256(seen,
+            _mm256_and_si256(neighbours, _mm256_and_si256(load(allowed + i), load(all + i))));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), layer);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(visited + i), _mm256_or_si256(seen, layer));
+        if (!_mm256_testz_si256(layer, layer)) {
+            reached += popCount(static_cast<std::uint64_t>(_mm256_extract_epi64(layer, 0))) +
+                       popCount(static_cast<std::uint64_t>(_mm256_extract_epi64(layer, 1))) +
+                       popCount(static_cast<std::uint64_t>(_mm256_extract_epi64(layer, 2))) +
+                       popCount(static_cast<std::uint64_t>(_mm256_extract_epi64(layer, 3)));
+        }
+    }
+    return reached;
+}
+#endif
+
+void BitboardGrid::start(int from) {
+    frontier.set(from);
+    visited.set(from);
+    firstRow = lastRow = from / width;
+}
+
+void BitboardGrid::startAll(const Bitboard& seeds) {
+    frontier.assign(seeds);
+    visited.assign(seeds);
+    firstRow = 0;
+    lastRow = height - 1;
+}
+
+void BitboardGrid::windowWords(std::size_t& begin, std::size_t& end) const {
+    begin = static_cast<std::size_t>(firstRow) * width / 64;
+    end = (static_cast<std::size_t>(lastRow + 1) * width + 63) / 64;
+}
+
+int BitboardGrid::advance(const Bitboard& passable) {
+    // A layer reaches at most one row beyond the previous one
+    firstRow = std::max(firstRow - 1, 0);
+    lastRow = std::min(lastRow + 1, height - 1);
+    std::size_t begin;
+    std::size_t end;
+    windowWords(begin, end);
+
+    const int reached = layerKernel(*this, begin, end, frontier.data(), passable.data(),
+                                    visited.data(), nextLayer.data());
+    // Stale bits left in nextLayer lie inside the window, which only grows
+    std::swap(frontier, nextLayer);
+    return reached;
+}
+
+void BitboardGrid::finish() {
+    std::size_t begin;
+    std::size_t end;
+    windowWords(begin, end);
+    begin &= ~std::size_t{3};
+    end = (end + 3) & ~std::size_t{3};
+    for (Bitboard* scratch : {&frontier, &nextLayer, &visited}) {
+        std::fill(scratch->data() + begin, scratch->data() + end, 0);
+    }
+}
+
+void BitboardGrid::floodFill(const Bitboard& seeds, const Bitboard& passable, Bitboard& region) {
+    startAll(seeds);
+    while (advance(passable) != 0) {
+    }
+    region.assign(visited);
+    finish();
+}
+
+int BitboardGrid::reachableArea(int from, const Bitboard& passable, int limit) {
+    start(from);
+    int area = 0;
+    while (area < limit) {
+        const int layer = advance(passable);
+        if (layer == 0) break;
+        area += layer;
+    }
+    finish();
+    return area;
+}
+
+int BitboardGrid::distanceMap(int from, const Bitboard& passable, std::vector<std::uint16_t>& distances) {
+    distances.assign(static_cast<std::size_t>(width) * height, Unreachable);
+    distances[from] = 0;
+    start(from);
+
+    int layer = 0;
+    while (advance(passable) != 0) {
+        ++layer;
+        std::size_t begin;
+        std::size_t end;
+        windowWords(begin, end);
+        const std::uint64_t* bits = frontier.data();
+        for (std::size_t i = begin; i < end; ++i) {
+            for (std::uint64_t word = bits[i]; word != 0; word &= word - 1) {
+                distances[i * 64 + lowestBit(word)] = static_cast<std::uint16_t>(layer);
+            }
+        }
+    }
+    finish();
+    return layer;
+}
+
+int BitboardGrid::distance(int from, int to, const Bitboard& passable) {
+    if (from == to) return 0;
+    start(from);
+    int result = -1;
+    for (int layer = 1; advance(passable) != 0; ++layer) {
+        if (frontier.test(to)) {
+            result = layer;
+            break;
+        }
+    }
+    finish();
+    return result;
+}
@@ -0,0 +1,99 @@
+#include "CompactSnake.hpp"
+#include <cstring>
+
+CompactSnake::CompactSnake(int x, int y)
+    : headX(static_cast<std::int16_t>(x - 2))
+    , headY(static_cast<std::int16_t>(y))
+    , tailX(static_cast<std::int16_t>(x - 2))
+    , tailY(static_cast<std::int16_t>(y))
+    , firstLink(0)
+    , linkCount(0)
+    , direction(Direction::Right)
+    , hasEaten(false)
+{
+    std::memset(chain, 0, sizeof(chain));
+    // Initialize with 3 segments, built tail first like Snake's constructor
+    pushLink(Direction::Right);
+    pushLink(Direction::Right);
+    headX = static_cast<std::int16_t>(x);
+}
+
+void CompactSnake::pushLink(Direction dir) {
+    int index = firstLink + linkCount;
+    if (index >= MaxLinks) index -= MaxLinks;
+    const int shift = (index & 31) * 2;
+    std::uint64_t& word = chain[index >> 5];
+    word = (word & ~(std::uint64_t{3} << shift)) | (static_cast<std::uint64_t>(dir) << shift);
+    ++linkCount;
+}
+
+void CompactSnake::setDirection(Direction newDir) {
+    if ((direction == Direction::Up && newDir != Direction::Down) ||
+        (direction == Direction::Down && newDir != Direction::Up) ||
+        (direction == Direction::Left && newDir != Direction::Right) ||
+        (direction == Direction::Right && newDir != Direction::Left)) {
+        direction = newDir;
+    }
+}
+
+void CompactSnake::move() {
+    // A full-board snake has nowhere to grow into; keep the ring within capacity
+    if (hasEaten && linkCount < MaxLinks) {
+        hasEaten = false;
+    } else {
+        const sf::Vector2i offset = directionOffset(link(0));
+        tailX = static_cast<std::int16_t>(tailX + offset.x);
+        tailY = static_cast<std::int16_t>(tailY + offset.y);
+        firstLink = static_cast<std::uint16_t>(firstLink + 1 == MaxLinks ? 0 : firstLink + 1);
+        --linkCount;
+        hasEaten = false;
+    }
+
+    pushLink(direction);
+    const sf::Vector2i offset = directionOffset(direction);
+    headX = static_cast<std::int16_t>(headX + offset.x);
+    headY = static_cast<std::int16_t>(headY + offset.y);
+}
+
+bool CompactSnake::checkCollision(const int gridWidth, const int gridHeight) const {
+    if (headX < 0 || headX >= gridWidth || headY < 0 || headY >= gridHeight) {
+        return true;
+    }
+
+    sf::Vector2i pos(headX, headY);
+    const sf::Vector2i head = pos;
+    for (int i = linkCount - 1; i >= 0; --i) {
+        pos = pos - directionOffset(link(i));
+        if (pos == head) return true;
+    }
+    return false;
+}
+
+bool CompactSnake::eat(const sf::Vector2i& food) {
+    if (getHead() == food) {
+        hasEaten = true;
+        return true;
+    }
+    return false;
+}
+
+bool CompactSnake::occupies(const sf::Vector2i& cell) const {
+    bool found = false;
+    forEachSegment([&](const sf::Vector2i& pos) { found = found || pos == cell; });
+    return found;
+}
+
+void CompactSnake::decode(std::vector<sf::Vector2i>& out) const {
+    out.clear();
+    out.reserve(length());
+    forEachSegment([&](const sf::Vector2i& pos) { out.push_back(pos); });
+}
+
+void CompactSnake::draw(sf::RenderWindow& window, const int cellSize) const {
+    sf::RectangleShape rect(sf::Vector2f(cellSize - 1, cellSize - 1));
+    rect.setFillColor(sf::Color::Green);
+    forEachSegment([&](const sf::Vector2i& segment) {
+        rect.setPosition(segment.x * cellSize, segment.y * cellSize);
+        window.draw(rect);
+    });
+}
@@ -0,0 +1,146 @@
+#include "FoodField.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+FoodField::FoodField(int boardWidth, int boardHeight, std::size_t capacity, std::uint32_t maxLifetime)
+    : width(boardWidth)
+    , height(boardHeight)
+    , bucketsX((boardWidth + BucketSize - 1) >> BucketShift)
+    , bucketsY((boardHeight + BucketSize - 1) >> BucketShift)
+    , wheelMask(0)
+    , slotOfCell(static_cast<std::size_t>(boardWidth) * boardHeight, None)
+    , slots(capacity)
+    , bucketHeads(static_cast<std::size_t>(bucketsX) * bucketsY, None) {
+    if (maxLifetime > 0) {
+        // An item expiring maxLifetime ticks ahead must not share a wheel position with the current tick
+        std::uint32_t wheelSize = 1;
+        while (wheelSize <= maxLifetime) wheelSize *= 2;
+        wheelMask = wheelSize - 1;
+        wheelHeads.assign(wheelSize, None);
+    }
+    clear();
+}
+
+void FoodField::clear() {
+    std::fill(slotOfCell.begin(), slotOfCell.end(), None);
+    std::fill(bucketHeads.begin(), bucketHeads.end(), None);
+    std::fill(wheelHeads.begin(), wheelHeads.end(), None);
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        slots[i].cell = None;
+        slots[i].bucketNext = i + 1 < slots.size() ? static_cast<int>(i + 1) : None;
+    }
+    freeHead = slots.empty() ? None : 0;
+    count = 0;
+}
+
+bool FoodField::add(int cell, std::uint16_t weight, std::uint32_t expiresAt) {
+    if (freeHead == None || slotOfCell[cell] != None) {
+        return false;
+    }
+    const int slot = freeHead;
+    Slot& item = slots[slot];
+    freeHead = item.bucketNext;
+
+    item.cell = cell;
+    item.weight = weight;
+    item.expiresAt = wheelHeads.empty() ? Never : expiresAt;
+    slotOfCell[cell] = slot;
+
+    int& bucket = bucketHeads[bucketOf(cell)];
+    item.bucketPrev = None;
+    item.bucketNext = bucket;
+    if (bucket != None) slots[bucket].bucketPrev = slot;
+    bucket = slot;
+
+    item.wheelPrev = None;
+    item.wheelNext = None;
+    if (item.expiresAt != Never) {
+        int& wheel = wheelHeads[item.expiresAt & wheelMask];
+        item.wheelNext = wheel;
+        if (wheel != None) slots[wheel].wheelPrev = slot;
+        wheel = slot;
+    }
+    ++count;
+    return true;
+}
+
+std::uint16_t FoodField::remove(int cell) {
+    const int slot = slotOfCell[cell];
+    if (slot == None) {
+        return 0;
+    }
+    const std::uint16_t weight = slots[slot].weight;
+    release(slot);
+    return weight;
+}
+
+void FoodField::release(int slot) {
+    Slot& item = slots[slot];
+
+    if (item.bucketPrev != None) {
+        slots[item.bucketPrev].bucketNext = item.bucketNext;
+    } else {
+        bucketHeads[bucketOf(item.cell)] = item.bucketNext;
+    }
+    if (item.bucketNext != None) slots[item.bucketNext].bucketPrev = item.bucketPrev;
+
+    if (item.expiresAt != Never) {
+        if (item.wheelPrev != None) {
+            slots[item.wheelPrev].wheelNext = item.wheelNext;
+        } else {
+            wheelHeads[item.expiresAt & wheelMask] = item.wheelNext;
+        }
+        if (item.wheelNext != None) slots[item.wheelNext].wheelPrev = item.wheelPrev;
+    }
+
+    slotOfCell[item.cell] = None;
+    item.cell = None;
+    item.bucketNext = freeHead;
+    freeHead = slot;
+    --count;
+}
+
+int FoodField::nearest(const sf::Vector2i& from, FoodHit* out, int k, int maxDistance) const {
+    k = std::min(k, MaxNearest);
+    if (k <= 0 || count == 0) {
+        return 0;
+    }
+
+    const int bx = std::clamp(from.x, 0, width - 1) >> BucketShift;
+    const int by = std::clamp(from.y, 0, height - 1) >> BucketShift;
+    const int maxRing = std::max(std::max(bx, bucketsX - 1 - bx), std::max(by, bucketsY - 1 - by));
+    int found = 0;
+
+    auto consider = [&](int bucketX, int bucketY) {
+        for (int slot = bucketHeads[bucketY * bucketsX + bucketX]; slot != None; slot = slots[slot].bucketNext) {
+            const Slot& item = slots[slot];
+            const int distance = std::abs(item.cell % width - from.x) + std::abs(item.cell / width - from.y);
+            if (distance > maxDistance || (found == k && distance >= out[k - 1].distance)) continue;
+
+            // Insertion into the sorted hit list; k is small
+            int i = found < k ? found++ : k - 1;
+            for (; i > 0 && out[i - 1].distance > distance; --i) {
+                out[i] = out[i - 1];
+            }
+            out[i] = {item.cell, distance, item.weight};
+        }
+    };
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // Every cell of ring r is at least (r - 1) * BucketSize + 1 cells away along one axis
+        const int ringFloor = ring == 0 ? 0 : (ring - 1) * BucketSize + 1;
+        if (ringFloor > maxDistance || (found == k && ringFloor >= out[k - 1].distance)) break;
+
+        const int top = by - ring;
+        const int bottom = by + ring;
+        for (int x = std::max(bx - ring, 0); x <= std::min(bx + ring, bucketsX - 1); ++x) {
+            if (top >= 0) consider(x, top);
+            if (ring > 0 && bottom < bucketsY) consider(x, bottom);
+        }
+        for (int y = std::max(top + 1, 0); y <= std::min(bottom - 1, bucketsY - 1); ++y) {
+            if (bx - ring >= 0 && ring > 0) consider(bx - ring, y);
+            if (bx + ring < bucketsX && ring > 0) consider(bx + ring, y);
+        }
+    }
+    return found;
+}
@@ -1,15 +1,33 @@
 #include "Game.hpp"
 #include "states/States.hpp"
-#include <random>
+#include "metrics/AllocationTracker.hpp"
+#include "metrics/Metrics.hpp"
+#include "render/TickSchedule.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <filesystem>
+#include <thread>
 
-Game::Game() 
+namespace {
+    // How often the simulation thread checks for input between ticks
+    constexpr std::chrono::milliseconds InputPollInterval{2};
+
+    // Fastest capped turbo multiplier; one step faster lifts the cap
+    constexpr int MaxSpeed = 256;
+}
+
+Game::Game(const GameOptions& options)
     : window(sf::VideoMode(GameConfig::GRID_WIDTH * GameConfig::CELL_SIZE, 
                           GameConfig::GRID_HEIGHT * GameConfig::CELL_SIZE), "Snake Game")
-    , gameController(font, &window) {
-    window.setFramerateLimit(GameConfig::FRAME_RATE);
-    
+    , gameController(font)
+    , renderer(font)
+    , speed(std::clamp(options.speed, 0, MaxSpeed))
+    , framePacer(options.pacing, MetricsRegistry::instance().histogram(
+          "snaike_frame_jitter_us", "How late display frames started, microseconds"))
+    , tickPacer(options.pacing, MetricsRegistry::instance().histogram(
+          "snaike_tick_jitter_us", "How late scheduled ticks ran, microseconds")) {
     // Get executable path and construct relative resource path
     std::filesystem::path exePath = std::filesystem::current_path() / "build" / "bin";
     std::filesystem::path fontPath = exePath / "resources" / "fonts" / "arial.ttf";
@@ -26,6 +44,30 @@ Game::Game()
         }
     }
     
+    gameController.setSpectateSource(options.spectateSource);
+    gameController.setAgent(options.agent);
+    gameController.setLevelPack(options.levels);
+    gameController.setRewindOnDeath(options.rewindOnDeath);
+    if (!options.trajectoryDir.empty()) {
+        gameController.setTrajectoryWriter(std::make_unique<TrajectoryWriter>(options.trajectoryDir, "live"));
+    }
+    if (!options.runLogPath.empty()) {
+        gameController.setRunLog(std::make_unique<RunLog>(options.runLogPath));
+    }
+    if (!options.sessionPath.empty()) {
+        // A fixed seed makes the key presses alone enough to replay the session
+        recording = std::make_unique<Session>();
+        recording->seed = randomSeed();
+        recording->agent = options.agent;
+        recording->levels = gameController.getLevelPack() ? gameController.getLevelPack()->getPath() : "";
+        recording->rewindOnDeath = options.rewindOnDeath;
+        recordingPath = options.sessionPath;
+        gameController.setGameSeed(recording->seed);
+    }
+    if (options.logEvents) {
+        // Recorded on the simulation thread, printed on the window thread
+        eventLog = std::make_unique<EventRecorder>(gameController.getStateMachine().getEvents());
+    }
     gameController.initializeGame();
 }
 
@@ -33,27 +75,206 @@ void Game::processEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
         if (event.type == sf::Event::Closed) {
-            gameController.quitGame();  // Call quitGame instead of directly closing window
+            running.store(false, std::memory_order_release);
             return;  // Exit the process events loop
         }
-        gameController.handleInput(event);
+        if (event.type == sf::Event::KeyPressed && handleSpeedKey(event.key.code)) {
+            continue;
+        }
+        // Stamp events as early as possible; input-to-move latency starts here
+        inputQueue.tryPush({event, std::chrono::steady_clock::now()});
+    }
+}
+
+bool Game::handleSpeedKey(sf::Keyboard::Key key) {
+    const int current = speed.load(std::memory_order_relaxed);
+    int next;
+    switch (key) {
+        case sf::Keyboard::PageUp: next = current == 0 || current >= MaxSpeed ? 0 : current * 2; break;
+        case sf::Keyboard::PageDown: next = current == 0 ? MaxSpeed : std::max(current / 2, 1); break;
+        case sf::Keyboard::Home: next = 1; break;
+        default: return false;
+    }
+    speed.store(next, std::memory_order_relaxed);
+    return true;
+}
+
+void Game::publishSnapshot() {
+    AllocationScope scope(AllocPhase::Snapshot);
+    FrameSnapshot& frame = frames.writeBuffer();
+    gameController.render(frame);
+
+    const int currentSpeed = speed.load(std::memory_order_relaxed);
+    if (currentSpeed != 1 && gameController.isInGame()) {
+        char readout[64];
+        if (currentSpeed == 0) {
+            std::snprintf(readout, sizeof(readout), "TURBO max  %.0f ticks/s", measuredTickRate);
+        } else {
+            std::snprintf(readout, sizeof(readout), "TURBO x%d  %.0f ticks/s", currentSpeed, measuredTickRate);
+        }
+        frame.addText(readout, 16, sf::Color::Cyan, sf::Vector2f(8.0f, GameConfig::WindowHeight() - 26.0f));
     }
+    frame.sequence = ++snapshotsPublished;
+    frames.publish();
 }
 
-void Game::update() {
-    gameController.update();
+void Game::printEvents() {
+    EventFrame frame;
+    while (eventLog->tryPop(frame)) {
+        for (std::uint32_t i = 0; i < frame.count; ++i) {
+            std::clog << "[tick " << frame.tick << "] " << frame.events[i] << '\n';
+        }
+        if (frame.overflowed) {
+            std::clog << "[tick " << frame.tick << "] " << frame.overflowed << " more events dropped\n";
+        }
+    }
+    std::clog.flush();
+}
+
+void Game::simulate() {
+    using Clock = std::chrono::steady_clock;
+    const auto tickPeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::seconds(1)) / GameConfig::TICK_RATE;
+    const auto framePeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::seconds(1)) / GameConfig::RENDER_RATE;
+
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    Counter& ticks = metrics.counter("snaike_ticks_total", "Simulation ticks run");
+    Histogram& tickDuration = metrics.histogram("snaike_tick_duration_us",
+                                                "Time spent in one simulation tick, microseconds");
+    Gauge& tickRate = metrics.gauge("snaike_tick_rate", "Simulation ticks per second over the last second");
+    Histogram& tickAllocations = metrics.histogram("snaike_tick_allocations",
+                                                   "Heap allocations per tick (allocation tracking builds only)");
+    std::uint64_t ticksRun = 0;
+
+    TickSchedule schedule;
+    auto lastPublish = Clock::time_point{};
+    bool changed = true;  // Publish the initial state right away
+    while (running.load(std::memory_order_acquire) && !gameController.isQuitRequested()) {
+        InputEvent input;
+        while (inputQueue.tryPop(input)) {
+            AllocationScope scope(AllocPhase::Input);
+            if (recording && input.event.type == sf::Event::KeyPressed) {
+                recording->record(ticksRun, input.event.key.code);
+            }
+            gameController.handleInput(input);
+            changed = true;
+        }
+
+        // Menus keep the normal rate; only running games are sped up
+        const int currentSpeed = speed.load(std::memory_order_relaxed);
+        const bool turbo = currentSpeed != 1 && gameController.isInGame();
+        const auto period = !turbo ? tickPeriod
+                          : currentSpeed == 0 ? Clock::duration::zero()
+                          : tickPeriod / currentSpeed;
+
+        const auto now = Clock::now();
+        if (schedule.due(now)) {
+            if (period > Clock::duration::zero()) {
+                tickPacer.record(now - schedule.next());
+            }
+            {
+                ScopedTimer<std::chrono::microseconds> timer(tickDuration);
+                AllocationScope scope(AllocPhase::Update);
+                gameController.update();
+                if (AllocationTracker::isEnabled()) {
+                    tickAllocations.record(scope.allocations());
+                }
+            }
+            ticks.add();
+            ++ticksRun;
+            changed = true;
+
+            // Turbo schedules may fall up to a frame behind, as oversleeping is a large share of their period
+            if (schedule.ticked(now, period, turbo ? framePeriod : Clock::duration::zero())) {
+                measuredTickRate = schedule.rate();
+                tickRate.set(measuredTickRate);
+            }
+        }
+
+        // In turbo, frames between display refreshes would never be seen
+        if (changed && (!turbo || now - lastPublish >= framePeriod)) {
+            publishSnapshot();
+            lastPublish = now;
+            changed = false;
+        }
+
+        // Poll for input with plain sleeps; the pacer takes over once the tick is near
+        const auto pollAt = Clock::now() + InputPollInterval;
+        if (pollAt + tickPacer.getMargin() >= schedule.next()) {
+            tickPacer.waitUntil(schedule.next());
+        } else {
+            std::this_thread::sleep_until(pollAt);
+        }
+    }
+    if (recording) {
+        recording->ticks = ticksRun;
+    }
 }
 
 void Game::render() {
+    static Histogram& frameTime = MetricsRegistry::instance().histogram(
+        "snaike_frame_time_us", "Time between displayed frames, microseconds");
+
+    AllocationScope scope(AllocPhase::Render);
+    frames.update();
     window.clear(sf::Color::Black);
-    gameController.render(window);
+    renderer.draw(window, frames.readBuffer());
     window.display();
+
+    const auto now = std::chrono::steady_clock::now();
+    if (lastDisplay != std::chrono::steady_clock::time_point{}) {
+        frameTime.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - lastDisplay).count()));
+    }
+    lastDisplay = now;
+
+    if (eventLog) {
+        printEvents();
+    }
 }
 
 void Game::run() {
+    using Clock = FramePacer::Clock;
+    const auto framePeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::seconds(1)) / GameConfig::RENDER_RATE;
+
+    running.store(true, std::memory_order_release);
+    std::thread simulation(&Game::simulate, this);
+
+    auto nextFrame = Clock::now();
     while (window.isOpen()) {
         processEvents();
-        update();
+        if (!running.load(std::memory_order_acquire) || gameController.isQuitRequested()) {
+            window.close();
+            break;
+        }
         render();
+
+        // A frame that overran its slot starts the schedule over instead of rushing to catch up
+        nextFrame += framePeriod;
+        const auto started = framePacer.waitUntil(nextFrame);
+        framePacer.record(started - nextFrame);
+        if (started - nextFrame > framePeriod) {
+            nextFrame = started;
+        }
     }
-}
\ No newline at end of file
+
+    running.store(false, std::memory_order_release);
+    simulation.join();
+
+    const std::string frameJitter = framePacer.summary();
+    const std::string tickJitter = tickPacer.summary();
+    if (!frameJitter.empty()) std::cout << "Frame jitter: " << frameJitter << std::endl;
+    if (!tickJitter.empty()) std::cout << "Tick jitter:  " << tickJitter << std::endl;
+
+    if (recording) {
+        try {
+            recording->save(recordingPath);
+            std::cout << "Recorded " << recording->events.size() << " keys over " << recording->ticks
+                      << " ticks to " << recordingPath << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+}
@@ -5,16 +5,15 @@
 #include "GameResources.hpp"
 
 void GameController::initializeGame() {
-    GameResources resources{font};  // Now only passing font since we removed config from GameResources
-    
+    const StateType initialState = spectateSource.empty() ? StateType::Menu : StateType::Spectator;
     stateMachine.replaceState(
-        StateFactory::createState(StateType::Menu, this, resources, &stateMachine)
+        StateFactory::createState(initialState, this, resources, &stateMachine)
     );
 }
 
-void GameController::handleInput(const sf::Event& event) {
+void GameController::handleInput(const InputEvent& input) {
     if (stateMachine.hasState()) {
-        stateMachine.getCurrentState()->handleInput(event);
+        stateMachine.getCurrentState()->handleTimedInput(input);
     }
 }
 
@@ -23,11 +22,19 @@ void GameController::update() {
     if (stateMachine.hasState()) {
         stateMachine.getCurrentState()->update();
     }
+    stateMachine.getEvents().publish(TickCompleted{++ticks});
+}
+
+bool GameController::isInGame() const {
+    if (!stateMachine.hasState()) return false;
+    const StateType type = stateMachine.getCurrentState()->getType();
+    return type == StateType::Playing || type == StateType::Arena;
 }
 
-void GameController::render(sf::RenderWindow& window) {
+void GameController::render(FrameSnapshot& frame) {
+    frame.clear(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT);
     if (stateMachine.hasState()) {
-        stateMachine.getCurrentState()->render(window);
+        stateMachine.getCurrentState()->render(frame);
     }
 }
 
@@ -35,7 +42,5 @@ void GameController::quitGame() {
     // Clear any states before closing
     stateMachine.clearStates();
     
-    if (window) {
-        window->close();
-    }
+    quitRequested.store(true, std::memory_order_release);
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "GameSession.hpp"
+#include "Bitboard.hpp"
+#include "metrics/Metrics.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+template <typename SnakeType>
+BasicGameSession<SnakeType>::BasicGameSession()
+    : BasicGameSession(randomSeed()) {}
+
+template <typename SnakeType>
+BasicGameSession<SnakeType>::BasicGameSession(std::uint64_t seed)
+    : snake(GameConfig::GRID_WIDTH / 2, GameConfig::GRID_HEIGHT / 2)
+    , rng(seed)
+    , score(0)
+    , tick(0)
+{
+    snake.reserve(GameConfig::GRID_WIDTH * GameConfig::GRID_HEIGHT);
+    spawnFood();
+}
+
+template <typename SnakeType>
+void BasicGameSession<SnakeType>::reset(std::uint64_t seed) {
+    snake.reset(level.isOpen() ? sf::Vector2i(GameConfig::GRID_WIDTH / 2, GameConfig::GRID_HEIGHT / 2)
+                               : level.spawn);
+    rng.seed(seed);
+    score = 0;
+    tick = 0;
+    spawnFood();
+}
+
+template <typename SnakeType>
+void BasicGameSession<SnakeType>::setLevel(const Level& newLevel) {
+    if (!newLevel.isOpen() &&
+        (newLevel.width != GameConfig::GRID_WIDTH || newLevel.height != GameConfig::GRID_HEIGHT)) {
+        throw std::runtime_error("Level is " + std::to_string(newLevel.width) + "x" +
+                                 std::to_string(newLevel.height) + ", the game board is " +
+                                 std::to_string(GameConfig::GRID_WIDTH) + "x" +
+                                 std::to_string(GameConfig::GRID_HEIGHT));
+    }
+    level = newLevel;
+}
+
+template <typename SnakeType>
+void BasicGameSession<SnakeType>::restore(const SnakeType& newSnake, const sf::Vector2i& newFood,
+                                          const GameRng& newRng, int newScore, std::uint64_t newTick) {
+    snake = newSnake;   // Copies into the reserved body storage
+    food = newFood;
+    rng = newRng;
+    score = newScore;
+    tick = newTick;
+}
+
+template <typename SnakeType>
+bool BasicGameSession<SnakeType>::spawnFood() {
+    static Counter& retries = MetricsRegistry::instance().counter(
+        "snaike_food_spawn_retries_total{mode=\"classic\"}",
+        "Food positions redrawn because the cell was occupied");
+
+    // With no free cell left, rejection sampling would never end
+    const std::size_t capacity = level.isOpen() ? static_cast<std::size_t>(ObservationSize) : level.freeCount;
+    if (snake.length() >= capacity) {
+        return false;
+    }
+
+    std::uint64_t draws = 0;
+    if (level.isOpen()) {
+        do {
+            food.x = static_cast<int>(rng.bounded(GameConfig::GRID_WIDTH));
+            food.y = static_cast<int>(rng.bounded(GameConfig::GRID_HEIGHT));
+            ++draws;
+        } while (snake.occupies(food));
+    } else {
+        do {
+            food = level.freeCell(rng.bounded(level.freeCount));
+            ++draws;
+        } while (snake.occupies(food));
+    }
+
+    if (draws > 1) {
+        retries.add(draws - 1);
+    }
+    return true;
+}
+
+template <typename SnakeType>
+StepOutcome BasicGameSession<SnakeType>::step() {
+    snake.move();
+    ++tick;
+
+    if (snake.checkCollision(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT) || isWall(snake.getHead())) {
+        return StepOutcome::Died;
+    }
+
+    if (snake.getHead().x == food.x && snake.getHead().y == food.y) {
+        snake.grow();
+        ++score;
+        return spawnFood() ? StepOutcome::Ate : StepOutcome::Filled;
+    }
+    return StepOutcome::Moved;
+}
+
+template <typename SnakeType>
+void BasicGameSession<SnakeType>::writeObservation(std::uint8_t* cells) const {
+    std::fill(cells, cells + ObservationSize, static_cast<std::uint8_t>(CellType::Empty));
+
+    // After a fatal step the head may be outside the grid, so bounds-check every segment
+    auto put = [cells](const sf::Vector2i& pos, CellType type) {
+        if (pos.x >= 0 && pos.x < GameConfig::GRID_WIDTH &&
+            pos.y >= 0 && pos.y < GameConfig::GRID_HEIGHT) {
+            cells[pos.y * GameConfig::GRID_WIDTH + pos.x] = static_cast<std::uint8_t>(type);
+        }
+    };
+
+    if (!level.isOpen()) {
+        for (int i = 0; i < static_cast<int>((ObservationSize + 63) / 64); ++i) {
+            for (std::uint64_t word = level.walls[i]; word != 0; word &= word - 1) {
+                cells[i * 64 + lowestBit(word)] = static_cast<std::uint8_t>(CellType::Wall);
+            }
+        }
+    }
+    snake.forEachSegment([&put](const sf::Vector2i& segment) { put(segment, CellType::Body); });
+    put(food, CellType::Food);
+    put(snake.getHead(), CellType::Head);
+}
+
+template class BasicGameSession<Snake>;
+template class BasicGameSession<CompactSnake>;
@@ -0,0 +1,311 @@
+#include "MosaicViewer.hpp"
+#include "GameConfig.hpp"
+#include "agents/ControllerRegistry.hpp"
+#include "metrics/AllocationTracker.hpp"
+#include "metrics/Metrics.hpp"
+#include "states/PlayingState.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    // Fastest capped turbo multiplier; one step faster lifts the cap
+    constexpr int MaxSpeed = 256;
+
+    // Ticks without food before a looping game is abandoned (as in tournaments)
+    constexpr std::uint64_t StarveTicks = 4 * GameSession::ObservationSize;
+
+    // How long a tile stays red after its game ends
+    constexpr std::chrono::milliseconds FlashTime{400};
+
+    const sf::Color TileColor(24, 24, 24);
+    const sf::Color LeaderColor(48, 48, 16);
+    const sf::Color FlashColor(96, 16, 16);
+
+    // Most of the desktop, but never smaller than the game's own window
+    sf::VideoMode mosaicVideoMode() {
+        const sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
+        return sf::VideoMode(std::max(desktop.width * 4 / 5, static_cast<unsigned>(GameConfig::WindowWidth())),
+                             std::max(desktop.height * 4 / 5, static_cast<unsigned>(GameConfig::WindowHeight())));
+    }
+}
+
+MosaicViewer::MosaicViewer(int numGames, const GameOptions& options)
+    : window(mosaicVideoMode(), "Snake Mosaic")
+    , renderer(font)
+    , agent(options.agent)
+    , levels(options.levels)
+    , speed(std::clamp(options.speed, 0, MaxSpeed))
+    , framePacer(options.pacing, MetricsRegistry::instance().histogram(
+          "snaike_frame_jitter_us", "How late display frames started, microseconds"))
+    , tickPacer(options.pacing, MetricsRegistry::instance().histogram(
+          "snaike_tick_jitter_us", "How late scheduled ticks ran, microseconds"))
+    , nextSeed(options.firstSeed) {
+    if (!font.loadFromFile("build/bin/resources/fonts/arial.ttf") &&
+        !font.loadFromFile("resources/fonts/arial.ttf")) {
+        throw std::runtime_error("Failed to load font from: resources/fonts/arial.ttf");
+    }
+
+    const auto count = static_cast<std::size_t>(std::max(numGames, 1));
+#ifdef SNAIKE_PLUGINS
+    if (ControllerRegistry::isPluginName(agent)) {
+        plugin = std::make_unique<AgentPlugin>(ControllerRegistry::pluginPath(agent), static_cast<std::uint32_t>(count));
+        observations.resize(count * GameSession::ObservationSize);
+        actions.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            observationSlots.push_back(observations.data() + i * GameSession::ObservationSize);
+        }
+    }
+#endif
+    tiles.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        tiles.push_back(Tile{GameSession(options.firstSeed), batched() ? nullptr : ControllerRegistry::create(agent),
+                             0, 0, Clock::time_point{}});
+        startGame(i);
+    }
+}
+
+void MosaicViewer::startGame(std::size_t index) {
+    Tile& tile = tiles[index];
+    tile.seed = nextSeed++;
+    tile.lastMeal = 0;
+    tile.session.setLevel(levels ? levels->levelForSeed(tile.seed) : Level());
+    tile.session.reset(tile.seed);
+    try {
+#ifdef SNAIKE_PLUGINS
+        if (plugin) {
+            plugin->reset(static_cast<std::uint32_t>(index), tile.seed);
+            return;
+        }
+#endif
+        tile.controller->reset(tile.seed);
+    } catch (const std::exception& e) {
+        std::cerr << agent << " seed " << tile.seed << ": " << e.what() << std::endl;
+    }
+}
+
+Direction MosaicViewer::decide(std::size_t index) {
+    Tile& tile = tiles[index];
+#ifdef SNAIKE_PLUGINS
+    if (plugin) {
+        return actionDirection(actions[index], tile.session.getSnake().getDirection());
+    }
+#endif
+    return tile.controller->decide(tile.session);
+}
+
+void MosaicViewer::tick() {
+    const auto now = Clock::now();
+    bool batchFailed = false;
+#ifdef SNAIKE_PLUGINS
+    if (plugin) {
+        // Every tile's move from one act_batch call, as in Tournament::playBatch
+        for (std::size_t i = 0; i < tiles.size(); ++i) {
+            tiles[i].session.writeObservation(observations.data() + i * GameSession::ObservationSize);
+        }
+        try {
+            plugin->actBatch(observationSlots.data(), actions.data());
+        } catch (const std::exception& e) {
+            std::cerr << agent << ": " << e.what() << std::endl;
+            batchFailed = true;   // Every game ends, as they would in a tournament batch
+        }
+    }
+#endif
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        Tile& tile = tiles[i];
+        GameSession& session = tile.session;
+        bool over = true;   // Unless the step below completes and the game goes on
+        try {
+            if (!batchFailed) {
+                session.setDirection(decide(i));
+                const StepOutcome outcome = session.step();
+                if (outcome == StepOutcome::Ate) {
+                    tile.lastMeal = session.getTick();
+                }
+                over = outcome == StepOutcome::Died || outcome == StepOutcome::Filled ||
+                       session.getTick() - tile.lastMeal >= StarveTicks;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << agent << " seed " << tile.seed << ": " << e.what() << std::endl;
+        }
+        if (!over) {
+            continue;
+        }
+
+        ++gamesFinished;
+        scoreTotal += static_cast<std::uint64_t>(session.getScore());
+        if (session.getScore() > bestScore) {
+            bestScore = session.getScore();
+            bestSeed = tile.seed;
+        }
+        tile.endedAt = now;
+        startGame(i);
+    }
+}
+
+void MosaicViewer::publishSnapshot(double tickRate) {
+    AllocationScope scope(AllocPhase::Snapshot);
+    MosaicSnapshot& mosaic = frames.writeBuffer();
+    mosaic.clear(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT);
+
+    std::size_t leader = 0;
+    for (std::size_t i = 1; i < tiles.size(); ++i) {
+        if (tiles[i].session.getScore() > tiles[leader].session.getScore()) {
+            leader = i;
+        }
+    }
+
+    const auto now = Clock::now();
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const Tile& tile = tiles[i];
+        PlayingState::describeSession(tile.session, mosaic.frame);
+        mosaic.endTile(now - tile.endedAt < FlashTime ? FlashColor
+                       : i == leader && tile.session.getScore() > 0 ? LeaderColor
+                       : TileColor);
+    }
+
+    char header[160];
+    char rate[16];
+    const int currentSpeed = speed.load(std::memory_order_relaxed);
+    if (currentSpeed == 0) {
+        std::snprintf(rate, sizeof(rate), "max");
+    } else {
+        std::snprintf(rate, sizeof(rate), "x%d", currentSpeed);
+    }
+    if (gamesFinished > 0) {
+        std::snprintf(header, sizeof(header),
+                      "%zu x %s   %s %.0f ticks/s   %llu games   mean %.1f   best %d (seed %llu)",
+                      tiles.size(), agent.c_str(), rate, tickRate,
+                      static_cast<unsigned long long>(gamesFinished),
+                      static_cast<double>(scoreTotal) / static_cast<double>(gamesFinished),
+                      bestScore, static_cast<unsigned long long>(bestSeed));
+    } else {
+        std::snprintf(header, sizeof(header), "%zu x %s   %s %.0f ticks/s",
+                      tiles.size(), agent.c_str(), rate, tickRate);
+    }
+    mosaic.frame.addText(header, 16, sf::Color::White, sf::Vector2f(8.0f, 5.0f));
+
+    mosaic.frame.sequence = ++snapshotsPublished;
+    frames.publish();
+}
+
+bool MosaicViewer::handleSpeedKey(sf::Keyboard::Key key) {
+    const int current = speed.load(std::memory_order_relaxed);
+    int next;
+    switch (key) {
+        case sf::Keyboard::PageUp: next = current == 0 || current >= MaxSpeed ? 0 : current * 2; break;
+        case sf::Keyboard::PageDown: next = current == 0 ? MaxSpeed : std::max(current / 2, 1); break;
+        case sf::Keyboard::Home: next = 1; break;
+        default: return false;
+    }
+    speed.store(next, std::memory_order_relaxed);
+    return true;
+}
+
+void MosaicViewer::processEvents() {
+    sf::Event event;
+    while (window.pollEvent(event)) {
+        if (event.type == sf::Event::Closed ||
+            (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)) {
+            running.store(false, std::memory_order_release);
+            return;
+        }
+        if (event.type == sf::Event::Resized) {
+            // Keep one unit per pixel so the renderer can lay tiles out for the new size
+            window.setView(sf::View(sf::FloatRect{0.0f, 0.0f, static_cast<float>(event.size.width),
+                                                  static_cast<float>(event.size.height)}));
+        } else if (event.type == sf::Event::KeyPressed) {
+            handleSpeedKey(event.key.code);
+        }
+    }
+}
+
+void MosaicViewer::simulate() {
+    const auto tickPeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::seconds(1)) / GameConfig::TICK_RATE;
+    const auto framePeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::seconds(1)) / GameConfig::RENDER_RATE;
+
+    Histogram& tickDuration = MetricsRegistry::instance().histogram(
+        "snaike_mosaic_tick_duration_us", "Time to step every mosaic game once, microseconds");
+    TickSchedule schedule;
+    auto lastPublish = Clock::time_point{};
+    bool changed = true;  // Publish the first positions right away
+    while (running.load(std::memory_order_acquire)) {
+        const int currentSpeed = speed.load(std::memory_order_relaxed);
+        const auto period = currentSpeed == 0 ? Clock::duration::zero() : tickPeriod / currentSpeed;
+
+        const auto now = Clock::now();
+        if (schedule.due(now)) {
+            if (period > Clock::duration::zero()) {
+                tickPacer.record(now - schedule.next());
+            }
+            {
+                ScopedTimer<std::chrono::microseconds> timer(tickDuration);
+                tick();
+            }
+            changed = true;
+            // Sped-up schedules may fall a frame behind, as in Game::simulate
+            schedule.ticked(now, period, currentSpeed != 1 ? framePeriod : Clock::duration::zero());
+        }
+
+        // Describing hundreds of boards costs far more than a tick; never do it more often than frames are shown
+        if (changed && now - lastPublish >= framePeriod) {
+            publishSnapshot(schedule.rate());
+            lastPublish = now;
+            changed = false;
+        }
+
+        if (period > Clock::duration::zero()) {
+            tickPacer.waitUntil(schedule.next());
+        }
+    }
+}
+
+void MosaicViewer::render() {
+    AllocationScope scope(AllocPhase::Render);
+    frames.update();
+    window.clear(sf::Color::Black);
+    renderer.draw(window, frames.readBuffer());
+    window.display();
+}
+
+void MosaicViewer::run() {
+    const auto framePeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::seconds(1)) / GameConfig::RENDER_RATE;
+
+    running.store(true, std::memory_order_release);
+    std::thread simulation(&MosaicViewer::simulate, this);
+
+    auto nextFrame = Clock::now();
+    while (window.isOpen()) {
+        processEvents();
+        if (!running.load(std::memory_order_acquire)) {
+            window.close();
+            break;
+        }
+        render();
+
+        nextFrame += framePeriod;
+        const auto started = framePacer.waitUntil(nextFrame);
+        framePacer.record(started - nextFrame);
+        if (started - nextFrame > framePeriod) {
+            nextFrame = started;
+        }
+    }
+
+    running.store(false, std::memory_order_release);
+    simulation.join();
+
+    if (gamesFinished > 0) {
+        std::cout << gamesFinished << " games, mean score "
+                  << static_cast<double>(scoreTotal) / static_cast<double>(gamesFinished)
+                  << ", best " << bestScore << " (seed " << bestSeed << ")" << std::endl;
+    }
+    const std::string frameJitter = framePacer.summary();
+    const std::string tickJitter = tickPacer.summary();
+    if (!frameJitter.empty()) std::cout << "Frame jitter: " << frameJitter << std::endl;
+    if (!tickJitter.empty()) std::cout << "Tick jitter:  " << tickJitter << std::endl;
+}
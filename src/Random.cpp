@@ -0,0 +1,7 @@
+#include "Random.hpp"
+#include <random>
+
+std::uint64_t randomSeed() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32) | device();
+}
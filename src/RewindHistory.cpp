@@ -0,0 +1,179 @@
+#include "RewindHistory.hpp"
+#include <algorithm>
+
+namespace {
+    constexpr int Width = GameConfig::GRID_WIDTH;
+    constexpr std::size_t Cells = GameSession::ObservationSize;
+
+    std::uint16_t cellOf(const sf::Vector2i& pos) {
+        return static_cast<std::uint16_t>(pos.y * Width + pos.x);
+    }
+
+    sf::Vector2i positionOf(std::uint16_t cell) {
+        return sf::Vector2i(cell % Width, cell / Width);
+    }
+
+    Direction directionBetween(const sf::Vector2i& from, const sf::Vector2i& to) {
+        if (to.x > from.x) return Direction::Right;
+        if (to.x < from.x) return Direction::Left;
+        return to.y > from.y ? Direction::Down : Direction::Up;
+    }
+
+    Direction directionBefore(const RewindDelta& delta) { return static_cast<Direction>(delta.directions & 3u); }
+    Direction directionAfter(const RewindDelta& delta) { return static_cast<Direction>(delta.directions >> 2); }
+}
+
+RewindHistory::RewindHistory(std::size_t ticks, std::size_t interval)
+    : keyframeInterval(std::max<std::size_t>(interval, 1))
+    , linkWords((2 * Cells + 63) / 64)
+    , segments(Cells) {
+    const std::size_t keyframeCount = std::max<std::size_t>((ticks + keyframeInterval - 1) / keyframeInterval, 1);
+    capacity = keyframeCount * keyframeInterval;
+    deltas.resize(capacity);
+    keyframes.resize(keyframeCount);
+    links.resize(keyframeCount * linkWords);
+    view.reserve(Cells);
+}
+
+void RewindHistory::reset(const GameSession& session) {
+    firstTick = session.getTick();
+    oldest = firstTick;
+    newest = firstTick;
+    writeKeyframe(session);
+    seek(newest);
+}
+
+void RewindHistory::writeKeyframe(const GameSession& session) {
+    const std::uint64_t tick = session.getTick();
+    const std::uint64_t index = (tick - firstTick) / keyframeInterval;
+    Keyframe& keyframe = keyframes[index % keyframes.size()];
+    const Snake& snake = session.getSnake();
+    const auto& body = snake.getBody();
+
+    keyframe.tick = tick;
+    keyframe.rng = session.getRng();
+    keyframe.score = session.getScore();
+    keyframe.head = cellOf(snake.getHead());
+    keyframe.food = cellOf(session.getFood());
+    keyframe.length = static_cast<std::uint16_t>(body.size());
+    keyframe.direction = snake.getDirection();
+    keyframe.growing = snake.isGrowing();
+
+    // Link i points from segment i to segment i + 1, head to tail
+    std::uint64_t* words = &links[(index % keyframes.size()) * linkWords];
+    std::fill(words, words + linkWords, 0);
+    for (std::size_t i = 0; i + 1 < body.size(); ++i) {
+        const auto link = static_cast<std::uint64_t>(directionBetween(body[i], body[i + 1]));
+        words[i >> 5] |= link << ((i & 31) * 2);
+    }
+
+    // The ring just dropped the keyframe one full turn older
+    const std::uint64_t span = (keyframes.size() - 1) * keyframeInterval;
+    if (tick - firstTick >= span) {
+        oldest = std::max(oldest, tick - span);
+    }
+}
+
+const RewindHistory::Keyframe& RewindHistory::keyframeFor(std::uint64_t tick) const {
+    return keyframes[((tick - firstTick) / keyframeInterval) % keyframes.size()];
+}
+
+void RewindHistory::loadKeyframe(const Keyframe& keyframe) {
+    const std::size_t slot = static_cast<std::size_t>(&keyframe - keyframes.data());
+    const std::uint64_t* words = &links[slot * linkWords];
+    segments[0] = positionOf(keyframe.head);
+    for (std::size_t i = 1; i < keyframe.length; ++i) {
+        const auto link = static_cast<Direction>((words[(i - 1) >> 5] >> (((i - 1) & 31) * 2)) & 3u);
+        segments[i] = segments[i - 1] + directionOffset(link);
+    }
+    view.restore(segments.data(), keyframe.length, keyframe.direction, keyframe.growing);
+    viewFood = positionOf(keyframe.food);
+    viewScore = keyframe.score;
+    cursor = keyframe.tick;
+}
+
+void RewindHistory::beginTick(const GameSession& session) {
+    const Snake& snake = session.getSnake();
+    pending.tail = cellOf(snake.getTail());
+    pending.directions = static_cast<std::uint8_t>(snake.getDirection());
+    pending.flags = snake.isGrowing() ? WasGrowing : 0;
+    pendingScore = session.getScore();
+}
+
+void RewindHistory::endTick(const GameSession& session) {
+    const std::uint64_t tick = session.getTick();
+    if (tick != newest + 1) {
+        // Ticks were skipped (or the game restarted): nothing older can be replayed
+        reset(session);
+        return;
+    }
+
+    RewindDelta& delta = deltas[tick % capacity];
+    delta = pending;
+    delta.food = cellOf(session.getFood());
+    delta.directions |= static_cast<std::uint8_t>(static_cast<unsigned>(session.getSnake().getDirection()) << 2);
+    if (session.getScore() != pendingScore) delta.flags |= Ate;
+    newest = tick;
+
+    if ((tick - firstTick) % keyframeInterval == 0) {
+        writeKeyframe(session);
+    }
+}
+
+bool RewindHistory::stepBack() {
+    if (cursor <= oldest) return false;
+
+    const RewindDelta& delta = deltas[cursor % capacity];
+    if (delta.flags & Ate) {
+        // The food was where the head moved to
+        viewFood = view.getHead();
+        --viewScore;
+    }
+    view.unmove(positionOf(delta.tail), directionBefore(delta), (delta.flags & WasGrowing) != 0);
+    --cursor;
+    return true;
+}
+
+bool RewindHistory::stepForward() {
+    if (cursor >= newest) return false;
+
+    ++cursor;
+    const RewindDelta& delta = deltas[cursor % capacity];
+    view.setDirection(directionAfter(delta));
+    view.move();
+    if (delta.flags & Ate) {
+        view.grow();
+        ++viewScore;
+    }
+    viewFood = positionOf(delta.food);
+    return true;
+}
+
+void RewindHistory::seek(std::uint64_t tick) {
+    tick = std::clamp(tick, oldest, newest);
+    const std::uint64_t keyframeTick = keyframeFor(tick).tick;
+
+    // Start from the keyframe unless the view is already closer
+    const bool fromView = cursor >= oldest && cursor <= newest &&
+                          (cursor > tick ? cursor - tick : tick - cursor) < tick - keyframeTick;
+    if (!fromView) {
+        loadKeyframe(keyframeFor(tick));
+    }
+    while (cursor > tick) stepBack();
+    while (cursor < tick) stepForward();
+}
+
+void RewindHistory::resume(GameSession& session) {
+    const std::uint64_t target = cursor;
+    const Keyframe& keyframe = keyframeFor(target);
+    loadKeyframe(keyframe);
+    session.restore(view, viewFood, keyframe.rng, keyframe.score, keyframe.tick);
+
+    // Replaying through the session brings the generator state along
+    for (std::uint64_t tick = keyframe.tick + 1; tick <= target; ++tick) {
+        session.setDirection(directionAfter(deltas[tick % capacity]));
+        session.step();
+    }
+    newest = target;
+    seek(target);
+}
@@ -1,27 +1,25 @@
 #include "Snake.hpp"
 
-Snake::Snake() : direction(Direction::Right), hasEaten(false) {
-    body.push_front(sf::Vector2i(5, 5));
-    body.push_front(sf::Vector2i(6, 5));
-    body.push_front(sf::Vector2i(7, 5));
+Snake::Snake() : Snake(7, 5) {
 }
 
 Snake::Snake(int x, int y) 
-    : direction(Direction::Right)
-    , hasEaten(false) {
-    // Initialize with 3 segments
-    body.push_front(sf::Vector2i(x-2, y));
-    body.push_front(sf::Vector2i(x-1, y));
-    body.push_front(sf::Vector2i(x, y));
+    : Snake(sf::Vector2i(x, y)) {
+}
+
+Snake::Snake(const sf::Vector2i& startPos) {
+    reset(startPos);
 }
 
-Snake::Snake(const sf::Vector2i& startPos)
-    : direction(Direction::Right)
-    , hasEaten(false) {
+void Snake::reset(const sf::Vector2i& head) {
+    direction = Direction::Right;
+    hasEaten = false;
+
     // Initialize with 3 segments
-    body.push_front(sf::Vector2i(startPos.x-2, startPos.y));
-    body.push_front(sf::Vector2i(startPos.x-1, startPos.y));
-    body.push_front(sf::Vector2i(startPos.x, startPos.y));
+    body.clear();
+    body.push_front(sf::Vector2i(head.x-2, head.y));
+    body.push_front(sf::Vector2i(head.x-1, head.y));
+    body.push_front(sf::Vector2i(head.x, head.y));
 }
 
 void Snake::setDirection(Direction newDir) {
@@ -34,17 +32,8 @@ void Snake::setDirection(Direction newDir) {
 }
 
 void Snake::move() {
-    // Create new head position based on current direction
-    sf::Vector2i newHead = body.front();
-    switch (direction) {
-        case Direction::Up:    newHead.y--; break;
-        case Direction::Down:  newHead.y++; break;
-        case Direction::Left:  newHead.x--; break;
-        case Direction::Right: newHead.x++; break;
-    }
-    
-    // Add new head
-    body.push_front(newHead);
+    // Add new head one step in the current direction
+    body.push_front(nextHead());
     
     // Only remove tail if we haven't eaten
     if (!hasEaten) {
@@ -54,6 +43,24 @@ void Snake::move() {
     }
 }
 
+void Snake::unmove(const sf::Vector2i& vacatedTail, Direction previousDirection, bool wasGrowing) {
+    body.pop_front();
+    if (!wasGrowing) {
+        body.push_back(vacatedTail);
+    }
+    direction = previousDirection;
+    hasEaten = wasGrowing;
+}
+
+void Snake::restore(const sf::Vector2i* segments, std::size_t count, Direction dir, bool growing) {
+    body.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        body.push_back(segments[i]);
+    }
+    direction = dir;
+    hasEaten = growing;
+}
+
 bool Snake::checkCollision(const int gridWidth, const int gridHeight) {
     sf::Vector2i head = body.front();
     
@@ -1,4 +1,13 @@
 #include "StateMachine.hpp"
+#include "metrics/Metrics.hpp"
+
+namespace {
+    Counter& transitions(const char* op) {
+        return MetricsRegistry::instance().counter(
+            std::string("snaike_state_transitions_total{op=\"") + op + "\"}",
+            "State machine transitions applied");
+    }
+}
 
 void StateMachine::pushState(std::unique_ptr<State> state) {
     isAdding = true;
@@ -17,17 +26,31 @@ void StateMachine::replaceState(std::unique_ptr<State> state) {
 }
 
 void StateMachine::processStateChanges() {
+    static Counter& pops = transitions("pop");
+    static Counter& pushes = transitions("push");
+    static Counter& replaces = transitions("replace");
+
     if (isRemoving && !states.empty()) {
+        pops.add();
+        const StateType removed = states.top()->getType();
         states.pop();
         if (!states.empty()) {
             states.top()->resume();  // Resume the previous state
         }
         isRemoving = false;
+        events.publish(StatePopped{removed, static_cast<std::uint32_t>(states.size())});
     }
 
     if (isAdding) {
-        if (!states.empty() && isReplacing) {
+        const bool replacing = !states.empty() && isReplacing;
+        const StateType added = pendingState->getType();
+        StateType removed = added;
+        if (replacing) {
+            removed = states.top()->getType();
             states.pop();
+            replaces.add();
+        } else {
+            pushes.add();
         }
 
         if (!states.empty()) {
@@ -36,6 +59,13 @@ void StateMachine::processStateChanges() {
 
         states.push(std::move(pendingState));
         isAdding = false;
+
+        const auto depth = static_cast<std::uint32_t>(states.size());
+        if (replacing) {
+            events.publish(StateReplaced{removed, added, depth});
+        } else {
+            events.publish(StatePushed{added, depth});
+        }
     }
 }
 
@@ -55,4 +85,21 @@ void StateMachine::clearStates() {
     isRemoving = false;
     isAdding = false;
     isReplacing = false;
+    preloads.clear();
+}
+
+void StateMachine::addPreload(StateType type, std::future<std::unique_ptr<State>> state) {
+    preloads.emplace(type, std::move(state));
+}
+
+std::unique_ptr<State> StateMachine::takePreload(StateType type) {
+    std::future<std::unique_ptr<State>> state;
+    auto it = preloads.find(type);
+    if (it != preloads.end()) {
+        state = std::move(it->second);
+    }
+    // The rest were built for exits of the state being left; keeping them would let
+    // a later transition pick up a stale game (and the seed drawn for it)
+    preloads.clear();
+    return state.valid() ? state.get() : nullptr;
 }
\ No newline at end of file
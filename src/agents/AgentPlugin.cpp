@@ -0,0 +1,71 @@
+#include "agents/AgentPlugin.hpp"
+#include "GameConfig.hpp"
+#include <dlfcn.h>
+#include <stdexcept>
+
+namespace {
+    template <typename Fn>
+    Fn resolve(void* library, const char* symbol, const std::string& path) {
+        void* address = dlsym(library, symbol);
+        if (!address) {
+            throw std::runtime_error(path + " does not export " + symbol);
+        }
+        return reinterpret_cast<Fn>(address);
+    }
+}
+
+AgentPlugin::AgentPlugin(const std::string& libraryPath, std::uint32_t maxBatch)
+    : slots(maxBatch)
+    , path(libraryPath) {
+    library = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!library) {
+        const char* error = dlerror();
+        throw std::runtime_error("Cannot load agent plugin " + libraryPath + ": " + (error ? error : "unknown error"));
+    }
+
+    try {
+        const auto initFn = resolve<SnaikeAgentInitFn>(library, SNAIKE_AGENT_INIT_SYMBOL, path);
+        resetFn = resolve<SnaikeAgentResetFn>(library, SNAIKE_AGENT_RESET_SYMBOL, path);
+        actBatchFn = resolve<SnaikeAgentActBatchFn>(library, SNAIKE_AGENT_ACT_BATCH_SYMBOL, path);
+        shutdownFn = resolve<SnaikeAgentShutdownFn>(library, SNAIKE_AGENT_SHUTDOWN_SYMBOL, path);
+
+        SnaikeAgentConfig config;
+        config.abi_version = SNAIKE_AGENT_ABI_VERSION;
+        config.grid_width = GameConfig::GRID_WIDTH;
+        config.grid_height = GameConfig::GRID_HEIGHT;
+        config.observation_size = GameSession::ObservationSize;
+        config.max_batch = slots;
+        agent = initFn(&config);
+        if (!agent) {
+            throw std::runtime_error("Agent plugin " + path + " refused to initialise");
+        }
+    } catch (...) {
+        dlclose(library);
+        throw;
+    }
+}
+
+AgentPlugin::~AgentPlugin() {
+    shutdownFn(agent);
+    dlclose(library);
+}
+
+void AgentPlugin::actBatch(const std::uint8_t* const* observations, std::uint8_t* actions) {
+    const int status = actBatchFn(agent, observations, slots, actions);
+    if (status != 0) {
+        throw std::runtime_error("Agent plugin " + path + " failed with status " + std::to_string(status));
+    }
+}
+
+PluginController::PluginController(const std::string& libraryPath)
+    : plugin(libraryPath, 1)
+    , observation(GameSession::ObservationSize) {
+}
+
+Direction PluginController::decide(const GameSession& session) {
+    session.writeObservation(observation.data());
+    const std::uint8_t* observations[1] = {observation.data()};
+    std::uint8_t action;
+    plugin.actBatch(observations, &action);
+    return actionDirection(action, session.getSnake().getDirection());
+}
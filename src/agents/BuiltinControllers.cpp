@@ -0,0 +1,110 @@
+#include "agents/BuiltinControllers.hpp"
+#include <cstdlib>
+
+namespace {
+    const Direction allDirections[4] = {Direction::Up, Direction::Down, Direction::Left, Direction::Right};
+
+    bool isReverse(Direction a, Direction b) {
+        return (a == Direction::Up && b == Direction::Down) || (a == Direction::Down && b == Direction::Up) ||
+               (a == Direction::Left && b == Direction::Right) || (a == Direction::Right && b == Direction::Left);
+    }
+}
+
+bool isFatalMove(const GameSession& session, Direction dir) {
+    const Snake& snake = session.getSnake();
+    const sf::Vector2i target = snake.getHead() + directionOffset(dir);
+    if (target.x < 0 || target.x >= GameConfig::GRID_WIDTH ||
+        target.y < 0 || target.y >= GameConfig::GRID_HEIGHT || session.isWall(target)) {
+        return true;
+    }
+
+    // The tail moves away this tick unless the snake is growing
+    const auto& body = snake.getBody();
+    const std::size_t checked = snake.isGrowing() ? body.size() : body.size() - 1;
+    for (std::size_t i = 0; i < checked; ++i) {
+        if (body[i] == target) return true;
+    }
+    return false;
+}
+
+Direction RandomController::decide(const GameSession& session) {
+    const Direction current = session.getSnake().getDirection();
+    Direction safe[3];
+    int numSafe = 0;
+    for (Direction dir : allDirections) {
+        if (!isReverse(current, dir) && !isFatalMove(session, dir)) {
+            safe[numSafe++] = dir;
+        }
+    }
+    if (numSafe == 0) return current;
+    return safe[rng.bounded(static_cast<std::uint32_t>(numSafe))];
+}
+
+Direction GreedyController::decide(const GameSession& session) {
+    const Snake& snake = session.getSnake();
+    const Direction current = snake.getDirection();
+    const sf::Vector2i& food = session.getFood();
+
+    Direction best = current;
+    int bestDistance = -1;
+    for (Direction dir : allDirections) {
+        if (isReverse(current, dir) || isFatalMove(session, dir)) continue;
+        const sf::Vector2i target = snake.getHead() + directionOffset(dir);
+        const int distance = std::abs(target.x - food.x) + std::abs(target.y - food.y);
+        if (bestDistance < 0 || distance < bestDistance || (distance == bestDistance && dir == current)) {
+            best = dir;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+FloodFillController::FloodFillController()
+    : grid(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT)
+    , freeCells(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT)
+    , distances(GameConfig::GRID_WIDTH * GameConfig::GRID_HEIGHT, BitboardGrid::Unreachable) {}
+
+Direction FloodFillController::decide(const GameSession& session) {
+    const Snake& snake = session.getSnake();
+    const Direction current = snake.getDirection();
+    auto cellOf = [](const sf::Vector2i& pos) { return pos.y * GameConfig::GRID_WIDTH + pos.x; };
+
+    // The tail moves away this tick unless the snake is growing
+    freeCells.fill();
+    if (!session.getLevel().isOpen()) {
+        freeCells.andNot(session.getLevel().walls);
+    }
+    const auto& body = snake.getBody();
+    const std::size_t blocked = snake.isGrowing() ? body.size() : body.size() - 1;
+    for (std::size_t i = 0; i < blocked; ++i) {
+        freeCells.reset(cellOf(body[i]));
+    }
+    grid.distanceMap(cellOf(session.getFood()), freeCells, distances);
+
+    const int room = static_cast<int>(snake.length());
+    Direction best = current;
+    int bestDistance = BitboardGrid::Unreachable + 1;
+    Direction roomiest = current;
+    int roomiestArea = -1;
+    for (Direction dir : allDirections) {
+        if (isReverse(current, dir)) continue;
+        const sf::Vector2i target = snake.getHead() + directionOffset(dir);
+        if (target.x < 0 || target.x >= GameConfig::GRID_WIDTH ||
+            target.y < 0 || target.y >= GameConfig::GRID_HEIGHT || !freeCells.test(cellOf(target))) {
+            continue;
+        }
+
+        const int area = grid.reachableArea(cellOf(target), freeCells, room);
+        if (area >= room) {
+            const int distance = distances[cellOf(target)];
+            if (distance < bestDistance || (distance == bestDistance && dir == current)) {
+                best = dir;
+                bestDistance = distance;
+            }
+        } else if (area > roomiestArea) {
+            roomiest = dir;
+            roomiestArea = area;
+        }
+    }
+    return bestDistance <= BitboardGrid::Unreachable ? best : roomiest;
+}
@@ -0,0 +1,76 @@
+#include "agents/ControllerRegistry.hpp"
+#include "agents/BuiltinControllers.hpp"
+#ifdef SNAIKE_PLUGINS
+#include "agents/AgentPlugin.hpp"
+#endif
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::pair<std::string, ControllerRegistry::Factory>> entries;
+
+        Registry() {
+            entries.emplace_back("random", [] { return std::make_unique<RandomController>(); });
+            entries.emplace_back("greedy", [] { return std::make_unique<GreedyController>(); });
+            entries.emplace_back("flood", [] { return std::make_unique<FloodFillController>(); });
+        }
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+}
+
+void ControllerRegistry::add(const std::string& name, Factory factory) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& entry : reg.entries) {
+        if (entry.first == name) {
+            entry.second = std::move(factory);
+            return;
+        }
+    }
+    reg.entries.emplace_back(name, std::move(factory));
+}
+
+std::unique_ptr<Controller> ControllerRegistry::create(const std::string& name) {
+    if (isPluginName(name)) {
+#ifdef SNAIKE_PLUGINS
+        return std::make_unique<PluginController>(pluginPath(name));
+#else
+        throw std::runtime_error("Agent plugins are not supported on this platform: " + name);
+#endif
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& entry : reg.entries) {
+        if (entry.first == name) {
+            return entry.second();
+        }
+    }
+    throw std::runtime_error("Unknown controller: " + name);
+}
+
+std::vector<std::string> ControllerRegistry::names() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<std::string> result;
+    for (const auto& entry : reg.entries) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+bool ControllerRegistry::isPluginName(const std::string& name) {
+    return name.compare(0, std::strlen(PluginPrefix), PluginPrefix) == 0;
+}
+
+std::string ControllerRegistry::pluginPath(const std::string& name) {
+    return name.substr(std::strlen(PluginPrefix));
+}
@@ -0,0 +1,101 @@
+#include "env/EnvClient.hpp"
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    constexpr long ServerPollNs = 100000000L;   // Check on the server every 100 ms while waiting
+}
+
+EnvClient::EnvClient(const std::string& shmName, int timeoutMs)
+    : header(nullptr)
+    , mappedBytes(0)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    // The server may still be starting up; retry until the segment exists and is sized
+    int fd = -1;
+    struct stat info{};
+    for (;;) {
+        fd = shm_open(shmName.c_str(), O_RDWR, 0);
+        if (fd >= 0 && fstat(fd, &info) == 0 &&
+            static_cast<std::size_t>(info.st_size) >= sizeof(SharedEnvHeader)) {
+            break;
+        }
+        if (fd >= 0) close(fd);
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("Environment server not found: " + shmName);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    mappedBytes = static_cast<std::size_t>(info.st_size);
+    void* mem = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        throw std::runtime_error("Failed to map shared memory: " + shmName);
+    }
+    header = static_cast<SharedEnvHeader*>(mem);
+
+    while (header->ready.load(std::memory_order_acquire) == 0) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            munmap(header, mappedBytes);
+            throw std::runtime_error("Environment server did not become ready: " + shmName);
+        }
+        futexWait(&header->ready, 0, 10000000L);
+    }
+
+    if (header->magic != SharedEnvMagic || header->version != SharedEnvVersion ||
+        sharedEnvBytes(header->numEnvs, header->observationSize) > mappedBytes) {
+        munmap(header, mappedBytes);
+        throw std::runtime_error("Incompatible environment server: " + shmName);
+    }
+}
+
+EnvClient::~EnvClient() {
+    if (header) {
+        munmap(header, mappedBytes);
+    }
+}
+
+bool EnvClient::serverAlive() const {
+    if (header->ready.load(std::memory_order_acquire) == 0) {
+        return false;   // Cleared by a server shutting down cleanly
+    }
+    return kill(static_cast<pid_t>(header->serverPid), 0) == 0 || errno == EPERM;
+}
+
+void EnvClient::send(std::uint32_t envIndex, std::uint32_t action) {
+    if (envIndex >= header->numEnvs) {
+        throw std::out_of_range("Environment index " + std::to_string(envIndex) + " out of range (" +
+                                std::to_string(header->numEnvs) + " games)");
+    }
+    const EnvAction msg{envIndex, action};
+    for (int polls = 0; !header->actions.tryPush(msg); ++polls) {
+        if (polls % 1024 == 1023 && !serverAlive()) {
+            throw std::runtime_error("Environment server stopped");
+        }
+        std::this_thread::yield();
+    }
+}
+
+EnvStepResult EnvClient::receive() {
+    EnvStepResult result;
+    while (!header->results.popWait(result, ServerPollNs)) {
+        if (!serverAlive()) {
+            throw std::runtime_error("Environment server stopped");
+        }
+    }
+    return result;
+}
+
+EnvStepResult EnvClient::step(std::uint32_t envIndex, std::uint32_t action) {
+    send(envIndex, action);
+    return receive();
+}
@@ -0,0 +1,126 @@
+#include "env/EnvServer.hpp"
+#include "spectator/SpectatorPublisher.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+    constexpr long StopPollNs = 100000000L;   // Wake every 100 ms to check stop()
+
+    std::uint32_t alignedObservationSize() {
+        return (static_cast<std::uint32_t>(GameSession::ObservationSize) + 63u) & ~63u;
+    }
+}
+
+EnvServer::EnvServer(const std::string& shmName, std::uint32_t numEnvs, std::uint64_t seed)
+    : name(shmName)
+    , header(nullptr)
+    , mappedBytes(sharedEnvBytes(numEnvs, alignedObservationSize()))
+    , masterSeed(seed)
+    , nextStream(numEnvs)
+    , spectator(nullptr)
+{
+    if (numEnvs == 0 || numEnvs > SharedEnvRingCapacity) {
+        throw std::runtime_error("Number of games must be between 1 and " +
+                                 std::to_string(SharedEnvRingCapacity));
+    }
+
+    // Start from a clean segment; a stale one from a crashed server would confuse clients
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create shared memory: " + name);
+    }
+    if (ftruncate(fd, static_cast<off_t>(mappedBytes)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Failed to size shared memory: " + name);
+    }
+    void* mem = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Failed to map shared memory: " + name);
+    }
+
+    header = new (mem) SharedEnvHeader();
+    header->numEnvs = numEnvs;
+    header->observationSize = alignedObservationSize();
+    header->gridWidth = GameConfig::GRID_WIDTH;
+    header->gridHeight = GameConfig::GRID_HEIGHT;
+    header->version = SharedEnvVersion;
+    header->serverPid = static_cast<std::int32_t>(getpid());
+
+    sessions.reserve(numEnvs);
+    for (std::uint32_t i = 0; i < numEnvs; ++i) {
+        sessions.emplace_back(deriveSeed(masterSeed, i));
+        sessions[i].writeObservation(sharedEnvObservation(header, i));
+    }
+
+    // Publish magic last so clients never see a half-initialized segment
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SharedEnvMagic;
+    header->ready.store(1, std::memory_order_release);
+    futexWake(&header->ready);
+}
+
+EnvServer::~EnvServer() {
+    if (header) {
+        header->ready.store(0, std::memory_order_release);
+        munmap(header, mappedBytes);
+        shm_unlink(name.c_str());
+    }
+}
+
+void EnvServer::run() {
+    EnvAction action;
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        if (header->actions.popWait(action, StopPollNs)) {
+            handleAction(action);
+        }
+    }
+}
+
+void EnvServer::publishResult(const EnvStepResult& result) {
+    // Only a client sending without receiving can fill the ring; stop() still gets through
+    while (!header->results.tryPush(result) && !stopRequested.load(std::memory_order_relaxed)) {
+    }
+}
+
+void EnvServer::handleAction(const EnvAction& action) {
+    if (action.envIndex >= sessions.size()) {
+        // Answer anyway, so a client waiting for this result does not wait forever
+        publishResult(EnvStepResult{action.envIndex, 0.0f, 0, 0, EnvStatusBadIndex, 0});
+        return;
+    }
+
+    CompactGameSession& session = sessions[action.envIndex];
+    EnvStepResult result{action.envIndex, 0.0f, 0, 0, EnvStatusOk, 0};
+
+    if (action.action == EnvActionReset) {
+        session.reset(deriveSeed(masterSeed, nextStream++));
+    } else {
+        session.setDirection(static_cast<Direction>(action.action & 3u));
+        switch (session.step()) {
+            case StepOutcome::Ate:  result.reward = 1.0f; break;
+            case StepOutcome::Died: result.reward = -1.0f; result.done = 1; break;
+            case StepOutcome::Filled: result.reward = 1.0f; result.done = 1; break;
+            case StepOutcome::Moved: break;
+        }
+    }
+    result.score = static_cast<std::uint32_t>(session.getScore());
+    result.tick = session.getTick();
+
+    if (result.done) {
+        session.reset(deriveSeed(masterSeed, nextStream++));
+    }
+    session.writeObservation(sharedEnvObservation(header, action.envIndex));
+    if (spectator && action.envIndex == 0) {
+        spectator->publish(session);
+    }
+
+    publishResult(result);
+}
@@ -0,0 +1,88 @@
+#include "events/EventRecorder.hpp"
+#include <ostream>
+
+EventRecorder::EventRecorder(EventBus& events)
+    : droppedFrames(MetricsRegistry::instance().counter(
+          "snaike_event_frames_dropped_total", "Event frames dropped because the consumer fell behind"))
+    , bus(events) {
+    // Each record is built in place; EventRecord has no constructors because of the union
+    subscriptions[0] = bus.subscribe<StatePushed>([this](const StatePushed& e) {
+        EventRecord r; r.kind = EventKind::StatePushed; r.statePushed = e; record(r);
+    });
+    subscriptions[1] = bus.subscribe<StatePopped>([this](const StatePopped& e) {
+        EventRecord r; r.kind = EventKind::StatePopped; r.statePopped = e; record(r);
+    });
+    subscriptions[2] = bus.subscribe<StateReplaced>([this](const StateReplaced& e) {
+        EventRecord r; r.kind = EventKind::StateReplaced; r.stateReplaced = e; record(r);
+    });
+    subscriptions[3] = bus.subscribe<FoodEaten>([this](const FoodEaten& e) {
+        EventRecord r; r.kind = EventKind::FoodEaten; r.foodEaten = e; record(r);
+    });
+    subscriptions[4] = bus.subscribe<PlayerDied>([this](const PlayerDied& e) {
+        EventRecord r; r.kind = EventKind::PlayerDied; r.playerDied = e; record(r);
+    });
+    subscriptions[5] = bus.subscribe<TickCompleted>([this](const TickCompleted& e) { closeFrame(e.tick); });
+}
+
+EventRecorder::~EventRecorder() {
+    bus.unsubscribe<StatePushed>(subscriptions[0]);
+    bus.unsubscribe<StatePopped>(subscriptions[1]);
+    bus.unsubscribe<StateReplaced>(subscriptions[2]);
+    bus.unsubscribe<FoodEaten>(subscriptions[3]);
+    bus.unsubscribe<PlayerDied>(subscriptions[4]);
+    bus.unsubscribe<TickCompleted>(subscriptions[5]);
+}
+
+void EventRecorder::record(const EventRecord& event) {
+    if (current.count < EventFrame::MaxEvents) {
+        current.events[current.count++] = event;
+    } else {
+        ++current.overflowed;
+    }
+}
+
+void EventRecorder::closeFrame(std::uint64_t tick) {
+    if (current.count == 0 && current.overflowed == 0) return;
+
+    current.tick = tick;
+    const std::uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == Capacity) {
+        droppedFrames.add();
+    } else {
+        slots[h & (Capacity - 1)] = current;
+        head.store(h + 1, std::memory_order_release);
+    }
+    current.count = 0;
+    current.overflowed = 0;
+}
+
+bool EventRecorder::tryPop(EventFrame& out) {
+    const std::uint32_t t = tail.load(std::memory_order_relaxed);
+    if (head.load(std::memory_order_acquire) == t) {
+        return false;
+    }
+    out = slots[t & (Capacity - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+std::ostream& operator<<(std::ostream& out, const EventRecord& event) {
+    switch (event.kind) {
+        case EventKind::StatePushed:
+            return out << "push " << stateTypeName(event.statePushed.state)
+                       << " (depth " << event.statePushed.depth << ")";
+        case EventKind::StatePopped:
+            return out << "pop " << stateTypeName(event.statePopped.state)
+                       << " (depth " << event.statePopped.depth << ")";
+        case EventKind::StateReplaced:
+            return out << "replace " << stateTypeName(event.stateReplaced.from) << " -> "
+                       << stateTypeName(event.stateReplaced.to) << " (depth " << event.stateReplaced.depth << ")";
+        case EventKind::FoodEaten:
+            return out << "food eaten at " << event.foodEaten.x << "," << event.foodEaten.y
+                       << " on tick " << event.foodEaten.tick << ", score " << event.foodEaten.score;
+        case EventKind::PlayerDied:
+            return out << "player died on tick " << event.playerDied.tick
+                       << ", score " << event.playerDied.score;
+    }
+    return out << "unknown event";
+}
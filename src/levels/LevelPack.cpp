@@ -0,0 +1,227 @@
+#include "levels/LevelPack.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAIKE_LEVELS_MMAP 1
+#endif
+
+namespace {
+    constexpr char Magic[8] = {'S', 'N', 'K', 'L', 'V', 'L', 'P', '1'};
+
+    std::uint64_t alignTo8(std::uint64_t offset) {
+        return (offset + 7) & ~std::uint64_t{7};
+    }
+}
+
+LevelPack::LevelPack(const std::string& packPath)
+    : path(packPath) {
+#ifdef SNAIKE_LEVELS_MMAP
+    const int fd = ::open(packPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open level pack " + packPath);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read level pack " + packPath);
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // The mapping keeps the file alive
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map level pack " + packPath);
+    }
+    bytes = static_cast<const std::uint8_t*>(address);
+    mapped = true;
+#else
+    std::ifstream in(packPath, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open level pack " + packPath);
+    }
+    size = static_cast<std::size_t>(in.tellg());
+    buffer.resize((size + 7) / 8);   // 64-bit elements keep the wall words aligned
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size));
+    if (!in) {
+        throw std::runtime_error("Cannot read level pack " + packPath);
+    }
+    bytes = reinterpret_cast<const std::uint8_t*>(buffer.data());
+#endif
+
+    try {
+        validate();
+    } catch (...) {
+#ifdef SNAIKE_LEVELS_MMAP
+        ::munmap(const_cast<std::uint8_t*>(bytes), size);
+#endif
+        throw;
+    }
+}
+
+LevelPack::~LevelPack() {
+#ifdef SNAIKE_LEVELS_MMAP
+    if (mapped) {
+        ::munmap(const_cast<std::uint8_t*>(bytes), size);
+    }
+#endif
+}
+
+void LevelPack::validate() {
+    auto fail = [this](const std::string& reason) {
+        throw std::runtime_error("Invalid level pack " + path + ": " + reason);
+    };
+
+    if (size < sizeof(LevelPackHeader)) fail("file too short");
+    header = reinterpret_cast<const LevelPackHeader*>(bytes);
+    if (std::memcmp(header->magic, Magic, sizeof(Magic)) != 0) fail("not a level pack");
+    if (header->byteOrder != ByteOrderTag) fail("written on a machine of the other byte order");
+    if (header->version != Version) fail("unsupported version " + std::to_string(header->version));
+
+    const std::uint64_t cells = static_cast<std::uint64_t>(header->width) * header->height;
+    if (header->levelCount == 0) fail("no levels");
+    if (cells == 0 || cells > MaxCells) fail("bad board size");
+    if (header->wallWords != (cells + 63) / 64) fail("bad wall size");
+    if (header->indexOffset % 8 != 0 ||
+        header->indexOffset + std::uint64_t{header->levelCount} * sizeof(LevelPackEntry) > size) {
+        fail("index out of range");
+    }
+    entries = reinterpret_cast<const LevelPackEntry*>(bytes + header->indexOffset);
+
+    // Only the index is checked; level data stays untouched until it is played
+    const std::uint64_t wallBytes = std::uint64_t{header->wallWords} * 8;
+    for (std::uint32_t i = 0; i < header->levelCount; ++i) {
+        const LevelPackEntry& entry = entries[i];
+        if (entry.offset % 8 != 0 || entry.freeCount == 0 || entry.freeCount > cells ||
+            entry.offset + wallBytes + std::uint64_t{entry.freeCount} * 2 > size ||
+            entry.spawnX >= header->width || entry.spawnY >= header->height) {
+            fail("level " + std::to_string(i) + " out of range");
+        }
+    }
+}
+
+Level LevelPack::level(std::uint32_t index) const {
+    const LevelPackEntry& entry = entries[index];
+    Level result;
+    result.width = header->width;
+    result.height = header->height;
+    result.spawn = sf::Vector2i(entry.spawnX, entry.spawnY);
+    result.walls = reinterpret_cast<const std::uint64_t*>(bytes + entry.offset);
+    result.freeCells = reinterpret_cast<const std::uint16_t*>(bytes + entry.offset + header->wallWords * 8);
+    result.freeCount = entry.freeCount;
+    return result;
+}
+
+void LevelPack::write(const std::string& packPath, const std::vector<LevelSource>& levels) {
+    if (levels.empty()) {
+        throw std::runtime_error("A level pack needs at least one level");
+    }
+    const int width = levels.front().walls.getWidth();
+    const int height = levels.front().walls.getHeight();
+    if (width <= 0 || height <= 0 || width * height > MaxCells) {
+        throw std::runtime_error("Level boards must have 1 to " + std::to_string(MaxCells) + " cells");
+    }
+    const std::uint32_t wallWords = static_cast<std::uint32_t>(levels.front().walls.wordCount());
+
+    LevelPackHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.byteOrder = ByteOrderTag;
+    header.levelCount = static_cast<std::uint32_t>(levels.size());
+    header.width = static_cast<std::uint16_t>(width);
+    header.height = static_cast<std::uint16_t>(height);
+    header.wallWords = wallWords;
+    header.indexOffset = sizeof(LevelPackHeader);
+
+    std::vector<LevelPackEntry> entries(levels.size());
+    std::vector<std::vector<std::uint16_t>> freeLists(levels.size());
+    std::uint64_t offset = alignTo8(header.indexOffset + entries.size() * sizeof(LevelPackEntry));
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        const LevelSource& level = levels[i];
+        const std::string name = "Level " + std::to_string(i);
+        if (level.walls.getWidth() != width || level.walls.getHeight() != height) {
+            throw std::runtime_error(name + " has a different board size");
+        }
+        // Snake::reset puts the head at the spawn with the body trailing left
+        for (int dx = 0; dx < 3; ++dx) {
+            const int x = level.spawn.x - dx;
+            if (x < 0 || x >= width || level.spawn.y < 0 || level.spawn.y >= height ||
+                level.walls.test(level.spawn.y * width + x)) {
+                throw std::runtime_error(name + " spawns the snake on a wall or off the board");
+            }
+        }
+
+        for (int cell = 0; cell < width * height; ++cell) {
+            if (!level.walls.test(cell)) freeLists[i].push_back(static_cast<std::uint16_t>(cell));
+        }
+        entries[i].offset = offset;
+        entries[i].freeCount = static_cast<std::uint32_t>(freeLists[i].size());
+        entries[i].spawnX = static_cast<std::uint16_t>(level.spawn.x);
+        entries[i].spawnY = static_cast<std::uint16_t>(level.spawn.y);
+        offset = alignTo8(offset + std::uint64_t{wallWords} * 8 + freeLists[i].size() * 2);
+    }
+
+    std::ofstream out(packPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to write " + packPath);
+    }
+    static const char padding[8] = {};
+    auto pad = [&out]() {
+        const auto position = static_cast<std::uint64_t>(out.tellp());
+        out.write(padding, static_cast<std::streamsize>(alignTo8(position) - position));
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(LevelPackEntry)));
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        pad();
+        out.write(reinterpret_cast<const char*>(levels[i].walls.data()), std::streamsize{wallWords} * 8);
+        out.write(reinterpret_cast<const char*>(freeLists[i].data()),
+                  static_cast<std::streamsize>(freeLists[i].size() * 2));
+    }
+    pad();
+    if (!out) {
+        throw std::runtime_error("Failed to write " + packPath);
+    }
+}
+
+LevelSource LevelPack::parse(const std::string& text) {
+    std::vector<std::string> rows;
+    std::istringstream stream(text);
+    std::string row;
+    while (std::getline(stream, row)) {
+        if (!row.empty() && row.back() == '\r') row.pop_back();
+        if (!row.empty()) rows.push_back(row);
+    }
+    if (rows.empty()) {
+        throw std::runtime_error("Empty level");
+    }
+
+    const int width = static_cast<int>(rows.front().size());
+    const int height = static_cast<int>(rows.size());
+    LevelSource level{Bitboard(width, height), sf::Vector2i(-1, -1)};
+    for (int y = 0; y < height; ++y) {
+        if (static_cast<int>(rows[y].size()) != width) {
+            throw std::runtime_error("Level row " + std::to_string(y) + " has a different length");
+        }
+        for (int x = 0; x < width; ++x) {
+            const char c = rows[y][x];
+            if (c == '#') {
+                level.walls.set(y * width + x);
+            } else if (c == 'S') {
+                if (level.spawn.x >= 0) throw std::runtime_error("Level has more than one 'S'");
+                level.spawn = sf::Vector2i(x, y);
+            }
+        }
+    }
+    if (level.spawn.x < 0) {
+        throw std::runtime_error("Level has no 'S' (snake head)");
+    }
+    return level;
+}
@@ -1,8 +1,154 @@
 
 #include "Game.hpp"
+#include "GameSession.hpp"
+#include "MosaicViewer.hpp"
+#include "agents/ControllerRegistry.hpp"
+#include "levels/LevelPack.hpp"
+#include "metrics/Metrics.hpp"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
 
-int main() {
-    Game game;
+namespace {
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --spectate SOCKET      watch a game streamed to a spectator socket\n"
+                  << "  --metrics PATH         write PATH.prom and PATH.json metrics every 5 s\n"
+                  << "  --agent NAME           let a controller or plugin:<path> play instead of the keyboard\n"
+                  << "  --levels PACK          play classic games on random levels of a level pack\n"
+                  << "  --speed N              tick rate multiplier for games, 0 for uncapped (default 1)\n"
+                  << "  --trajectories DIR     stream every step of classic games to DIR as .npy chunks\n"
+                  << "  --pacing MODE          how frames and ticks wait: sleep, yield (default) or spin\n"
+                  << "  --run-log FILE         append finished classic games to a shared run log\n"
+                  << "  --record-session FILE  record key presses from one seed for replay_bench\n"
+                  << "  --rewind-on-death      freeze classic games in rewind when the snake dies\n"
+                  << "  --mosaic N             tile N agent games in one window\n"
+                  << "  --log-events           print state transitions and game events to stderr\n";
+    }
+
+    /**
+     * @brief Parses a whole command-line value as a non-negative int
+     * @return false if the text is empty, has trailing characters or is out of range
+     */
+    bool parseCount(const char* text, int& value) {
+        char* end = nullptr;
+        errno = 0;
+        const long parsed = std::strtol(text, &end, 10);
+        if (end == text || *end != '\0' || errno != 0 || parsed < 0 || parsed > INT_MAX) {
+            return false;
+        }
+        value = static_cast<int>(parsed);
+        return true;
+    }
+}
+
+// --agent lets a registered controller or an agent plugin ("plugin:<path>")
+// play classic games instead of the keyboard. --levels plays classic games
+// on random levels of a level pack. --speed starts games in turbo mode
+// at a tick rate multiplier (0 = uncapped; PageUp/PageDown/Home change
+// it while playing). --trajectories streams every step of classic games
+// to .npy chunks for offline training. --pacing picks how frames and
+// ticks wait for their deadlines: plain sleeps, sleeps finished by
+// yielding (default), or finished by spinning (most precise, most CPU).
+// --run-log appends every finished classic game to a log that any number
+// of instances may share, and ranks the game against it on the game over
+// screen. --record-session saves every key press with its tick and
+// plays all games from one seed, so replay_bench can replay the session.
+// --rewind-on-death freezes classic games in rewind when the snake dies,
+// to inspect the moves leading up to it before the game over screen.
+// --mosaic opens a viewer tiling that many agent games (--agent, default
+// flood) in one window, each tile moving on to the next seed when its
+// game ends; --levels, --speed and --pacing apply to it as well.
+// --log-events prints state transitions and game events to stderr.
+int main(int argc, char** argv) {
+    GameOptions options;
+    std::string metricsPath;
+    std::string levelPath;
+    int mosaicGames = 0;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        bool valid = true;
+        if (std::strcmp(argv[i], "--log-events") == 0) {
+            options.logEvents = true;
+        } else if (std::strcmp(argv[i], "--rewind-on-death") == 0) {
+            options.rewindOnDeath = true;
+        } else if (std::strcmp(argv[i], "--spectate") == 0 && hasValue) {
+            options.spectateSource = argv[++i];
+        } else if (std::strcmp(argv[i], "--metrics") == 0 && hasValue) {
+            metricsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--agent") == 0 && hasValue) {
+            options.agent = argv[++i];
+        } else if (std::strcmp(argv[i], "--levels") == 0 && hasValue) {
+            levelPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--speed") == 0 && hasValue) {
+            valid = parseCount(argv[++i], options.speed);
+        } else if (std::strcmp(argv[i], "--trajectories") == 0 && hasValue) {
+            options.trajectoryDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--pacing") == 0 && hasValue) {
+            try {
+                options.pacing = parsePacingMode(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                valid = false;
+            }
+        } else if (std::strcmp(argv[i], "--run-log") == 0 && hasValue) {
+            options.runLogPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--record-session") == 0 && hasValue) {
+            options.sessionPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--mosaic") == 0 && hasValue) {
+            valid = parseCount(argv[++i], mosaicGames) && mosaicGames > 0;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::unique_ptr<MetricsExporter> metricsExporter;
+    if (!metricsPath.empty()) {
+        metricsExporter = std::make_unique<MetricsExporter>(metricsPath);
+    }
+
+    if (mosaicGames > 0 && options.agent.empty()) {
+        options.agent = "flood";
+    }
+    if (!options.agent.empty()) {
+        try {
+            ControllerRegistry::create(options.agent);   // Fail now rather than when a game starts
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (!levelPath.empty()) {
+        try {
+            options.levels = std::make_shared<const LevelPack>(levelPath);
+            GameSession(0).setLevel(options.levels->level(0));   // Check the board size up front
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (mosaicGames > 0) {
+        try {
+            MosaicViewer viewer(mosaicGames, options);
+            viewer.run();
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    Game game(options);
     game.run();
     return 0;
 }
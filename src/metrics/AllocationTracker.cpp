@@ -0,0 +1,116 @@
+#include "metrics/AllocationTracker.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+const char* allocPhaseName(AllocPhase phase) {
+    switch (phase) {
+        case AllocPhase::Other:    return "other";
+        case AllocPhase::Input:    return "input";
+        case AllocPhase::Update:   return "update";
+        case AllocPhase::Snapshot: return "snapshot";
+        case AllocPhase::Render:   return "render";
+        case AllocPhase::Count:    break;
+    }
+    return "unknown";
+}
+
+#ifdef SNAIKE_TRACK_ALLOCATIONS
+namespace {
+    // Constant-initialised so touching them from operator new never allocates
+    thread_local std::uint64_t threadCount = 0;
+    thread_local AllocPhase threadPhase = AllocPhase::Other;
+    std::atomic<std::uint64_t> phaseCounts[static_cast<int>(AllocPhase::Count)];
+
+    void count() {
+        ++threadCount;
+        phaseCounts[static_cast<int>(threadPhase)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* allocate(std::size_t size) {
+        count();
+        return std::malloc(size ? size : 1);
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+        count();
+        const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size ? size : 1, align);
+#else
+        void* memory = nullptr;
+        if (posix_memalign(&memory, align < sizeof(void*) ? sizeof(void*) : align, size ? size : 1) != 0) {
+            return nullptr;
+        }
+        return memory;
+#endif
+    }
+
+    void releaseAligned(void* memory) {
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+
+    void* allocateOrThrow(std::size_t size) {
+        if (void* memory = allocate(size)) return memory;
+        throw std::bad_alloc();
+    }
+
+    void* allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment) {
+        if (void* memory = allocateAligned(size, alignment)) return memory;
+        throw std::bad_alloc();
+    }
+}
+
+std::uint64_t AllocationTracker::threadAllocations() {
+    return threadCount;
+}
+
+std::uint64_t AllocationTracker::phaseAllocations(AllocPhase phase) {
+    return phaseCounts[static_cast<int>(phase)].load(std::memory_order_relaxed);
+}
+
+AllocPhase AllocationTracker::currentPhase() {
+    return threadPhase;
+}
+
+AllocPhase AllocationTracker::setPhase(AllocPhase phase) {
+    const AllocPhase previous = threadPhase;
+    threadPhase = phase;
+    return previous;
+}
+
+// Replacements for the global allocation functions
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { releaseAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { releaseAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { releaseAligned(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { releaseAligned(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(memory); }
+#endif
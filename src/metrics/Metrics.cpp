@@ -0,0 +1,275 @@
+#include "metrics/Metrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+unsigned metricShard() {
+    static std::atomic<unsigned> nextShard{0};
+    thread_local const unsigned shard = nextShard.fetch_add(1, std::memory_order_relaxed) % MetricShards;
+    return shard;
+}
+
+std::uint64_t Counter::value() const {
+    std::uint64_t total = 0;
+    for (const Shard& shard : shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+Histogram::Shard::Shard() {
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+Histogram::Histogram()
+    : shards(new Shard[MetricShards]) {
+}
+
+std::uint64_t Histogram::bucketLowerBound(int index) {
+    if (index < SubBuckets) {
+        return static_cast<std::uint64_t>(index);
+    }
+    const int shift = index / SubBuckets - 1;
+    const std::uint64_t mantissa = static_cast<std::uint64_t>(SubBuckets + index % SubBuckets);
+    return mantissa << shift;
+}
+
+std::uint64_t Histogram::bucketUpperBound(int index) {
+    if (index < SubBuckets) {
+        return static_cast<std::uint64_t>(index);
+    }
+    const int shift = index / SubBuckets - 1;
+    return bucketLowerBound(index) + ((std::uint64_t{1} << shift) - 1);
+}
+
+void Histogram::snapshot(Snapshot& out) const {
+    out = Snapshot{};
+    for (unsigned s = 0; s < MetricShards; ++s) {
+        const Shard& shard = shards[s];
+        out.sum += shard.sum.load(std::memory_order_relaxed);
+        for (int i = 0; i < BucketCount; ++i) {
+            const std::uint64_t n = shard.counts[i].load(std::memory_order_relaxed);
+            out.counts[i] += n;
+            out.count += n;
+        }
+    }
+}
+
+std::uint64_t Histogram::Snapshot::quantile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    // Rank of the sample at quantile q, 1-based
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(q * count + 0.5));
+    std::uint64_t seen = 0;
+    int last = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        if (counts[i] == 0) continue;
+        seen += counts[i];
+        last = i;
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(last);
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::entry(const std::string& name, const std::string& help) {
+    Entry& e = entries[name];
+    if (e.help.empty()) {
+        e.help = help;
+    }
+    return e;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& e = entry(name, help);
+    if (e.gauge || e.histogram) {
+        throw std::runtime_error("Metric " + name + " is not a counter");
+    }
+    if (!e.counter) {
+        e.counter = std::make_unique<Counter>();
+    }
+    return *e.counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& e = entry(name, help);
+    if (e.counter || e.histogram) {
+        throw std::runtime_error("Metric " + name + " is not a gauge");
+    }
+    if (!e.gauge) {
+        e.gauge = std::make_unique<Gauge>();
+    }
+    return *e.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& e = entry(name, help);
+    if (e.counter || e.gauge) {
+        throw std::runtime_error("Metric " + name + " is not a histogram");
+    }
+    if (!e.histogram) {
+        e.histogram = std::make_unique<Histogram>();
+    }
+    return *e.histogram;
+}
+
+namespace {
+    // "name{labels}" -> "name"
+    std::string baseName(const std::string& name) {
+        return name.substr(0, name.find('{'));
+    }
+
+    // "name{a=\"1\"}" + suffix + extra label -> "name_suffix{a=\"1\",extra}"
+    std::string seriesName(const std::string& name, const char* suffix, const std::string& extraLabel = "") {
+        const std::size_t brace = name.find('{');
+        std::string labels = brace == std::string::npos ? "" : name.substr(brace + 1, name.size() - brace - 2);
+        if (!extraLabel.empty()) {
+            labels += labels.empty() ? extraLabel : "," + extraLabel;
+        }
+        std::string series = baseName(name) + suffix;
+        if (!labels.empty()) {
+            series += "{" + labels + "}";
+        }
+        return series;
+    }
+
+    void writeJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+}
+
+void MetricsRegistry::writePrometheus(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::set<std::string> described;
+    Histogram::Snapshot snap;
+
+    for (const auto& [name, e] : entries) {
+        const std::string base = baseName(name);
+        if (described.insert(base).second) {
+            if (!e.help.empty()) {
+                out << "# HELP " << base << ' ' << e.help << '\n';
+            }
+            out << "# TYPE " << base << ' '
+                << (e.counter ? "counter" : e.gauge ? "gauge" : "histogram") << '\n';
+        }
+
+        if (e.counter) {
+            out << name << ' ' << e.counter->value() << '\n';
+        } else if (e.gauge) {
+            out << name << ' ' << e.gauge->value() << '\n';
+        } else if (e.histogram) {
+            // Cumulative buckets at every power of two (le = 2^k - 1), the same bounds on every
+            // export so rate() and histogram_quantile() see each series from the start
+            e.histogram->snapshot(snap);
+            std::uint64_t cumulative = 0;
+            for (int i = 0; i < Histogram::BucketCount - Histogram::SubBuckets; ++i) {
+                cumulative += snap.counts[i];
+                if ((i + 1) % Histogram::SubBuckets != 0) continue;
+                out << seriesName(name, "_bucket", "le=\"" + std::to_string(Histogram::bucketUpperBound(i)) + "\"")
+                    << ' ' << cumulative << '\n';
+            }
+            out << seriesName(name, "_bucket", "le=\"+Inf\"") << ' ' << snap.count << '\n';
+            out << seriesName(name, "_sum") << ' ' << snap.sum << '\n';
+            out << seriesName(name, "_count") << ' ' << snap.count << '\n';
+        }
+    }
+}
+
+void MetricsRegistry::writeJson(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Histogram::Snapshot snap;
+    const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    out << "{\"timestamp_ms\":" << now;
+    const char* sections[] = {"counters", "gauges", "histograms"};
+    for (int section = 0; section < 3; ++section) {
+        out << ",\"" << sections[section] << "\":{";
+        bool first = true;
+        for (const auto& [name, e] : entries) {
+            const bool match = section == 0 ? bool(e.counter) : section == 1 ? bool(e.gauge) : bool(e.histogram);
+            if (!match) continue;
+            if (!first) out << ',';
+            first = false;
+            writeJsonString(out, name);
+            out << ':';
+            if (e.counter) {
+                out << e.counter->value();
+            } else if (e.gauge) {
+                out << e.gauge->value();
+            } else {
+                e.histogram->snapshot(snap);
+                out << "{\"count\":" << snap.count
+                    << ",\"sum\":" << snap.sum
+                    << ",\"mean\":" << (snap.count ? static_cast<double>(snap.sum) / snap.count : 0.0)
+                    << ",\"p50\":" << snap.quantile(0.50)
+                    << ",\"p90\":" << snap.quantile(0.90)
+                    << ",\"p99\":" << snap.quantile(0.99)
+                    << ",\"p999\":" << snap.quantile(0.999)
+                    << ",\"max\":" << snap.quantile(1.0) << '}';
+            }
+        }
+        out << '}';
+    }
+    out << "}\n";
+}
+
+MetricsExporter::MetricsExporter(const std::string& path, std::chrono::milliseconds period)
+    : basePath(path)
+    , interval(period) {
+    worker = std::thread([this] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+            lock.unlock();
+            exportNow();
+            lock.lock();
+        }
+    });
+}
+
+MetricsExporter::~MetricsExporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    exportNow();
+}
+
+void MetricsExporter::exportNow() const {
+    const MetricsRegistry& registry = MetricsRegistry::instance();
+    const std::pair<const char*, void (MetricsRegistry::*)(std::ostream&) const> formats[] = {
+        {".prom", &MetricsRegistry::writePrometheus},
+        {".json", &MetricsRegistry::writeJson},
+    };
+    for (const auto& [extension, write] : formats) {
+        const std::string target = basePath + extension;
+        const std::string temporary = target + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::trunc);
+            if (!out) continue;  // Export is best effort; the game keeps running
+            (registry.*write)(out);
+        }
+        std::rename(temporary.c_str(), target.c_str());
+    }
+}
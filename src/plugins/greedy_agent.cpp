@@ -0,0 +1,87 @@
+// Example agent plugin: the greedy controller rewritten against the C ABI only.
+//
+// Build as a shared library and pass it as plugin:<path>, e.g.
+//   ./build/bin/tournament --agents greedy,plugin:./build/bin/libgreedy_agent.so
+//
+// Observations carry no heading, so each slot remembers the previous head
+// cell to avoid turning back into its own neck.
+#include "agents/AgentPluginAbi.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+    struct Agent {
+        int width;
+        int height;
+        std::vector<int> previousHead;   // Per slot, -1 at the start of a game
+    };
+
+    constexpr int DeltaX[4] = {0, 0, -1, 1};   // Up, Down, Left, Right
+    constexpr int DeltaY[4] = {-1, 1, 0, 0};
+
+    std::uint8_t choose(const Agent& agent, const std::uint8_t* cells, int& previous) {
+        int head = -1;
+        int food = -1;
+        for (int i = 0; i < agent.width * agent.height; ++i) {
+            if (cells[i] == SNAIKE_CELL_HEAD) head = i;
+            else if (cells[i] == SNAIKE_CELL_FOOD) food = i;
+        }
+        if (head < 0) return SNAIKE_ACTION_RIGHT;
+
+        const int hx = head % agent.width;
+        const int hy = head / agent.width;
+        int best = -1;
+        int bestDistance = 0;
+        for (int action = 0; action < 4; ++action) {
+            const int x = hx + DeltaX[action];
+            const int y = hy + DeltaY[action];
+            if (x < 0 || y < 0 || x >= agent.width || y >= agent.height) continue;
+            const int cell = y * agent.width + x;
+            if (cell == previous || cells[cell] == SNAIKE_CELL_BODY || cells[cell] == SNAIKE_CELL_WALL) continue;
+
+            const int distance = food < 0 ? 0
+                : std::abs(food % agent.width - x) + std::abs(food / agent.width - y);
+            if (best < 0 || distance < bestDistance) {
+                best = action;
+                bestDistance = distance;
+            }
+        }
+        previous = head;
+        return static_cast<std::uint8_t>(best < 0 ? SNAIKE_ACTION_UP : best);
+    }
+}
+
+extern "C" {
+
+SNAIKE_AGENT_EXPORT void* snaike_agent_init(const SnaikeAgentConfig* config) {
+    if (config->abi_version != SNAIKE_AGENT_ABI_VERSION) return nullptr;
+    Agent* agent = new (std::nothrow) Agent;
+    if (!agent) return nullptr;
+    agent->width = static_cast<int>(config->grid_width);
+    agent->height = static_cast<int>(config->grid_height);
+    agent->previousHead.assign(config->max_batch, -1);
+    return agent;
+}
+
+SNAIKE_AGENT_EXPORT void snaike_agent_reset(void* handle, std::uint32_t slot, std::uint64_t) {
+    static_cast<Agent*>(handle)->previousHead[slot] = -1;
+}
+
+SNAIKE_AGENT_EXPORT int snaike_agent_act_batch(void* handle, const std::uint8_t* const* observations,
+                                               std::uint32_t n, std::uint8_t* actions_out) {
+    Agent& agent = *static_cast<Agent*>(handle);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (observations[i]) {
+            actions_out[i] = choose(agent, observations[i], agent.previousHead[i]);
+        }
+    }
+    return 0;
+}
+
+SNAIKE_AGENT_EXPORT void snaike_agent_shutdown(void* handle) {
+    delete static_cast<Agent*>(handle);
+}
+
+}
@@ -0,0 +1,76 @@
+#include "render/FramePacer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    // Formats a microsecond value compactly: "850us", "1.2ms"
+    std::string formatMicros(std::uint64_t micros) {
+        char text[32];
+        if (micros < 1000) {
+            std::snprintf(text, sizeof(text), "%lluus", static_cast<unsigned long long>(micros));
+        } else {
+            std::snprintf(text, sizeof(text), "%.1fms", micros / 1000.0);
+        }
+        return text;
+    }
+}
+
+PacingMode parsePacingMode(const std::string& name) {
+    if (name == "sleep") return PacingMode::Sleep;
+    if (name == "yield") return PacingMode::Yield;
+    if (name == "spin") return PacingMode::Spin;
+    throw std::runtime_error("Unknown pacing mode: " + name + " (expected sleep, yield or spin)");
+}
+
+FramePacer::FramePacer(PacingMode pacingMode, Histogram& jitterHistogram)
+    : mode(pacingMode)
+    , jitter(jitterHistogram)
+    , margin(std::chrono::milliseconds(1))
+    , oversleep(Clock::duration::zero()) {
+}
+
+FramePacer::Clock::time_point FramePacer::waitUntil(Clock::time_point deadline) {
+    if (mode == PacingMode::Sleep) {
+        std::this_thread::sleep_until(deadline);
+        return Clock::now();
+    }
+
+    auto now = Clock::now();
+    const auto wakeAt = deadline - margin;
+    if (now < wakeAt) {
+        std::this_thread::sleep_until(wakeAt);
+        now = Clock::now();
+
+        // Peak with a slow decay: one long oversleep widens the margin for a while
+        oversleep = std::max(now - wakeAt, oversleep - oversleep / 16);
+        margin = std::clamp(oversleep + oversleep / 2, MinMargin, MaxMargin);
+    }
+
+    while (now < deadline) {
+        if (mode == PacingMode::Yield) {
+            std::this_thread::yield();
+        }
+        now = Clock::now();
+    }
+    return now;
+}
+
+void FramePacer::record(Clock::duration lateness) {
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(lateness).count();
+    jitter.record(static_cast<std::uint64_t>(std::max<std::chrono::microseconds::rep>(micros, 0)));
+}
+
+std::string FramePacer::summary() const {
+    auto snap = std::make_unique<Histogram::Snapshot>();   // ~8 KiB, too big for some thread stacks
+    jitter.snapshot(*snap);
+    if (snap->count == 0) {
+        return "";
+    }
+    return "p50 " + formatMicros(snap->quantile(0.5)) +
+           "  p99 " + formatMicros(snap->quantile(0.99)) +
+           "  max " + formatMicros(snap->quantile(1.0)) +
+           " (" + std::to_string(snap->count) + " samples)";
+}
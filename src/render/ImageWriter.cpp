@@ -0,0 +1,270 @@
+#include "render/ImageWriter.hpp"
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+    constexpr int MinMatch = 3;
+    constexpr int MaxMatch = 258;
+    constexpr std::size_t MaxDistance = 32768;
+
+    constexpr std::uint16_t LengthBase[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    constexpr std::uint8_t LengthExtra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    constexpr std::uint16_t DistanceBase[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    constexpr std::uint8_t DistanceExtra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    /**
+     * @brief LSB-first bit stream as deflate expects it
+     */
+    class BitWriter {
+    private:
+        std::vector<std::uint8_t>& out;
+        std::uint64_t bits{0};
+        int count{0};
+
+    public:
+        explicit BitWriter(std::vector<std::uint8_t>& output) : out(output) {}
+
+        void put(std::uint32_t value, int length) {
+            bits |= static_cast<std::uint64_t>(value) << count;
+            count += length;
+            while (count >= 8) {
+                out.push_back(static_cast<std::uint8_t>(bits));
+                bits >>= 8;
+                count -= 8;
+            }
+        }
+
+        // Huffman codes are defined MSB first
+        void putCode(std::uint32_t code, int length) {
+            std::uint32_t reversed = 0;
+            for (int i = 0; i < length; ++i) {
+                reversed = (reversed << 1) | ((code >> i) & 1);
+            }
+            put(reversed, length);
+        }
+
+        void flush() {
+            if (count > 0) out.push_back(static_cast<std::uint8_t>(bits));
+            bits = 0;
+            count = 0;
+        }
+    };
+
+    // Fixed literal/length code (RFC 1951, 3.2.6)
+    void putSymbol(BitWriter& writer, int symbol) {
+        if (symbol < 144) writer.putCode(0x30 + symbol, 8);
+        else if (symbol < 256) writer.putCode(0x190 + symbol - 144, 9);
+        else if (symbol < 280) writer.putCode(symbol - 256, 7);
+        else writer.putCode(0xC0 + symbol - 280, 8);
+    }
+
+    void putMatch(BitWriter& writer, int length, std::size_t distance) {
+        int code = 28;
+        while (LengthBase[code] > length) --code;
+        putSymbol(writer, 257 + code);
+        writer.put(length - LengthBase[code], LengthExtra[code]);
+
+        int dcode = 29;
+        while (DistanceBase[dcode] > distance) --dcode;
+        writer.putCode(dcode, 5);
+        writer.put(static_cast<std::uint32_t>(distance - DistanceBase[dcode]), DistanceExtra[dcode]);
+    }
+
+    /**
+     * @brief Compresses data as one fixed-Huffman deflate block
+     * @param candidates Match distances to try at every position
+     */
+    void deflateFixed(const std::vector<std::uint8_t>& data, const std::array<std::size_t, 2>& candidates,
+                      std::vector<std::uint8_t>& out) {
+        BitWriter writer(out);
+        writer.put(1, 1);   // final block
+        writer.put(1, 2);   // fixed Huffman codes
+
+        const std::size_t size = data.size();
+        std::size_t i = 0;
+        while (i < size) {
+            int bestLength = 0;
+            std::size_t bestDistance = 0;
+            for (const std::size_t distance : candidates) {
+                if (distance == 0 || distance > i || distance > MaxDistance) continue;
+                const std::size_t limit = std::min<std::size_t>(MaxMatch, size - i);
+                std::size_t length = 0;
+                while (length < limit && data[i + length] == data[i + length - distance]) ++length;
+                if (static_cast<int>(length) > bestLength) {
+                    bestLength = static_cast<int>(length);
+                    bestDistance = distance;
+                }
+            }
+            if (bestLength >= MinMatch) {
+                putMatch(writer, bestLength, bestDistance);
+                i += bestLength;
+            } else {
+                putSymbol(writer, data[i]);
+                ++i;
+            }
+        }
+        putSymbol(writer, 256);   // end of block
+        writer.flush();
+    }
+
+    std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) {
+        static const auto table = [] {
+            std::array<std::uint32_t, 256> t{};
+            for (std::uint32_t n = 0; n < 256; ++n) {
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[n] = c;
+            }
+            return t;
+        }();
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i) {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    std::uint32_t adler32(const std::vector<std::uint8_t>& data) {
+        std::uint32_t a = 1;
+        std::uint32_t b = 0;
+        std::size_t i = 0;
+        while (i < data.size()) {
+            // 5552 bytes is the longest run that cannot overflow b
+            const std::size_t end = std::min(data.size(), i + 5552);
+            for (; i < end; ++i) {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        return (b << 16) | a;
+    }
+
+    void putBigEndian(std::vector<std::uint8_t>& out, std::uint32_t value) {
+        out.push_back(static_cast<std::uint8_t>(value >> 24));
+        out.push_back(static_cast<std::uint8_t>(value >> 16));
+        out.push_back(static_cast<std::uint8_t>(value >> 8));
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    /**
+     * @brief Appends a PNG chunk whose payload is already at out[start + 8, end)
+     */
+    void closeChunk(std::vector<std::uint8_t>& out, std::size_t start) {
+        const auto length = static_cast<std::uint32_t>(out.size() - start - 8);
+        out[start] = static_cast<std::uint8_t>(length >> 24);
+        out[start + 1] = static_cast<std::uint8_t>(length >> 16);
+        out[start + 2] = static_cast<std::uint8_t>(length >> 8);
+        out[start + 3] = static_cast<std::uint8_t>(length);
+        putBigEndian(out, crc32(out.data() + start + 4, length + 4));
+    }
+
+    std::size_t openChunk(std::vector<std::uint8_t>& out, const char* type) {
+        const std::size_t start = out.size();
+        putBigEndian(out, 0);
+        out.insert(out.end(), type, type + 4);
+        return start;
+    }
+}
+
+void encodePpm(const std::uint32_t* pixels, int width, int height, std::vector<std::uint8_t>& out) {
+    const std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+    const std::size_t count = static_cast<std::size_t>(width) * height;
+    out.resize(header.size() + 3 * count);
+    std::copy(header.begin(), header.end(), out.begin());
+
+    const auto* rgba = reinterpret_cast<const std::uint8_t*>(pixels);
+    std::uint8_t* rgb = out.data() + header.size();
+    for (std::size_t i = 0; i < count; ++i, rgba += 4, rgb += 3) {
+        rgb[0] = rgba[0];
+        rgb[1] = rgba[1];
+        rgb[2] = rgba[2];
+    }
+}
+
+void encodePng(const std::uint32_t* pixels, int width, int height, std::vector<std::uint8_t>& out) {
+    // Scanlines with filter type 0; matches against the row above do the work of the Up filter
+    thread_local std::vector<std::uint8_t> scanlines;
+    const std::size_t stride = 1 + 3 * static_cast<std::size_t>(width);
+    scanlines.resize(stride * height);
+    const auto* rgba = reinterpret_cast<const std::uint8_t*>(pixels);
+    for (int y = 0; y < height; ++y) {
+        std::uint8_t* row = scanlines.data() + y * stride;
+        *row++ = 0;
+        for (int x = 0; x < width; ++x, rgba += 4, row += 3) {
+            row[0] = rgba[0];
+            row[1] = rgba[1];
+            row[2] = rgba[2];
+        }
+    }
+
+    static const std::uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.assign(signature, signature + 8);
+
+    std::size_t chunk = openChunk(out, "IHDR");
+    putBigEndian(out, static_cast<std::uint32_t>(width));
+    putBigEndian(out, static_cast<std::uint32_t>(height));
+    out.insert(out.end(), {8, 2, 0, 0, 0});   // 8-bit RGB, deflate, no interlace
+    closeChunk(out, chunk);
+
+    chunk = openChunk(out, "IDAT");
+    out.insert(out.end(), {0x78, 0x01});      // zlib header, 32 KiB window
+    deflateFixed(scanlines, {3, stride}, out);
+    putBigEndian(out, adler32(scanlines));
+    closeChunk(out, chunk);
+
+    chunk = openChunk(out, "IEND");
+    closeChunk(out, chunk);
+}
+
+void writeFile(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+EncoderPipe::EncoderPipe(const std::string& command)
+#ifdef _WIN32
+    : pipe(popen(command.c_str(), "wb")) {
+#else
+    : pipe(popen(command.c_str(), "w")) {
+#endif
+    if (!pipe) {
+        throw std::runtime_error("Cannot start encoder: " + command);
+    }
+}
+
+EncoderPipe::~EncoderPipe() {
+    close();
+}
+
+void EncoderPipe::write(const std::uint32_t* pixels, int width, int height) {
+    const std::size_t count = static_cast<std::size_t>(width) * height;
+    if (!pipe || std::fwrite(pixels, sizeof(std::uint32_t), count, pipe) != count) {
+        throw std::runtime_error("Encoder stopped reading frames");
+    }
+}
+
+int EncoderPipe::close() {
+    if (!pipe) return 0;
+    const int status = pclose(pipe);
+    pipe = nullptr;
+    return status;
+}
@@ -0,0 +1,118 @@
+#include "render/MosaicRenderer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /**
+     * @brief Grid of tiles and the pixel size of one board cell
+     */
+    struct MosaicLayout {
+        int columns{1};
+        int rows{1};
+        float cell{0.0f};
+    };
+
+    // Tries every column count and keeps the one with the largest cells
+    MosaicLayout chooseLayout(std::size_t tiles, int boardWidth, int boardHeight, float width, float height) {
+        MosaicLayout best;
+        const int count = static_cast<int>(std::max<std::size_t>(tiles, 1));
+        for (int columns = 1; columns <= count; ++columns) {
+            const int rows = (count + columns - 1) / columns;
+            const float cell = std::min((width - (columns + 1) * MosaicRenderer::TileGap) / (columns * boardWidth),
+                                        (height - (rows + 1) * MosaicRenderer::TileGap) / (rows * boardHeight));
+            if (cell > best.cell) {
+                best = {columns, rows, cell};
+            }
+        }
+        return best;
+    }
+}
+
+MosaicRenderer::MosaicRenderer(const sf::Font& textFont)
+    : textRenderer(textFont)
+    , buffer(sf::Triangles, sf::VertexBuffer::Stream)
+    , useBuffer(sf::VertexBuffer::isAvailable()) {
+}
+
+void MosaicRenderer::addQuad(float left, float top, float width, float height, sf::Color color) {
+    const sf::Vector2f a(left, top);
+    const sf::Vector2f b(left + width, top);
+    const sf::Vector2f c(left + width, top + height);
+    const sf::Vector2f d(left, top + height);
+    sf::Vertex* v = vertices.data() + vertexCount;
+    v[0] = sf::Vertex(a, color);
+    v[1] = sf::Vertex(b, color);
+    v[2] = sf::Vertex(c, color);
+    v[3] = sf::Vertex(a, color);
+    v[4] = sf::Vertex(c, color);
+    v[5] = sf::Vertex(d, color);
+    vertexCount += 6;
+}
+
+void MosaicRenderer::build(const MosaicSnapshot& mosaic, sf::Vector2u size) {
+    const FrameSnapshot& frame = mosaic.frame;
+    vertexCount = 0;
+    if (mosaic.tiles.empty() || frame.boardWidth <= 0 || frame.boardHeight <= 0) {
+        return;
+    }
+
+    const float width = static_cast<float>(size.x);
+    const float height = static_cast<float>(size.y) - MosaicSnapshot::HeaderHeight;
+    const MosaicLayout layout = chooseLayout(mosaic.tiles.size(), frame.boardWidth, frame.boardHeight, width, height);
+    if (layout.cell <= 0.0f) {
+        return;   // Window too small to show anything
+    }
+
+    // Whole-pixel tile origins keep boards from shimmering as they update
+    const float cell = layout.cell >= 1.0f ? std::floor(layout.cell) : layout.cell;
+    const float inset = cell > 4.0f ? 1.0f : 0.0f;
+    const float tileWidth = cell * frame.boardWidth;
+    const float tileHeight = cell * frame.boardHeight;
+    const float left = std::floor((width - layout.columns * (tileWidth + TileGap) + TileGap) / 2);
+    const float top = MosaicSnapshot::HeaderHeight +
+                      std::floor((height - layout.rows * (tileHeight + TileGap) + TileGap) / 2);
+
+    // Six vertices per quad: one background per tile and one quad per cell
+    const std::size_t needed = 6 * (mosaic.tiles.size() + frame.cells.size());
+    if (vertices.size() < needed) {
+        vertices.resize(needed + needed / 2);
+    }
+
+    std::size_t first = 0;
+    for (std::size_t t = 0; t < mosaic.tiles.size(); ++t) {
+        const MosaicTile& tile = mosaic.tiles[t];
+        const float x = left + static_cast<float>(t % layout.columns) * (tileWidth + TileGap);
+        const float y = top + static_cast<float>(t / layout.columns) * (tileHeight + TileGap);
+        addQuad(x, y, tileWidth, tileHeight, tile.background);
+        for (std::size_t i = first; i < tile.cellEnd; ++i) {
+            const SnapshotCell& c = frame.cells[i];
+            addQuad(x + c.x * cell + inset, y + c.y * cell + inset, cell - 2 * inset, cell - 2 * inset, c.color);
+        }
+        first = tile.cellEnd;
+    }
+
+    // The buffer grows with the vertex array, so it is only reallocated when that is;
+    // if the driver refuses either step, draw from memory from now on
+    if (useBuffer) {
+        useBuffer = (buffer.getVertexCount() >= vertexCount || buffer.create(vertices.size())) &&
+                    buffer.update(vertices.data(), vertexCount, 0);
+    }
+}
+
+void MosaicRenderer::draw(sf::RenderWindow& window, const MosaicSnapshot& mosaic) {
+    const sf::Vector2u size = window.getSize();
+    if (mosaic.frame.sequence != builtSequence || size != builtSize) {
+        build(mosaic, size);
+        builtSequence = mosaic.frame.sequence;
+        builtSize = size;
+    }
+
+    if (vertexCount > 0) {
+        if (useBuffer) {
+            window.draw(buffer, 0, vertexCount);
+        } else {
+            window.draw(vertices.data(), vertexCount, sf::Triangles);
+        }
+    }
+    textRenderer.drawTexts(window, mosaic.frame);
+}
@@ -0,0 +1,59 @@
+#include "render/SnapshotRenderer.hpp"
+#include <algorithm>
+
+SnapshotRenderer::SnapshotRenderer(const sf::Font& textFont)
+    : font(textFont) {
+}
+
+void SnapshotRenderer::draw(sf::RenderWindow& window, const FrameSnapshot& frame) {
+    if (frame.boardWidth > 0 && frame.boardHeight > 0 && !frame.cells.empty()) {
+        // Fit the board into the window, whatever its size
+        const sf::Vector2u size = window.getSize();
+        const float cell = std::min(static_cast<float>(size.x) / frame.boardWidth,
+                                    static_cast<float>(size.y) / frame.boardHeight);
+        const float inset = cell > 4.0f ? 1.0f : 0.0f;
+
+        cellShape.setSize(sf::Vector2f(cell - 2 * inset, cell - 2 * inset));
+        for (const SnapshotCell& c : frame.cells) {
+            cellShape.setFillColor(c.color);
+            cellShape.setPosition(c.x * cell + inset, c.y * cell + inset);
+            window.draw(cellShape);
+        }
+    }
+    drawTexts(window, frame);
+}
+
+void SnapshotRenderer::drawTexts(sf::RenderWindow& window, const FrameSnapshot& frame) {
+    if (textCache.size() < frame.texts.size()) {
+        textCache.resize(frame.texts.size());
+    }
+    for (std::size_t i = 0; i < frame.texts.size(); ++i) {
+        const SnapshotText& t = frame.texts[i];
+        CachedText& cached = textCache[i];
+        sf::Text& text = cached.drawable;
+        if (cached.text != t.text || cached.size != t.size || !(cached.color == t.color)) {
+            cached.text.assign(t.text.data(), t.text.size());
+            cached.size = t.size;
+            cached.color = t.color;
+            text.setFont(font);
+            text.setString(sf::String::fromUtf8(t.text.begin(), t.text.end()));
+            text.setCharacterSize(t.size);
+            text.setFillColor(t.color);
+            cached.bounds = text.getLocalBounds();
+        }
+
+        const sf::FloatRect& bounds = cached.bounds;
+        switch (t.anchor) {
+            case TextAnchor::TopLeft:
+                text.setPosition(t.position);
+                break;
+            case TextAnchor::TopCenter:
+                text.setPosition(t.position.x - bounds.width / 2, t.position.y);
+                break;
+            case TextAnchor::Center:
+                text.setPosition(t.position.x - bounds.width / 2, t.position.y - bounds.height / 2);
+                break;
+        }
+        window.draw(text);
+    }
+}
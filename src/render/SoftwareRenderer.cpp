@@ -0,0 +1,187 @@
+#include "render/SoftwareRenderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    /**
+     * @brief Writes count copies of a pixel, four per store where possible
+     */
+    void fillSpan(std::uint32_t* out, int count, std::uint32_t value) {
+        int i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i four = _mm_set1_epi32(static_cast<int>(value));
+        for (; i + 8 <= count; i += 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), four);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), four);
+        }
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), four);
+        }
+#endif
+        for (; i < count; ++i) {
+            out[i] = value;
+        }
+    }
+
+    /**
+     * @brief Decodes one UTF-8 sequence and advances the cursor (U+FFFD on errors)
+     */
+    char32_t nextCodepoint(std::string_view::const_iterator& it, std::string_view::const_iterator end) {
+        const auto lead = static_cast<unsigned char>(*it++);
+        if (lead < 0x80) return lead;
+
+        int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1;
+        if (extra < 0) return 0xFFFD;
+        char32_t codepoint = lead & (0x3F >> extra);
+        for (; extra > 0; --extra) {
+            if (it == end || (static_cast<unsigned char>(*it) & 0xC0) != 0x80) return 0xFFFD;
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(*it++) & 0x3F);
+        }
+        return codepoint;
+    }
+}
+
+SoftwareRenderer::SoftwareRenderer(const TrueTypeFont& textFont, int frameWidth, int frameHeight)
+    : font(textFont)
+    , width(frameWidth)
+    , height(frameHeight)
+    , pixels(static_cast<std::size_t>(frameWidth) * frameHeight, packColor(sf::Color::Black)) {
+}
+
+std::uint32_t SoftwareRenderer::packColor(sf::Color color) {
+    // Byte order in memory is R, G, B, A on every platform
+    const std::uint8_t bytes[4] = {color.r, color.g, color.b, color.a};
+    std::uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+const SoftwareRenderer::CachedGlyph& SoftwareRenderer::glyph(char32_t codepoint, unsigned size) {
+    const std::uint64_t key = (static_cast<std::uint64_t>(size) << 32) | codepoint;
+    auto it = glyphs.find(key);
+    if (it == glyphs.end()) {
+        CachedGlyph cached;
+        cached.index = font.glyphIndex(codepoint);
+        font.rasterize(cached.index, size, cached.bitmap);
+        it = glyphs.emplace(key, std::move(cached)).first;
+    }
+    return it->second;
+}
+
+void SoftwareRenderer::fillRect(float left, float top, float right, float bottom, std::uint32_t color) {
+    // Same coverage rule as the GPU: a pixel is filled when its centre is inside
+    const int x0 = std::max(0, static_cast<int>(std::ceil(left - 0.5f)));
+    const int x1 = std::min(width, static_cast<int>(std::ceil(right - 0.5f)));
+    const int y0 = std::max(0, static_cast<int>(std::ceil(top - 0.5f)));
+    const int y1 = std::min(height, static_cast<int>(std::ceil(bottom - 0.5f)));
+    if (x0 >= x1) return;
+
+    std::uint32_t* row = pixels.data() + static_cast<std::size_t>(y0) * width + x0;
+    for (int y = y0; y < y1; ++y, row += width) {
+        fillSpan(row, x1 - x0, color);
+    }
+}
+
+void SoftwareRenderer::drawText(const SnapshotText& text) {
+    // First pass: the local bounds sf::Text would report (baseline at y = size)
+    const auto size = static_cast<int>(text.size);
+    float minX = static_cast<float>(size);
+    float minY = static_cast<float>(size);
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+    int x = 0;
+    int previous = -1;
+    for (auto it = text.text.begin(); it != text.text.end();) {
+        const CachedGlyph& g = glyph(nextCodepoint(it, text.text.end()), text.size);
+        if (previous >= 0) x += font.kerning(previous, g.index, text.size);
+        previous = g.index;
+        const GlyphBitmap& bitmap = g.bitmap;
+        if (bitmap.coverage.empty()) {
+            // Whitespace only widens the box along the baseline
+            minX = std::min(minX, static_cast<float>(x));
+            minY = std::min(minY, static_cast<float>(size));
+            x += bitmap.advance;
+            maxX = std::max(maxX, static_cast<float>(x));
+            maxY = std::max(maxY, static_cast<float>(size));
+            continue;
+        }
+        minX = std::min(minX, static_cast<float>(x + bitmap.left));
+        maxX = std::max(maxX, static_cast<float>(x + bitmap.left + bitmap.width));
+        minY = std::min(minY, static_cast<float>(size + bitmap.top));
+        maxY = std::max(maxY, static_cast<float>(size + bitmap.top + bitmap.height));
+        x += bitmap.advance;
+    }
+
+    sf::Vector2f origin = text.position;
+    switch (text.anchor) {
+        case TextAnchor::TopLeft:
+            break;
+        case TextAnchor::TopCenter:
+            origin.x -= (maxX - minX) / 2;
+            break;
+        case TextAnchor::Center:
+            origin.x -= (maxX - minX) / 2;
+            origin.y -= (maxY - minY) / 2;
+            break;
+    }
+    const int originX = static_cast<int>(std::lround(origin.x));
+    const int baseline = static_cast<int>(std::lround(origin.y)) + size;
+
+    // Second pass: blend every glyph's coverage in the text colour
+    auto* bytes = reinterpret_cast<std::uint8_t*>(pixels.data());
+    const sf::Color color = text.color;
+    x = 0;
+    previous = -1;
+    for (auto it = text.text.begin(); it != text.text.end();) {
+        const CachedGlyph& g = glyph(nextCodepoint(it, text.text.end()), text.size);
+        if (previous >= 0) x += font.kerning(previous, g.index, text.size);
+        previous = g.index;
+        const GlyphBitmap& bitmap = g.bitmap;
+
+        const int left = originX + x + bitmap.left;
+        const int top = baseline + bitmap.top;
+        const int gx0 = std::max(0, -left);
+        const int gx1 = std::min(bitmap.width, width - left);
+        const int gy0 = std::max(0, -top);
+        const int gy1 = std::min(bitmap.height, height - top);
+        for (int gy = gy0; gy < gy1; ++gy) {
+            const std::uint8_t* coverage = bitmap.coverage.data() + static_cast<std::size_t>(gy) * bitmap.width;
+            std::uint8_t* out = bytes + (static_cast<std::size_t>(top + gy) * width + left) * 4;
+            for (int gx = gx0; gx < gx1; ++gx) {
+                const unsigned alpha = (coverage[gx] * color.a + 127) / 255;
+                if (alpha == 0) continue;
+                std::uint8_t* px = out + gx * 4;
+                const unsigned inverse = 255 - alpha;
+                px[0] = static_cast<std::uint8_t>((color.r * alpha + px[0] * inverse + 127) / 255);
+                px[1] = static_cast<std::uint8_t>((color.g * alpha + px[1] * inverse + 127) / 255);
+                px[2] = static_cast<std::uint8_t>((color.b * alpha + px[2] * inverse + 127) / 255);
+                px[3] = static_cast<std::uint8_t>(alpha + (px[3] * inverse + 127) / 255);
+            }
+        }
+        x += bitmap.advance;
+    }
+}
+
+void SoftwareRenderer::draw(const FrameSnapshot& frame, sf::Color background) {
+    fillSpan(pixels.data(), width * height, packColor(background));
+
+    if (frame.boardWidth > 0 && frame.boardHeight > 0 && !frame.cells.empty()) {
+        // Fit the board into the framebuffer exactly as SnapshotRenderer fits the window
+        const float cell = std::min(static_cast<float>(width) / frame.boardWidth,
+                                    static_cast<float>(height) / frame.boardHeight);
+        const float inset = cell > 4.0f ? 1.0f : 0.0f;
+        for (const SnapshotCell& c : frame.cells) {
+            const float left = c.x * cell + inset;
+            const float top = c.y * cell + inset;
+            fillRect(left, top, left + cell - 2 * inset, top + cell - 2 * inset, packColor(c.color));
+        }
+    }
+
+    for (const SnapshotText& text : frame.texts) {
+        drawText(text);
+    }
+}
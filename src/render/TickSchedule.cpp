@@ -0,0 +1,22 @@
+#include "render/TickSchedule.hpp"
+
+TickSchedule::TickSchedule(Clock::time_point start)
+    : nextTick(start)
+    , windowStart(start) {
+}
+
+bool TickSchedule::ticked(Clock::time_point now, Clock::duration period, Clock::duration slack) {
+    nextTick += period;
+    if (nextTick < now - slack) {
+        nextTick = now + period;
+    }
+
+    ++ticksInWindow;
+    if (now - windowStart < std::chrono::seconds(1)) {
+        return false;
+    }
+    measuredRate = ticksInWindow / std::chrono::duration<double>(now - windowStart).count();
+    windowStart = now;
+    ticksInWindow = 0;
+    return true;
+}
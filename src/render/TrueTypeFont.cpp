@@ -0,0 +1,455 @@
+#include "render/TrueTypeFont.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+    // Compound glyphs may nest; real fonts stay far below this
+    constexpr int MaxCompoundDepth = 8;
+
+    /**
+     * @brief Signed-area accumulation buffer for one glyph
+     *
+     * Every edge adds its signed coverage to the cells it crosses; a
+     * running sum along each row then gives the coverage of every pixel
+     * (the approach of font-rs and stb_truetype's v2 rasterizer).
+     */
+    struct Accumulator {
+        int width;
+        int height;
+        int stride;                  // width + 2, so edges ending at x == width stay in their row
+        std::vector<float> cells;
+
+        Accumulator(int w, int h)
+            : width(w), height(h), stride(w + 2)
+            , cells(static_cast<std::size_t>(stride) * h, 0.0f) {
+        }
+
+        void line(float x0, float y0, float x1, float y1) {
+            if (y0 == y1) return;
+            float dir = 1.0f;
+            if (y0 > y1) {
+                std::swap(x0, x1);
+                std::swap(y0, y1);
+                dir = -1.0f;
+            }
+            const float dxdy = (x1 - x0) / (y1 - y0);
+            float x = x0;
+            const int rowEnd = std::min(height, static_cast<int>(std::ceil(y1)));
+
+            for (int y = static_cast<int>(y0); y < rowEnd; ++y) {
+                float* row = cells.data() + static_cast<std::size_t>(y) * stride;
+                const float dy = std::min(static_cast<float>(y + 1), y1) - std::max(static_cast<float>(y), y0);
+                const float xNext = x + dxdy * dy;
+                const float d = dy * dir;
+                const float left = std::min(x, xNext);
+                const float right = std::max(x, xNext);
+                const float leftFloor = std::floor(left);
+                const int leftCell = static_cast<int>(leftFloor);
+                const float rightCeil = std::ceil(right);
+                const int rightCell = static_cast<int>(rightCeil);
+
+                if (rightCell <= leftCell + 1) {
+                    // The edge stays within one pixel column on this row
+                    const float middle = 0.5f * (x + xNext) - leftFloor;
+                    row[leftCell] += d - d * middle;
+                    row[leftCell + 1] += d * middle;
+                } else {
+                    const float s = 1.0f / (right - left);
+                    const float leftFrac = left - leftFloor;
+                    const float a0 = 0.5f * s * (1.0f - leftFrac) * (1.0f - leftFrac);
+                    const float rightFrac = right - rightCeil + 1.0f;
+                    const float am = 0.5f * s * rightFrac * rightFrac;
+                    row[leftCell] += d * a0;
+                    if (rightCell == leftCell + 2) {
+                        row[leftCell + 1] += d * (1.0f - a0 - am);
+                    } else {
+                        const float a1 = s * (1.5f - leftFrac);
+                        row[leftCell + 1] += d * (a1 - a0);
+                        for (int cx = leftCell + 2; cx < rightCell - 1; ++cx) {
+                            row[cx] += d * s;
+                        }
+                        const float a2 = a1 + static_cast<float>(rightCell - leftCell - 3) * s;
+                        row[rightCell - 1] += d * (1.0f - a2 - am);
+                    }
+                    row[rightCell] += d * am;
+                }
+                x = xNext;
+            }
+        }
+
+        void quad(float x0, float y0, float cx, float cy, float x1, float y1) {
+            // Enough segments that the chord error stays well below a pixel
+            const float ddx = x0 - 2.0f * cx + x1;
+            const float ddy = y0 - 2.0f * cy + y1;
+            const int segments = 1 + static_cast<int>(std::sqrt(std::sqrt(ddx * ddx + ddy * ddy) * 3.0f));
+            float px = x0;
+            float py = y0;
+            for (int i = 1; i <= segments; ++i) {
+                const float t = static_cast<float>(i) / segments;
+                const float u = 1.0f - t;
+                const float nx = u * u * x0 + 2.0f * u * t * cx + t * t * x1;
+                const float ny = u * u * y0 + 2.0f * u * t * cy + t * t * y1;
+                line(px, py, nx, ny);
+                px = nx;
+                py = ny;
+            }
+        }
+
+        void resolve(std::vector<std::uint8_t>& coverage) const {
+            coverage.resize(static_cast<std::size_t>(width) * height);
+            std::uint8_t* out = coverage.data();
+            for (int y = 0; y < height; ++y) {
+                const float* row = cells.data() + static_cast<std::size_t>(y) * stride;
+                float sum = 0.0f;
+                for (int x = 0; x < width; ++x) {
+                    sum += row[x];
+                    const float alpha = std::min(std::fabs(sum), 1.0f);
+                    *out++ = static_cast<std::uint8_t>(alpha * 255.0f + 0.5f);
+                }
+            }
+        }
+    };
+}
+
+TrueTypeFont::TrueTypeFont(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open font " + path);
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    const std::uint32_t version = u32(0);
+    if (version != 0x00010000 && version != 0x74727565) {   // 1.0 or 'true'
+        throw std::runtime_error(path + " is not a TrueType font");
+    }
+
+    std::uint32_t head = 0;
+    std::uint32_t maxp = 0;
+    std::uint32_t hhea = 0;
+    std::uint32_t cmapTable = 0;
+    std::uint32_t kernTable = 0;
+    const int numTables = u16(4);
+    for (int i = 0; i < numTables; ++i) {
+        const std::uint32_t record = 12 + 16 * static_cast<std::uint32_t>(i);
+        char tag[5] = {};
+        std::memcpy(tag, data.data() + record, 4);
+        const std::uint32_t offset = u32(record + 8);
+        if (std::strcmp(tag, "head") == 0) head = offset;
+        else if (std::strcmp(tag, "maxp") == 0) maxp = offset;
+        else if (std::strcmp(tag, "hhea") == 0) hhea = offset;
+        else if (std::strcmp(tag, "hmtx") == 0) hmtx = offset;
+        else if (std::strcmp(tag, "loca") == 0) loca = offset;
+        else if (std::strcmp(tag, "glyf") == 0) glyf = offset;
+        else if (std::strcmp(tag, "cmap") == 0) cmapTable = offset;
+        else if (std::strcmp(tag, "kern") == 0) kernTable = offset;
+    }
+    if (!head || !maxp || !hhea || !hmtx || !loca || !glyf || !cmapTable) {
+        throw std::runtime_error(path + " lacks TrueType outline tables");
+    }
+
+    unitsPerEm = u16(head + 18);
+    longOffsets = i16(head + 50) != 0;
+    numGlyphs = u16(maxp + 4);
+    numHMetrics = u16(hhea + 34);
+
+    // Prefer the full Unicode map, then the BMP one
+    int best = 0;
+    const int numMaps = u16(cmapTable + 2);
+    for (int i = 0; i < numMaps; ++i) {
+        const std::uint32_t record = cmapTable + 4 + 8 * static_cast<std::uint32_t>(i);
+        const int platform = u16(record);
+        const int encoding = u16(record + 2);
+        const std::uint32_t subtable = cmapTable + u32(record + 4);
+        const int format = u16(subtable);
+        int rank = 0;
+        if (format == 12 && (platform == 0 || (platform == 3 && encoding == 10))) rank = 2;
+        else if (format == 4 && (platform == 0 || (platform == 3 && encoding == 1))) rank = 1;
+        if (rank > best) {
+            best = rank;
+            cmap = subtable;
+        }
+    }
+    if (best == 0) {
+        throw std::runtime_error(path + " has no Unicode character map");
+    }
+
+    // Only the classic horizontal pair table (format 0) is used
+    if (kernTable && u16(kernTable) == 0 && u16(kernTable + 2) > 0) {
+        const std::uint32_t subtable = kernTable + 4;
+        const int coverage = u16(subtable + 4);
+        if ((coverage >> 8) == 0 && (coverage & 1)) kern = subtable;
+    }
+}
+
+std::uint16_t TrueTypeFont::u16(std::uint32_t offset) const {
+    if (offset + 2 > data.size()) return 0;
+    return static_cast<std::uint16_t>((data[offset] << 8) | data[offset + 1]);
+}
+
+std::uint32_t TrueTypeFont::u32(std::uint32_t offset) const {
+    return (static_cast<std::uint32_t>(u16(offset)) << 16) | u16(offset + 2);
+}
+
+int TrueTypeFont::glyphIndex(char32_t codepoint) const {
+    if (u16(cmap) == 12) {
+        // Sorted groups of consecutive code points
+        std::uint32_t lo = 0;
+        std::uint32_t hi = u32(cmap + 12);
+        while (lo < hi) {
+            const std::uint32_t mid = (lo + hi) / 2;
+            const std::uint32_t group = cmap + 16 + 12 * mid;
+            if (codepoint < u32(group)) hi = mid;
+            else if (codepoint > u32(group + 4)) lo = mid + 1;
+            else return static_cast<int>(u32(group + 8) + (codepoint - u32(group)));
+        }
+        return 0;
+    }
+
+    if (codepoint > 0xFFFF) return 0;
+    const std::uint32_t segCountX2 = u16(cmap + 6);
+    const std::uint32_t endCodes = cmap + 14;
+    const std::uint32_t startCodes = endCodes + segCountX2 + 2;
+    const std::uint32_t idDeltas = startCodes + segCountX2;
+    const std::uint32_t idRangeOffsets = idDeltas + segCountX2;
+    for (std::uint32_t seg = 0; seg < segCountX2; seg += 2) {
+        if (codepoint > u16(endCodes + seg)) continue;
+        const std::uint32_t start = u16(startCodes + seg);
+        if (codepoint < start) return 0;
+        const std::uint16_t delta = u16(idDeltas + seg);
+        const std::uint16_t rangeOffset = u16(idRangeOffsets + seg);
+        if (rangeOffset == 0) {
+            return static_cast<std::uint16_t>(codepoint + delta);
+        }
+        const std::uint16_t glyph = u16(idRangeOffsets + seg + rangeOffset + 2 * (codepoint - start));
+        return glyph == 0 ? 0 : static_cast<std::uint16_t>(glyph + delta);
+    }
+    return 0;
+}
+
+int TrueTypeFont::kerning(int left, int right, unsigned size) const {
+    if (!kern) return 0;
+    const std::uint32_t key = (static_cast<std::uint32_t>(left) << 16) | static_cast<std::uint32_t>(right);
+    std::uint32_t lo = 0;
+    std::uint32_t hi = u16(kern + 6);
+    while (lo < hi) {
+        const std::uint32_t mid = (lo + hi) / 2;
+        const std::uint32_t pair = kern + 14 + 6 * mid;
+        const std::uint32_t pairKey = u32(pair);
+        if (key < pairKey) hi = mid;
+        else if (key > pairKey) lo = mid + 1;
+        else return static_cast<int>(std::lround(i16(pair + 4) * static_cast<float>(size) / unitsPerEm));
+    }
+    return 0;
+}
+
+bool TrueTypeFont::glyphRange(int glyph, std::uint32_t& begin, std::uint32_t& end) const {
+    if (glyph < 0 || glyph >= numGlyphs) return false;
+    const auto index = static_cast<std::uint32_t>(glyph);
+    if (longOffsets) {
+        begin = u32(loca + 4 * index);
+        end = u32(loca + 4 * index + 4);
+    } else {
+        begin = 2u * u16(loca + 2 * index);
+        end = 2u * u16(loca + 2 * index + 2);
+    }
+    begin += glyf;
+    end += glyf;
+    return end > begin && end <= data.size();
+}
+
+void TrueTypeFont::appendOutline(int glyph, const float m[6], int depth,
+                                 std::vector<OutlinePoint>& points, std::vector<std::size_t>& contourEnds) const {
+    std::uint32_t begin;
+    std::uint32_t end;
+    if (depth > MaxCompoundDepth || !glyphRange(glyph, begin, end)) return;
+
+    const int numContours = i16(begin);
+    if (numContours >= 0) {
+        const std::uint32_t endPoints = begin + 10;
+        const int numPoints = numContours > 0 ? u16(endPoints + 2 * (numContours - 1)) + 1 : 0;
+        std::uint32_t cursor = endPoints + 2 * numContours;
+        cursor += 2 + u16(cursor);   // skip the hinting instructions
+
+        // Flags with run-length repeats
+        const std::size_t first = points.size();
+        points.resize(first + numPoints);
+        std::vector<std::uint8_t> flags(numPoints);
+        for (int i = 0; i < numPoints && cursor < end;) {
+            const std::uint8_t flag = data[cursor++];
+            int repeat = 1;
+            if ((flag & 0x08) && cursor < end) repeat += data[cursor++];
+            for (; repeat > 0 && i < numPoints; --repeat) flags[i++] = flag;
+        }
+
+        // Coordinates are deltas: a byte with a sign flag, or a word (or unchanged)
+        int value = 0;
+        for (int i = 0; i < numPoints; ++i) {
+            if (flags[i] & 0x02) {
+                const int delta = cursor < end ? data[cursor++] : 0;
+                value += (flags[i] & 0x10) ? delta : -delta;
+            } else if (!(flags[i] & 0x10)) {
+                value += i16(cursor);
+                cursor += 2;
+            }
+            points[first + i].x = static_cast<float>(value);
+            points[first + i].onCurve = flags[i] & 0x01;
+        }
+        value = 0;
+        for (int i = 0; i < numPoints; ++i) {
+            if (flags[i] & 0x04) {
+                const int delta = cursor < end ? data[cursor++] : 0;
+                value += (flags[i] & 0x20) ? delta : -delta;
+            } else if (!(flags[i] & 0x20)) {
+                value += i16(cursor);
+                cursor += 2;
+            }
+            points[first + i].y = static_cast<float>(value);
+        }
+
+        for (int i = 0; i < numPoints; ++i) {
+            OutlinePoint& p = points[first + i];
+            const float x = p.x;
+            p.x = m[0] * x + m[2] * p.y + m[4];
+            p.y = m[1] * x + m[3] * p.y + m[5];
+        }
+        for (int c = 0; c < numContours; ++c) {
+            contourEnds.push_back(first + u16(endPoints + 2 * c) + 1);
+        }
+        return;
+    }
+
+    // Compound glyph: components with an offset and an optional 2x2 transform
+    std::uint32_t cursor = begin + 10;
+    for (;;) {
+        const int flags = u16(cursor);
+        const int component = u16(cursor + 2);
+        cursor += 4;
+        float dx = 0.0f;
+        float dy = 0.0f;
+        if (flags & 0x0001) {
+            if (flags & 0x0002) {
+                dx = i16(cursor);
+                dy = i16(cursor + 2);
+            }
+            cursor += 4;
+        } else {
+            if (flags & 0x0002) {
+                dx = static_cast<std::int8_t>(data[cursor]);
+                dy = static_cast<std::int8_t>(data[cursor + 1]);
+            }
+            cursor += 2;
+        }
+
+        float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f;
+        if (flags & 0x0008) {
+            a = d = i16(cursor) / 16384.0f;
+            cursor += 2;
+        } else if (flags & 0x0040) {
+            a = i16(cursor) / 16384.0f;
+            d = i16(cursor + 2) / 16384.0f;
+            cursor += 4;
+        } else if (flags & 0x0080) {
+            a = i16(cursor) / 16384.0f;
+            b = i16(cursor + 2) / 16384.0f;
+            c = i16(cursor + 4) / 16384.0f;
+            d = i16(cursor + 6) / 16384.0f;
+            cursor += 8;
+        }
+
+        const float child[6] = {
+            m[0] * a + m[2] * b, m[1] * a + m[3] * b,
+            m[0] * c + m[2] * d, m[1] * c + m[3] * d,
+            m[0] * dx + m[2] * dy + m[4], m[1] * dx + m[3] * dy + m[5]
+        };
+        appendOutline(component, child, depth + 1, points, contourEnds);
+
+        if (!(flags & 0x0020) || cursor >= end) break;
+    }
+}
+
+void TrueTypeFont::rasterize(int glyph, unsigned size, GlyphBitmap& bitmap) const {
+    const float scale = static_cast<float>(size) / unitsPerEm;
+    const std::uint32_t metrics = glyph < numHMetrics ? glyph : numHMetrics - 1;
+    bitmap.advance = static_cast<int>(std::lround(u16(hmtx + 4 * metrics) * scale));
+    bitmap.width = bitmap.height = 0;
+    bitmap.left = bitmap.top = 0;
+    bitmap.coverage.clear();
+
+    // Outline in pixels with y pointing down
+    std::vector<OutlinePoint> points;
+    std::vector<std::size_t> contourEnds;
+    const float transform[6] = {scale, 0.0f, 0.0f, -scale, 0.0f, 0.0f};
+    appendOutline(glyph, transform, 0, points, contourEnds);
+    if (points.empty()) return;
+
+    float minX = points[0].x, maxX = points[0].x;
+    float minY = points[0].y, maxY = points[0].y;
+    for (const OutlinePoint& p : points) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    bitmap.left = static_cast<int>(std::floor(minX));
+    bitmap.top = static_cast<int>(std::floor(minY));
+    bitmap.width = std::max(1, static_cast<int>(std::ceil(maxX)) - bitmap.left);
+    bitmap.height = std::max(1, static_cast<int>(std::ceil(maxY)) - bitmap.top);
+
+    const float width = static_cast<float>(bitmap.width);
+    const float height = static_cast<float>(bitmap.height);
+    for (OutlinePoint& p : points) {
+        p.x = std::clamp(p.x - bitmap.left, 0.0f, width);
+        p.y = std::clamp(p.y - bitmap.top, 0.0f, height);
+    }
+
+    Accumulator accumulator(bitmap.width, bitmap.height);
+    std::size_t contourBegin = 0;
+    for (const std::size_t contourEnd : contourEnds) {
+        const OutlinePoint* p = points.data() + contourBegin;
+        const std::size_t n = contourEnd - contourBegin;
+        contourBegin = contourEnd;
+        if (n < 2) continue;
+
+        // Start on an on-curve point; two off-curve points imply one between them
+        OutlinePoint start;
+        std::size_t from = 0;
+        std::size_t to = n;
+        if (p[0].onCurve) {
+            start = p[0];
+            from = 1;
+        } else if (p[n - 1].onCurve) {
+            start = p[n - 1];
+            to = n - 1;
+        } else {
+            start = {(p[0].x + p[n - 1].x) / 2, (p[0].y + p[n - 1].y) / 2, true};
+        }
+
+        OutlinePoint current = start;
+        OutlinePoint control{};
+        bool hasControl = false;
+        for (std::size_t i = from; i < to; ++i) {
+            const OutlinePoint& q = p[i];
+            if (q.onCurve) {
+                if (hasControl) accumulator.quad(current.x, current.y, control.x, control.y, q.x, q.y);
+                else accumulator.line(current.x, current.y, q.x, q.y);
+                current = q;
+                hasControl = false;
+            } else {
+                if (hasControl) {
+                    const OutlinePoint middle{(control.x + q.x) / 2, (control.y + q.y) / 2, true};
+                    accumulator.quad(current.x, current.y, control.x, control.y, middle.x, middle.y);
+                    current = middle;
+                }
+                control = q;
+                hasControl = true;
+            }
+        }
+        if (hasControl) accumulator.quad(current.x, current.y, control.x, control.y, start.x, start.y);
+        else accumulator.line(current.x, current.y, start.x, start.y);
+    }
+    accumulator.resolve(bitmap.coverage);
+}
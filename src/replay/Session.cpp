@@ -0,0 +1,123 @@
+#include "replay/Session.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    struct KeyName {
+        sf::Keyboard::Key key;
+        const char* name;
+    };
+
+    const KeyName KeyNames[] = {
+        {sf::Keyboard::Up, "Up"},
+        {sf::Keyboard::Down, "Down"},
+        {sf::Keyboard::Left, "Left"},
+        {sf::Keyboard::Right, "Right"},
+        {sf::Keyboard::Enter, "Enter"},
+        {sf::Keyboard::Escape, "Escape"},
+        {sf::Keyboard::Backspace, "Backspace"},
+    };
+
+    std::string keyName(sf::Keyboard::Key key) {
+        for (const KeyName& entry : KeyNames) {
+            if (entry.key == key) return entry.name;
+        }
+        return std::to_string(static_cast<int>(key));
+    }
+
+    bool parseKey(const std::string& text, sf::Keyboard::Key& key) {
+        for (const KeyName& entry : KeyNames) {
+            if (text == entry.name) {
+                key = entry.key;
+                return true;
+            }
+        }
+        char* end = nullptr;
+        const long code = std::strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0' || code < 0 || code >= sf::Keyboard::KeyCount) {
+            return false;
+        }
+        key = static_cast<sf::Keyboard::Key>(code);
+        return true;
+    }
+}
+
+Session Session::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open session " + path);
+    }
+
+    Session session;
+    session.name = std::filesystem::path(path).stem().string();
+    auto fail = [&path](int lineNumber, const std::string& reason) {
+        throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + reason);
+    };
+
+    std::string line;
+    int lineNumber = 0;
+    bool sawHeader = false;
+    std::uint64_t tick = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.resize(comment);
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first)) continue;
+
+        if (!sawHeader) {
+            int version = 0;
+            if (first != "snaike-session" || !(fields >> version) || version != 1) {
+                fail(lineNumber, "not a version 1 session");
+            }
+            sawHeader = true;
+        } else if (first == "seed") {
+            if (!(fields >> session.seed)) fail(lineNumber, "bad seed");
+        } else if (first == "agent") {
+            if (!(fields >> session.agent)) fail(lineNumber, "missing agent name");
+        } else if (first == "levels") {
+            if (!(fields >> session.levels)) fail(lineNumber, "missing level pack");
+        } else if (first == "rewind-on-death") {
+            if (!(fields >> session.rewindOnDeath)) fail(lineNumber, "expected rewind-on-death 0 or 1");
+        } else if (first == "ticks") {
+            if (!(fields >> session.ticks)) fail(lineNumber, "bad tick count");
+        } else {
+            char* end = nullptr;
+            const std::uint64_t delta = std::strtoull(first.c_str(), &end, 10);
+            std::string keyText;
+            sf::Keyboard::Key key;
+            if (*end != '\0' || !(fields >> keyText) || !parseKey(keyText, key)) {
+                fail(lineNumber, "expected '<ticks> <key>'");
+            }
+            tick += delta;
+            session.record(tick, key);
+        }
+    }
+    if (!sawHeader) {
+        fail(lineNumber, "empty session");
+    }
+    return session;
+}
+
+void Session::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    out << "snaike-session 1\n"
+        << "seed " << seed << '\n';
+    if (!agent.empty()) out << "agent " << agent << '\n';
+    if (!levels.empty()) out << "levels " << levels << '\n';
+    if (rewindOnDeath) out << "rewind-on-death 1\n";
+    out << "ticks " << ticks << '\n';
+
+    std::uint64_t previous = 0;
+    for (const SessionEvent& event : events) {
+        out << event.tick - previous << ' ' << keyName(event.key) << '\n';
+        previous = event.tick;
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write session " + path);
+    }
+}
@@ -0,0 +1,299 @@
+#include "runlog/RunLog.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAIKE_RUNLOG_MMAP 1
+#endif
+
+namespace {
+    constexpr char IndexMagic[8] = {'S', 'N', 'K', 'R', 'U', 'N', 'I', '1'};
+    constexpr std::size_t ReadBatch = 256;   // Records per read while catching up with the tail
+
+    // Best first; earlier runs first on ties
+    bool better(const RunIndexEntry& a, const RunIndexEntry& b) {
+        return a.score != b.score ? a.score > b.score : a.record < b.record;
+    }
+
+    bool validHeader(const RunIndexHeader& header, std::uint64_t fileSize) {
+        return std::memcmp(header.magic, IndexMagic, sizeof(IndexMagic)) == 0 &&
+               header.version == RunLog::IndexVersion &&
+               header.byteOrder == RunLog::ByteOrderTag &&
+               header.entries <= header.records &&
+               fileSize == sizeof(RunIndexHeader) + header.entries * sizeof(RunIndexEntry);
+    }
+}
+
+RunLog::RunLog(const std::string& logPath)
+    : path(logPath)
+    , indexPath(logPath + ".idx") {
+#ifdef SNAIKE_RUNLOG_MMAP
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open run log " + path + ": " + std::strerror(errno));
+    }
+#else
+    std::ofstream create(path, std::ios::binary | std::ios::app);
+    if (!create) {
+        throw std::runtime_error("Cannot open run log " + path);
+    }
+#endif
+    refresh();
+}
+
+RunLog::~RunLog() {
+    unloadIndex();
+#ifdef SNAIKE_RUNLOG_MMAP
+    ::close(fd);
+#endif
+}
+
+RunRecord RunLog::makeRecord(const std::string& agent) {
+    RunRecord record{};
+    record.tag = RecordTag;
+    record.finishedAt = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    std::strncpy(record.agent, agent.c_str(), sizeof(record.agent) - 1);
+    return record;
+}
+
+void RunLog::append(const RunRecord& record) {
+#ifdef SNAIKE_RUNLOG_MMAP
+    // One write of the whole record: O_APPEND places it atomically after every other appender's
+    if (::write(fd, &record, sizeof(record)) != static_cast<ssize_t>(sizeof(record))) {
+        throw std::runtime_error("Failed to append to run log " + path + ": " + std::strerror(errno));
+    }
+#else
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    if (!out) {
+        throw std::runtime_error("Failed to append to run log " + path);
+    }
+#endif
+}
+
+std::uint64_t RunLog::logRecords() const {
+    // A record torn by a crash leaves a partial one at the end, which is ignored
+#ifdef SNAIKE_RUNLOG_MMAP
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(info.st_size) / sizeof(RunRecord);
+#else
+    std::error_code failure;
+    const auto bytes = std::filesystem::file_size(path, failure);
+    return failure ? 0 : bytes / sizeof(RunRecord);
+#endif
+}
+
+std::size_t RunLog::readRecords(std::uint64_t first, RunRecord* out, std::size_t count) const {
+#ifdef SNAIKE_RUNLOG_MMAP
+    const ssize_t bytes = ::pread(fd, out, count * sizeof(RunRecord),
+                                  static_cast<off_t>(first * sizeof(RunRecord)));
+    return bytes > 0 ? static_cast<std::size_t>(bytes) / sizeof(RunRecord) : 0;
+#else
+    std::ifstream in(path, std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(first * sizeof(RunRecord)));
+    in.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(count * sizeof(RunRecord)));
+    return static_cast<std::size_t>(in.gcount()) / sizeof(RunRecord);
+#endif
+}
+
+void RunLog::unloadIndex() {
+#ifdef SNAIKE_RUNLOG_MMAP
+    if (mapping) {
+        ::munmap(mapping, mappingSize);
+    }
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    buffer.clear();
+    index = nullptr;
+    indexed = 0;
+    covered = 0;
+}
+
+void RunLog::loadIndex() {
+    unloadIndex();
+#ifdef SNAIKE_RUNLOG_MMAP
+    const int indexFd = ::open(indexPath.c_str(), O_RDONLY);
+    if (indexFd < 0) {
+        return;   // No index yet: everything is tail
+    }
+    struct stat info;
+    if (::fstat(indexFd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(RunIndexHeader)) {
+        ::close(indexFd);
+        return;
+    }
+    const std::size_t bytes = static_cast<std::size_t>(info.st_size);
+    void* address = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, indexFd, 0);
+    ::close(indexFd);   // The mapping keeps the file alive, even after it is renamed over
+    if (address == MAP_FAILED) {
+        return;
+    }
+    const auto* header = static_cast<const RunIndexHeader*>(address);
+    if (!validHeader(*header, bytes)) {
+        ::munmap(address, bytes);
+        return;
+    }
+    mapping = address;
+    mappingSize = bytes;
+    index = reinterpret_cast<const RunIndexEntry*>(static_cast<const std::uint8_t*>(address) + sizeof(RunIndexHeader));
+    indexed = header->entries;
+    covered = header->records;
+#else
+    std::ifstream in(indexPath, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return;
+    }
+    const auto bytes = static_cast<std::uint64_t>(in.tellg());
+    RunIndexHeader header{};
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || !validHeader(header, bytes)) {
+        return;
+    }
+    buffer.resize(header.entries);
+    if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(header.entries * sizeof(RunIndexEntry)))) {
+        buffer.clear();
+        return;
+    }
+    index = buffer.data();
+    indexed = header.entries;
+    covered = header.records;
+#endif
+}
+
+void RunLog::refresh() {
+    loadIndex();
+    std::uint64_t total = logRecords();
+    if (covered > total) {
+        unloadIndex();   // The index belongs to a log that has since been replaced
+    }
+
+    auto readTail = [this, &total]() {
+        tail.clear();
+        tailEnd = covered;
+        RunRecord batch[ReadBatch];
+        for (std::uint64_t first = covered; first < total;) {
+            const std::size_t got = readRecords(first, batch, static_cast<std::size_t>(
+                std::min<std::uint64_t>(ReadBatch, total - first)));
+            if (got == 0) break;
+            for (std::size_t i = 0; i < got; ++i) {
+                if (batch[i].tag == RecordTag) {
+                    tail.push_back({batch[i].score, static_cast<std::uint32_t>(first + i)});
+                }
+            }
+            first += got;
+            tailEnd = first;
+        }
+        std::sort(tail.begin(), tail.end(), better);
+    };
+    readTail();
+
+    if (tail.size() > IndexSlack) {
+        reindex();
+        loadIndex();
+        total = std::max(total, covered);
+        readTail();
+    }
+}
+
+void RunLog::reindex() {
+    std::vector<RunIndexEntry> merged(indexed + tail.size());
+    std::merge(index, index + indexed, tail.begin(), tail.end(), merged.begin(), better);
+
+    RunIndexHeader header{};
+    std::memcpy(header.magic, IndexMagic, sizeof(IndexMagic));
+    header.version = IndexVersion;
+    header.byteOrder = ByteOrderTag;
+    header.records = tailEnd;   // Includes any non-records the tail skipped
+    header.entries = merged.size();
+
+    // A name of our own, so processes reindexing at the same time do not share a temporary file
+#ifdef SNAIKE_RUNLOG_MMAP
+    const std::string temporary = indexPath + ".tmp" + std::to_string(::getpid());
+#else
+    const std::string temporary = indexPath + ".tmp";
+#endif
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(merged.data()),
+                  static_cast<std::streamsize>(merged.size() * sizeof(RunIndexEntry)));
+        if (!out) {
+            std::remove(temporary.c_str());
+            return;   // Queries keep working from the tail
+        }
+    }
+    std::error_code failure;
+    std::filesystem::rename(temporary, indexPath, failure);
+    if (failure) {
+        std::remove(temporary.c_str());
+    }
+}
+
+std::uint64_t RunLog::countAbove(int score, bool inclusive) const {
+    auto above = [score, inclusive](const RunIndexEntry& entry) {
+        return inclusive ? entry.score >= score : entry.score > score;
+    };
+    return static_cast<std::uint64_t>(std::partition_point(index, index + indexed, above) - index) +
+           static_cast<std::uint64_t>(std::partition_point(tail.begin(), tail.end(), above) - tail.begin());
+}
+
+int RunLog::scoreAt(double q) const {
+    const std::uint64_t total = size();
+    if (total == 0) {
+        return 0;
+    }
+    // The run ranked `target` from the top has a fraction q of the runs at or below it
+    const auto atOrBelow = static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * total));
+    const std::uint64_t target = std::clamp<std::uint64_t>(total - atOrBelow + 1, 1, total);
+
+    // Highest score that at least `target` runs reach
+    int low = INT_MAX;
+    int high = INT_MIN;
+    if (indexed > 0) {
+        high = index[0].score;
+        low = index[indexed - 1].score;
+    }
+    if (!tail.empty()) {
+        high = std::max(high, tail.front().score);
+        low = std::min(low, tail.back().score);
+    }
+    while (low < high) {
+        const int middle = low + (high - low + 1) / 2;
+        if (countAbove(middle, true) >= target) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+std::vector<RunRecord> RunLog::top(std::size_t count) const {
+    std::vector<RunRecord> result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (result.size() < count && (i < indexed || j < tail.size())) {
+        const bool fromIndex = j == tail.size() || (i < indexed && better(index[i], tail[j]));
+        const RunIndexEntry& entry = fromIndex ? index[i++] : tail[j++];
+        RunRecord record;
+        if (readRecords(entry.record, &record, 1) == 1 && record.tag == RecordTag) {
+            result.push_back(record);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,415 @@
+#include "solver/SmallBoardSolver.hpp"
+#include "solver/TranspositionTable.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+    constexpr std::uint8_t RingMask = SmallBoardSolver::MaxCells - 1;
+    constexpr int HeadLink = 4;
+
+    std::uint64_t bit(int cell) { return std::uint64_t{1} << cell; }
+
+    // Best lines are compared as one number: more food first, then fewer ticks
+    std::uint64_t packLine(int score, std::uint32_t ticks) {
+        return (static_cast<std::uint64_t>(score) << 32) | (0xFFFFFFFFu - ticks);
+    }
+    int lineScore(std::uint64_t packed) { return static_cast<int>(packed >> 32); }
+    std::uint32_t lineTicks(std::uint64_t packed) { return 0xFFFFFFFFu - static_cast<std::uint32_t>(packed); }
+
+    constexpr Direction Directions[4] = {Direction::Up, Direction::Down, Direction::Left, Direction::Right};
+}
+
+/**
+ * @brief State shared by all search threads
+ */
+struct SmallBoardSolver::Shared {
+    TranspositionTable table;                 ///< Positions already searched
+    std::atomic<std::uint64_t> best;          ///< packLine() of the best line so far
+    std::mutex bestMutex;                     ///< Guards bestMoves
+    std::vector<Direction> bestMoves;         ///< Moves of the best line
+    std::atomic<bool> stop{false};            ///< Set when a thread finishes or the node limit is hit
+    std::atomic<std::uint64_t> nodes{0};      ///< Nodes flushed by the workers
+    std::uint32_t horizon;                    ///< Last tick searched
+    std::uint64_t maxNodes;                   ///< Node limit (0 = none)
+    bool fewestTicks;                         ///< Break score ties by ticks
+
+    explicit Shared(const SolverConfig& config)
+        : table(config.tableMegabytes)
+        , best(packLine(0, 0))
+        , horizon(config.maxTicks)
+        , maxNodes(config.maxNodes)
+        , fewestTicks(config.fewestTicks) {}
+
+    void offer(int score, std::uint32_t ticks, const std::vector<Direction>& moves, std::uint32_t count) {
+        const std::uint64_t packed = packLine(score, ticks);
+        if (packed <= best.load(std::memory_order_relaxed)) return;
+
+        std::lock_guard<std::mutex> lock(bestMutex);
+        if (packed <= best.load(std::memory_order_relaxed)) return;
+        bestMoves.assign(moves.begin(), moves.begin() + count);
+        best.store(packed, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Per-thread search stack and counters
+ */
+struct SmallBoardSolver::Worker {
+    unsigned index;                            ///< Thread number; 0 uses the plain move order
+    std::vector<Position> children;            ///< Up to three expanded moves per depth
+    std::vector<std::uint64_t> keys;           ///< Key of the position at every depth
+    std::vector<Direction> moves;              ///< Move played from every depth
+    std::vector<std::uint32_t> lastMeal;       ///< Depth of the latest food at or above every depth
+    GameRng orderRng;                          ///< Tie-breaks move order on helper threads
+    std::uint64_t nodes = 0;                   ///< Nodes expanded
+    std::uint64_t tableHits = 0;               ///< Nodes pruned by the table
+    bool finished = false;                     ///< Searched the whole tree
+
+    Worker(unsigned thread, std::uint32_t horizon)
+        : index(thread)
+        , children((horizon + 2) * 3)
+        , keys(horizon + 2)
+        , moves(horizon + 2)
+        , lastMeal(horizon + 2)
+        , orderRng(deriveSeed(0x50F7E5, thread)) {}
+};
+
+SmallBoardSolver::SmallBoardSolver(const SolverConfig& settings)
+    : config(settings)
+    , cells(settings.width * settings.height)
+{
+    if (config.width < 4 || config.height < 4 || cells > MaxCells) {
+        throw std::runtime_error("solver boards must be at least 4x4 and at most 64 cells, got " +
+                                 std::to_string(config.width) + "x" + std::to_string(config.height));
+    }
+    if (config.maxTicks == 0) {
+        config.maxTicks = static_cast<std::uint32_t>(cells * cells);
+    }
+    config.maxTicks = std::min<std::uint32_t>(config.maxTicks, TranspositionTable::MaxTick);
+
+    boardMask = cells == MaxCells ? ~std::uint64_t{0} : bit(cells) - 1;
+    notFirstColumn = 0;
+    notLastColumn = 0;
+    for (int cell = 0; cell < cells; ++cell) {
+        if (cell % config.width != 0) notFirstColumn |= bit(cell);
+        if (cell % config.width != config.width - 1) notLastColumn |= bit(cell);
+    }
+
+    // Fixed key stream so keys (and table contents) are the same every run
+    GameRng keyRng(0x2B0B15);
+    auto nextKey = [&keyRng]() {
+        return (static_cast<std::uint64_t>(keyRng()) << 32) | keyRng();
+    };
+    for (auto& cellKeys : segmentKeys) {
+        for (auto& key : cellKeys) key = nextKey();
+    }
+    for (auto& key : directionKeys) key = nextKey();
+    for (auto& key : foodKeys) key = nextKey();
+    growingKey = nextKey();
+}
+
+std::uint64_t SmallBoardSolver::linkKey(std::uint8_t from, std::uint8_t to) const {
+    int link = static_cast<int>(Direction::Right);
+    if (to + config.width == from) link = static_cast<int>(Direction::Up);
+    else if (from + config.width == to) link = static_cast<int>(Direction::Down);
+    else if (to + 1 == from) link = static_cast<int>(Direction::Left);
+    return segmentKeys[from][link];
+}
+
+void SmallBoardSolver::spawnFood(Position& position) const {
+    position.key ^= foodKeys[position.food] ^ position.rng.fingerprint();
+
+    if (position.length >= cells) {
+        // Board is full; GameSession would never find a free cell
+        position.food = NoFood;
+    } else {
+        int cell;
+        do {
+            const auto x = static_cast<int>(position.rng.bounded(config.width));
+            const auto y = static_cast<int>(position.rng.bounded(config.height));
+            cell = y * config.width + x;
+        } while (position.occupied & bit(cell));
+        position.food = static_cast<std::uint8_t>(cell);
+    }
+
+    position.key ^= foodKeys[position.food] ^ position.rng.fingerprint();
+}
+
+SmallBoardSolver::Position SmallBoardSolver::start() const {
+    Position position;
+    position.occupied = 0;
+    position.tail = 0;
+    position.growing = false;
+    position.score = 0;
+    position.tick = 0;
+    const int x = config.width / 2;
+    const int y = config.height / 2;
+    for (int i = 0; i < 3; ++i) {
+        const int cell = y * config.width + x - 2 + i;
+        position.body[i] = static_cast<std::uint8_t>(cell);
+        position.occupied |= bit(cell);
+    }
+    position.length = 3;
+    position.direction = Direction::Right;
+    position.rng.seed(config.seed);
+    position.food = NoFood;
+    spawnFood(position);
+    position.key = computeKey(position);
+    return position;
+}
+
+std::uint64_t SmallBoardSolver::computeKey(const Position& position) const {
+    std::uint64_t key = 0;
+    for (int i = 0; i + 1 < position.length; ++i) {
+        key ^= linkKey(position.body[(position.tail + i) & RingMask],
+                       position.body[(position.tail + i + 1) & RingMask]);
+    }
+    key ^= segmentKeys[position.head()][HeadLink];
+    key ^= directionKeys[static_cast<int>(position.direction)];
+    key ^= foodKeys[position.food];
+    if (position.growing) key ^= growingKey;
+    return key ^ position.rng.fingerprint();
+}
+
+bool SmallBoardSolver::step(Position& position, Direction direction) const {
+    const std::uint8_t head = position.head();
+    int x = head % config.width;
+    int y = head / config.width;
+    switch (direction) {
+        case Direction::Up:    --y; break;
+        case Direction::Down:  ++y; break;
+        case Direction::Left:  --x; break;
+        case Direction::Right: ++x; break;
+    }
+    if (x < 0 || x >= config.width || y < 0 || y >= config.height) {
+        return false;
+    }
+    const auto next = static_cast<std::uint8_t>(y * config.width + x);
+
+    // Same order as Snake::move + checkCollision: the tail leaves before the head arrives
+    if (position.growing) {
+        position.growing = false;
+        position.key ^= growingKey;
+    } else {
+        const std::uint8_t tail = position.body[position.tail];
+        position.key ^= linkKey(tail, position.body[(position.tail + 1) & RingMask]);
+        position.occupied &= ~bit(tail);
+        position.tail = (position.tail + 1) & RingMask;
+        --position.length;
+    }
+    if (position.occupied & bit(next)) {
+        return false;
+    }
+
+    position.key ^= segmentKeys[head][HeadLink] ^ segmentKeys[head][static_cast<int>(direction)];
+    position.key ^= segmentKeys[next][HeadLink];
+    position.key ^= directionKeys[static_cast<int>(position.direction)] ^ directionKeys[static_cast<int>(direction)];
+    position.direction = direction;
+    position.body[(position.tail + position.length) & RingMask] = next;
+    position.occupied |= bit(next);
+    ++position.length;
+    ++position.tick;
+
+    if (next == position.food) {
+        ++position.score;
+        position.growing = true;
+        position.key ^= growingKey;
+        spawnFood(position);
+    }
+    return true;
+}
+
+int SmallBoardSolver::foodDistance(const Position& position) const {
+    const std::uint64_t food = bit(position.food);
+    std::uint64_t blocked = position.occupied;
+    std::uint64_t layer = bit(position.head());
+    int freed = 0;
+    const int firstFree = position.growing ? 2 : 1;
+
+    for (int distance = 1; distance <= position.length + cells; ++distance) {
+        if (distance >= firstFree && freed < position.length) {
+            blocked &= ~bit(position.body[(position.tail + freed) & RingMask]);
+            ++freed;
+        }
+        layer = ((layer & notLastColumn) << 1) | ((layer & notFirstColumn) >> 1) |
+                (layer << config.width) | (layer >> config.width);
+        layer &= boardMask & ~blocked;
+
+        if (layer & food) return distance;
+        if (layer == 0) return -1;
+    }
+    return -1;
+}
+
+bool SmallBoardSolver::search(Worker& worker, Shared& shared, std::uint32_t depth,
+                              const Position& position, int distance) const {
+    if ((++worker.nodes & 1023) == 0) {
+        const std::uint64_t total = shared.nodes.fetch_add(1024, std::memory_order_relaxed) + 1024;
+        if (shared.maxNodes != 0 && total >= shared.maxNodes) {
+            shared.stop.store(true, std::memory_order_relaxed);
+        }
+    }
+    if (shared.stop.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    if (position.food == NoFood) {
+        return true;
+    }
+    if (shared.table.searchedBy(position.key, position.tick)) {
+        ++worker.tableHits;
+        return true;
+    }
+    // Coming back to a position since the last meal only wastes ticks
+    for (std::uint32_t i = worker.lastMeal[depth]; i < depth; ++i) {
+        if (worker.keys[i] == position.key) return true;
+    }
+    worker.keys[depth] = position.key;
+
+    // Cut positions that cannot eat again or cannot beat the best line
+    bool promising = false;
+    if (distance >= 0 && position.tick + distance <= shared.horizon) {
+        const std::uint32_t arrival = position.tick + static_cast<std::uint32_t>(distance);
+        const int reachable = std::min(maxScore(), position.score + 1 + static_cast<int>(shared.horizon - arrival));
+        const std::uint64_t best = shared.best.load(std::memory_order_relaxed);
+        if (reachable != lineScore(best) || !shared.fewestTicks) {
+            promising = reachable > lineScore(best);
+        } else {
+            // Every further food takes at least one more tick
+            promising = arrival + static_cast<std::uint32_t>(reachable - position.score - 1) < lineTicks(best);
+        }
+    }
+    if (!promising) {
+        shared.table.store(position.key, position.tick);
+        return true;
+    }
+
+    // Expand every move, then search the children closest to the food
+    // first; helper threads break ties randomly
+    Position* children = &worker.children[depth * 3];
+    Direction order[3];
+    int distances[3];
+    int rank[3];
+    int count = 0;
+    for (int i = 0; i < 4; ++i) {
+        const Direction dir = Directions[i];
+        if (dir == opposite(position.direction)) continue;
+
+        Position child = position;
+        if (!step(child, dir)) continue;
+
+        const bool ate = child.score > position.score;
+        if (ate) {
+            worker.moves[depth] = dir;
+            shared.offer(child.score, child.tick, worker.moves, depth + 1);
+        }
+        const int childDistance = child.food == NoFood ? 0 : foodDistance(child);
+        if (childDistance < 0) continue;
+
+        const int tieBreak = worker.index == 0 ? i : static_cast<int>(worker.orderRng.bounded(4));
+        const int childRank = ate ? -1 : childDistance * 4 + tieBreak;
+        int slot = count++;
+        for (; slot > 0 && rank[slot - 1] > childRank; --slot) {
+            children[slot] = children[slot - 1];
+            order[slot] = order[slot - 1];
+            distances[slot] = distances[slot - 1];
+            rank[slot] = rank[slot - 1];
+        }
+        children[slot] = child;
+        order[slot] = dir;
+        distances[slot] = childDistance;
+        rank[slot] = childRank;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        worker.moves[depth] = order[i];
+        worker.lastMeal[depth + 1] = children[i].score > position.score ? depth + 1 : worker.lastMeal[depth];
+        if (!search(worker, shared, depth + 1, children[i], distances[i])) {
+            return false;
+        }
+    }
+
+    shared.table.store(position.key, position.tick);
+    return true;
+}
+
+void SmallBoardSolver::runWorker(Worker& worker, Shared& shared) const {
+    const Position root = start();
+    worker.lastMeal[0] = 0;
+    worker.finished = search(worker, shared, 0, root, foodDistance(root));
+    if (worker.finished) {
+        // One complete search proves the best line; the others can stop
+        shared.stop.store(true, std::memory_order_relaxed);
+    }
+}
+
+SolverResult SmallBoardSolver::solve() const {
+    const auto started = std::chrono::steady_clock::now();
+    unsigned threads = config.threads ? config.threads : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    Shared shared(config);
+    std::vector<Worker> workers;
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(i, config.maxTicks);
+    }
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(&SmallBoardSolver::runWorker, this, std::ref(workers[i]), std::ref(shared));
+    }
+    runWorker(workers[0], shared);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    SolverResult result;
+    const std::uint64_t best = shared.best.load();
+    result.score = lineScore(best);
+    result.filled = result.score == maxScore();
+    result.length = result.filled ? cells : 3 + result.score;
+    result.ticks = lineTicks(best);
+    result.moves = shared.bestMoves;
+    for (const Worker& worker : workers) {
+        result.proven = result.proven || worker.finished;
+        result.nodes += worker.nodes;
+        result.tableHits += worker.tableHits;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+int SmallBoardSolver::replay(const std::vector<Direction>& moves) const {
+    Snake snake(config.width / 2, config.height / 2);
+    GameRng rng(config.seed);
+    sf::Vector2i food;
+    auto spawnFood = [&]() {
+        do {
+            food.x = static_cast<int>(rng.bounded(config.width));
+            food.y = static_cast<int>(rng.bounded(config.height));
+        } while (snake.occupies(food));
+    };
+
+    spawnFood();
+    int score = 0;
+    for (std::size_t tick = 0; tick < moves.size(); ++tick) {
+        snake.setDirection(moves[tick]);
+        snake.move();
+        if (snake.checkCollision(config.width, config.height)) {
+            throw std::runtime_error("snake died on tick " + std::to_string(tick + 1));
+        }
+        if (snake.eat(food)) {
+            ++score;
+            if (static_cast<int>(snake.length()) >= cells) break;
+            spawnFood();
+        }
+    }
+    return score;
+}
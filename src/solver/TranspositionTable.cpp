@@ -0,0 +1,51 @@
+#include "solver/TranspositionTable.hpp"
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) {
+    const std::size_t bytes = (megabytes ? megabytes : 1) << 20;
+    std::size_t buckets = 1;
+    while (buckets * 2 * BucketSize * sizeof(std::uint64_t) <= bytes) {
+        buckets *= 2;
+    }
+    bucketMask = buckets - 1;
+    entries.reset(new std::atomic<std::uint64_t>[buckets * BucketSize]);
+    for (std::size_t i = 0; i < buckets * BucketSize; ++i) {
+        entries[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+bool TranspositionTable::searchedBy(std::uint64_t key, std::uint32_t tick) const {
+    const std::atomic<std::uint64_t>* slots = bucket(key);
+    for (std::size_t i = 0; i < BucketSize; ++i) {
+        const std::uint64_t entry = slots[i].load(std::memory_order_relaxed);
+        if (entry != 0 && check(entry) == check(key)) {
+            return (entry & TickMask) <= tick;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, std::uint32_t tick) {
+    if (tick > MaxTick) return;
+    const std::uint64_t packed = check(key) | tick;
+    std::atomic<std::uint64_t>* slots = bucket(key);
+
+    std::size_t victim = 0;
+    std::uint64_t victimTick = 0;
+    for (std::size_t i = 0; i < BucketSize; ++i) {
+        std::uint64_t entry = slots[i].load(std::memory_order_relaxed);
+        if (entry != 0 && check(entry) == check(key)) {
+            // Only ever lower the tick; another thread may be storing too
+            while ((entry & TickMask) > (packed & TickMask) &&
+                   !slots[i].compare_exchange_weak(entry, packed, std::memory_order_relaxed)) {
+                if (check(entry) != check(key)) break;
+            }
+            return;
+        }
+        const std::uint64_t entryTick = entry == 0 ? TickMask + 1 : (entry & TickMask);
+        if (entryTick > victimTick) {
+            victim = i;
+            victimTick = entryTick;
+        }
+    }
+    slots[victim].store(packed, std::memory_order_relaxed);
+}
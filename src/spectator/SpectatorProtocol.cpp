@@ -0,0 +1,128 @@
+#include "spectator/SpectatorProtocol.hpp"
+
+namespace {
+    // Bounds that keep a corrupt or hostile stream from allocating unbounded memory
+    constexpr std::uint64_t MaxBoardCells = 1u << 24;
+    constexpr std::uint64_t MaxSnakeId = 0xFFFF;
+}
+
+bool SpectatorBoard::applyFrame(const std::uint8_t* payload, std::size_t size) {
+    if (size == 0) return false;
+    const std::uint8_t* end = payload + size;
+    const auto type = static_cast<SpectatorFrameType>(payload[0]);
+
+    bool ok = false;
+    if (type == SpectatorFrameType::Keyframe) {
+        ok = applyKeyframe(payload + 1, end);
+    } else if (type == SpectatorFrameType::Tick) {
+        ok = synced && applyTick(payload + 1, end);
+    }
+    if (!ok) synced = false;
+    return ok;
+}
+
+std::deque<std::uint32_t>* SpectatorBoard::snakeFor(std::uint64_t id) {
+    if (id > MaxSnakeId) return nullptr;
+    if (id >= snakes.size()) {
+        snakes.resize(id + 1);
+        present.resize(id + 1, 0);
+    }
+    return &snakes[id];
+}
+
+bool SpectatorBoard::applyKeyframe(const std::uint8_t* pos, const std::uint8_t* end) {
+    std::uint64_t newTick, w, h, count;
+    if (!readVarint(pos, end, newTick) || !readVarint(pos, end, w) ||
+        !readVarint(pos, end, h) || !readVarint(pos, end, count)) {
+        return false;
+    }
+    if (w == 0 || h == 0 || w * h > MaxBoardCells) return false;
+
+    width = static_cast<int>(w);
+    height = static_cast<int>(h);
+    tick = newTick;
+    food.assign(w * h, 0);
+    for (auto& body : snakes) body.clear();
+    present.assign(present.size(), 0);
+
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::uint64_t id, length;
+        if (!readVarint(pos, end, id) || !readVarint(pos, end, length)) return false;
+        auto* body = snakeFor(id);
+        if (!body || length > food.size()) return false;
+        for (std::uint64_t s = 0; s < length; ++s) {
+            std::uint64_t cell;
+            if (!readVarint(pos, end, cell) || !validCell(cell)) return false;
+            body->push_back(static_cast<std::uint32_t>(cell));
+        }
+        present[id] = 1;
+    }
+
+    std::uint64_t foodCount;
+    if (!readVarint(pos, end, foodCount)) return false;
+    for (std::uint64_t i = 0; i < foodCount; ++i) {
+        std::uint64_t cell;
+        if (!readVarint(pos, end, cell) || !validCell(cell)) return false;
+        food[cell] = 1;
+    }
+
+    synced = true;
+    return true;
+}
+
+bool SpectatorBoard::applyTick(const std::uint8_t* pos, const std::uint8_t* end) {
+    std::uint64_t newTick, count;
+    if (!readVarint(pos, end, newTick) || !readVarint(pos, end, count)) return false;
+    tick = newTick;
+
+    for (std::uint64_t i = 0; i < count; ++i) {
+        if (pos == end) return false;
+        const auto op = static_cast<SpectatorOp>(*pos++);
+        std::uint64_t id, cell, length;
+
+        switch (op) {
+            case SpectatorOp::HeadAdded: {
+                if (!readVarint(pos, end, id) || !readVarint(pos, end, cell) || !validCell(cell)) return false;
+                auto* body = snakeFor(id);
+                if (!body) return false;
+                body->push_front(static_cast<std::uint32_t>(cell));
+                break;
+            }
+            case SpectatorOp::TailRemoved: {
+                if (!readVarint(pos, end, id)) return false;
+                auto* body = snakeFor(id);
+                if (!body) return false;
+                if (!body->empty()) body->pop_back();
+                break;
+            }
+            case SpectatorOp::SnakeSpawned: {
+                if (!readVarint(pos, end, id) || !readVarint(pos, end, length)) return false;
+                auto* body = snakeFor(id);
+                if (!body || length > food.size()) return false;
+                body->clear();
+                for (std::uint64_t s = 0; s < length; ++s) {
+                    if (!readVarint(pos, end, cell) || !validCell(cell)) return false;
+                    body->push_back(static_cast<std::uint32_t>(cell));
+                }
+                present[id] = 1;
+                break;
+            }
+            case SpectatorOp::SnakeRemoved: {
+                if (!readVarint(pos, end, id)) return false;
+                auto* body = snakeFor(id);
+                if (!body) return false;
+                body->clear();
+                present[id] = 0;
+                break;
+            }
+            case SpectatorOp::FoodAdded:
+            case SpectatorOp::FoodRemoved:
+                if (!readVarint(pos, end, cell) || !validCell(cell)) return false;
+                food[cell] = op == SpectatorOp::FoodAdded ? 1 : 0;
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,341 @@
+#include "spectator/SpectatorPublisher.hpp"
+#include "GameSession.hpp"
+#include "Arena.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifdef MSG_NOSIGNAL
+constexpr int SendFlags = MSG_NOSIGNAL | MSG_DONTWAIT;
+#else
+constexpr int SendFlags = MSG_DONTWAIT;
+#endif
+
+namespace {
+    // Event counts are written as a padded varint of this width and patched in once known
+    constexpr std::size_t CountPlaceholderBytes = 5;
+
+    void patchVarint(std::vector<std::uint8_t>& out, std::size_t at, std::uint64_t value) {
+        for (std::size_t i = 0; i < CountPlaceholderBytes; ++i) {
+            auto byte = static_cast<std::uint8_t>(value & 0x7F);
+            value >>= 7;
+            if (i + 1 < CountPlaceholderBytes) byte |= 0x80;
+            out[at + i] = byte;
+        }
+    }
+
+    std::uint32_t cellOf(const sf::Vector2i& pos, int width) {
+        return static_cast<std::uint32_t>(pos.y * width + pos.x);
+    }
+
+    bool inBounds(const sf::Vector2i& pos, int width, int height) {
+        return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height;
+    }
+
+    template <typename SnakeType>
+    void writeSnake(std::vector<std::uint8_t>& out, std::uint32_t id, const SnakeType& snake, int width) {
+        writeVarint(out, id);
+        writeVarint(out, snake.length());
+        snake.forEachSegment([&](const sf::Vector2i& segment) {
+            writeVarint(out, cellOf(segment, width));
+        });
+    }
+}
+
+SpectatorPublisher::SpectatorPublisher(const std::string& socketPath)
+    : path(socketPath)
+    , listenFd(-1)
+    , foodCell(0)
+    , lastTick(0)
+    , deltaEvents(0)
+    , deltaCountAt(0)
+{
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Spectator socket path too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("Failed to create spectator socket");
+    }
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listenFd, 16) != 0) {
+        close(listenFd);
+        throw std::runtime_error("Failed to listen on spectator socket: " + path);
+    }
+    fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+}
+
+SpectatorPublisher::~SpectatorPublisher() {
+    for (auto& viewer : viewers) {
+        close(viewer.fd);
+    }
+    close(listenFd);
+    unlink(path.c_str());
+}
+
+bool SpectatorPublisher::acceptViewers() {
+    for (;;) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) break;
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        Viewer viewer;
+        viewer.fd = fd;
+        viewers.push_back(std::move(viewer));
+    }
+
+    for (const auto& viewer : viewers) {
+        if (viewer.needsKeyframe) return true;
+    }
+    return false;
+}
+
+void SpectatorPublisher::resyncAll() {
+    for (auto& viewer : viewers) {
+        viewer.needsKeyframe = true;
+    }
+}
+
+void SpectatorPublisher::beginDelta(std::uint64_t tick) {
+    delta.clear();
+    delta.push_back(static_cast<std::uint8_t>(SpectatorFrameType::Tick));
+    writeVarint(delta, tick);
+    deltaCountAt = delta.size();
+    delta.resize(delta.size() + CountPlaceholderBytes);
+    deltaEvents = 0;
+}
+
+void SpectatorPublisher::beginKeyframe(std::uint64_t tick, int width, int height) {
+    keyframe.clear();
+    keyframe.push_back(static_cast<std::uint8_t>(SpectatorFrameType::Keyframe));
+    writeVarint(keyframe, tick);
+    writeVarint(keyframe, static_cast<std::uint64_t>(width));
+    writeVarint(keyframe, static_cast<std::uint64_t>(height));
+}
+
+template <typename SnakeType>
+void SpectatorPublisher::addSnakeSpawned(std::uint32_t id, const SnakeType& snake, int width) {
+    addEvent(SpectatorOp::SnakeSpawned);
+    writeSnake(delta, id, snake, width);
+}
+
+template <typename SnakeType>
+void SpectatorPublisher::publishSession(const BasicGameSession<SnakeType>& session) {
+    const int width = GameConfig::GRID_WIDTH;
+    const int height = GameConfig::GRID_HEIGHT;
+    const SnakeType& snake = session.getSnake();
+    const bool present = inBounds(snake.getHead(), width, height);
+    const std::uint32_t newFood = cellOf(session.getFood(), width);
+
+    bool needKeyframe = acceptViewers();
+    if (mirror.empty() || session.getTick() < lastTick) {
+        mirror.assign(1, SnakeMirror{});
+        resyncAll();
+        needKeyframe = true;
+    }
+
+    // Delta: head/tail changes of the one snake, plus the food moving
+    beginDelta(session.getTick());
+    SnakeMirror& m = mirror[0];
+    if (!present) {
+        if (m.present) {
+            addEvent(SpectatorOp::SnakeRemoved);
+            writeVarint(delta, 0);
+        }
+    } else if (!m.present) {
+        addSnakeSpawned(0, snake, width);
+    } else if (cellOf(snake.getHead(), width) != m.head) {
+        addEvent(SpectatorOp::HeadAdded);
+        writeVarint(delta, 0);
+        writeVarint(delta, cellOf(snake.getHead(), width));
+        for (std::size_t removed = m.length + 1; removed > snake.length(); --removed) {
+            addEvent(SpectatorOp::TailRemoved);
+            writeVarint(delta, 0);
+        }
+    }
+    if (newFood != foodCell) {
+        addEvent(SpectatorOp::FoodRemoved);
+        writeVarint(delta, foodCell);
+        addEvent(SpectatorOp::FoodAdded);
+        writeVarint(delta, newFood);
+    }
+
+    m.present = present;
+    m.length = snake.length();
+    m.head = present ? cellOf(snake.getHead(), width) : 0;
+    foodCell = newFood;
+    lastTick = session.getTick();
+
+    if (needKeyframe) {
+        beginKeyframe(session.getTick(), width, height);
+        writeVarint(keyframe, present ? 1 : 0);
+        if (present) writeSnake(keyframe, 0, snake, width);
+        writeVarint(keyframe, 1);
+        writeVarint(keyframe, newFood);
+    }
+    broadcast();
+}
+
+void SpectatorPublisher::publish(const GameSession& session) {
+    publishSession(session);
+}
+
+void SpectatorPublisher::publish(const CompactGameSession& session) {
+    publishSession(session);
+}
+
+void SpectatorPublisher::publish(const Arena& arena) {
+    const int width = arena.getWidth();
+    const std::size_t count = arena.snakeCount();
+
+    bool needKeyframe = acceptViewers();
+    if (mirror.size() != count || arena.getTick() < lastTick) {
+        mirror.assign(count, SnakeMirror{});
+        resyncAll();
+        needKeyframe = true;
+    }
+
+    // Delta: constant-size events per snake that moved, spawned or died
+    beginDelta(arena.getTick());
+    for (std::size_t id = 0; id < count; ++id) {
+        SnakeMirror& m = mirror[id];
+        const auto wireId = static_cast<std::uint32_t>(id);
+
+        if (!arena.isAlive(id)) {
+            if (m.present) {
+                addEvent(SpectatorOp::SnakeRemoved);
+                writeVarint(delta, wireId);
+                m.present = false;
+            }
+            continue;
+        }
+
+        const Snake& snake = arena.getSnake(id);
+        const std::uint32_t head = cellOf(snake.getHead(), width);
+        if (!m.present || m.generation != arena.getGeneration(id)) {
+            addSnakeSpawned(wireId, snake, width);
+        } else if (head != m.head) {
+            addEvent(SpectatorOp::HeadAdded);
+            writeVarint(delta, wireId);
+            writeVarint(delta, head);
+            for (std::size_t removed = m.length + 1; removed > snake.length(); --removed) {
+                addEvent(SpectatorOp::TailRemoved);
+                writeVarint(delta, wireId);
+            }
+        }
+        m.present = true;
+        m.generation = arena.getGeneration(id);
+        m.length = snake.length();
+        m.head = head;
+    }
+    for (int cell : arena.getFoodEaten()) {
+        addEvent(SpectatorOp::FoodRemoved);
+        writeVarint(delta, static_cast<std::uint64_t>(cell));
+    }
+    for (int cell : arena.getFoodSpawned()) {
+        addEvent(SpectatorOp::FoodAdded);
+        writeVarint(delta, static_cast<std::uint64_t>(cell));
+    }
+    lastTick = arena.getTick();
+
+    if (needKeyframe) {
+        beginKeyframe(arena.getTick(), width, arena.getHeight());
+        std::size_t aliveCount = 0;
+        for (std::size_t id = 0; id < count; ++id) {
+            if (arena.isAlive(id)) ++aliveCount;
+        }
+        writeVarint(keyframe, aliveCount);
+        for (std::size_t id = 0; id < count; ++id) {
+            if (arena.isAlive(id)) writeSnake(keyframe, static_cast<std::uint32_t>(id), arena.getSnake(id), width);
+        }
+
+        std::size_t foodCountAt = keyframe.size();
+        keyframe.resize(keyframe.size() + CountPlaceholderBytes);
+        std::size_t foodCount = 0;
+        for (int y = 0; y < arena.getHeight(); ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (arena.cellAt(x, y) == Arena::FoodCell) {
+                    writeVarint(keyframe, static_cast<std::uint64_t>(y * width + x));
+                    ++foodCount;
+                }
+            }
+        }
+        patchVarint(keyframe, foodCountAt, foodCount);
+    }
+    broadcast();
+}
+
+void SpectatorPublisher::broadcast() {
+    patchVarint(delta, deltaCountAt, deltaEvents);
+
+    for (std::size_t i = 0; i < viewers.size();) {
+        Viewer& viewer = viewers[i];
+        const std::vector<std::uint8_t>& frame = viewer.needsKeyframe ? keyframe : delta;
+        writeVarint(viewer.pending, frame.size());
+        viewer.pending.insert(viewer.pending.end(), frame.begin(), frame.end());
+        viewer.needsKeyframe = false;
+
+        if (!flush(viewer)) {
+            close(viewer.fd);
+            if (i + 1 != viewers.size()) {
+                viewers[i] = std::move(viewers.back());
+            }
+            viewers.pop_back();
+            continue;
+        }
+        if (viewer.pending.size() - viewer.sent > MaxBacklogBytes) {
+            dropBacklog(viewer);
+        }
+        ++i;
+    }
+}
+
+bool SpectatorPublisher::flush(Viewer& viewer) {
+    while (viewer.sent < viewer.pending.size()) {
+        ssize_t n = send(viewer.fd, viewer.pending.data() + viewer.sent,
+                         viewer.pending.size() - viewer.sent, SendFlags);
+        if (n > 0) {
+            viewer.sent += static_cast<std::size_t>(n);
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    if (viewer.sent == viewer.pending.size()) {
+        viewer.pending.clear();
+        viewer.sent = 0;
+    }
+    return true;
+}
+
+void SpectatorPublisher::dropBacklog(Viewer& viewer) {
+    // Keep the frame that is partially on the wire so the stream stays parseable
+    std::size_t keep = 0;
+    if (viewer.sent > 0) {
+        const std::uint8_t* begin = viewer.pending.data();
+        const std::uint8_t* end = begin + viewer.pending.size();
+        const std::uint8_t* pos = begin;
+        while (pos < end) {
+            std::uint64_t length;
+            if (!readVarint(pos, end, length)) break;
+            pos += length;
+            keep = static_cast<std::size_t>(pos - begin);
+            if (keep >= viewer.sent) break;
+        }
+    }
+    viewer.pending.resize(keep);
+    viewer.needsKeyframe = true;
+}
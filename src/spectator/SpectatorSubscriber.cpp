@@ -0,0 +1,76 @@
+#include "spectator/SpectatorSubscriber.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    constexpr std::size_t ReadChunkBytes = 64 * 1024;
+}
+
+SpectatorSubscriber::SpectatorSubscriber(const std::string& socketPath)
+    : path(socketPath)
+    , fd(-1) {}
+
+SpectatorSubscriber::~SpectatorSubscriber() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool SpectatorSubscriber::connect() {
+    if (fd >= 0) return true;
+
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0) return false;
+    if (::connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(sock);
+        return false;
+    }
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) | O_NONBLOCK);
+    fd = sock;
+    inbox.clear();
+    return true;
+}
+
+int SpectatorSubscriber::poll() {
+    if (fd < 0) return 0;
+
+    for (;;) {
+        const std::size_t oldSize = inbox.size();
+        inbox.resize(oldSize + ReadChunkBytes);
+        ssize_t n = recv(fd, inbox.data() + oldSize, ReadChunkBytes, 0);
+        inbox.resize(oldSize + (n > 0 ? static_cast<std::size_t>(n) : 0));
+        if (n > 0) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) break;
+
+        // End of stream or error: drop the connection, keep the last board on screen
+        close(fd);
+        fd = -1;
+        break;
+    }
+
+    int applied = 0;
+    const std::uint8_t* pos = inbox.data();
+    const std::uint8_t* end = pos + inbox.size();
+    while (pos < end) {
+        const std::uint8_t* frameStart = pos;
+        std::uint64_t length;
+        if (!readVarint(pos, end, length) || length > static_cast<std::uint64_t>(end - pos)) {
+            pos = frameStart;
+            break;
+        }
+        board.applyFrame(pos, static_cast<std::size_t>(length));
+        pos += length;
+        ++applied;
+    }
+    inbox.erase(inbox.begin(), inbox.begin() + (pos - inbox.data()));
+    return applied;
+}
@@ -4,20 +4,34 @@
 #include "StateMachine.hpp"
 #include "GameConfig.hpp"
 #include "states/StateFactory.hpp"
+#include "runlog/RunLog.hpp"
+#include <cstdio>
 
 GameOverState::GameOverState(GameController* controller, const GameResources& resources, StateMachine* machine)
     : State(controller, resources, machine) {
-    
-    gameOverText.setFont(resources.font);
-    gameOverText.setString("GAME OVER");
-    gameOverText.setCharacterSize(50);
-    gameOverText.setFillColor(sf::Color::Red);
-    
-    sf::FloatRect textBounds = gameOverText.getLocalBounds();
-    gameOverText.setPosition(
-        (GameConfig::GRID_WIDTH * GameConfig::CELL_SIZE - textBounds.width) / 2,
-        (GameConfig::GRID_HEIGHT * GameConfig::CELL_SIZE - textBounds.height) / 2
-    );
+}
+
+void GameOverState::setResult(int score, RunLog* log) {
+    scoreText = "Score: " + std::to_string(score);
+    details.clear();
+    if (!log) {
+        return;
+    }
+
+    // Picks up the games other instances logged too
+    log->refresh();
+    char line[96];
+    std::snprintf(line, sizeof(line), "Rank %llu of %llu   median %d   best %d",
+                  static_cast<unsigned long long>(log->rank(score)),
+                  static_cast<unsigned long long>(log->size()), log->scoreAt(0.5), log->scoreAt(1.0));
+    details.push_back(line);
+
+    const std::vector<RunRecord> best = log->top(TopRuns);
+    for (std::size_t i = 0; i < best.size(); ++i) {
+        std::snprintf(line, sizeof(line), "%zu.  %d  %.24s  %llu ticks", i + 1, best[i].score, best[i].agent,
+                      static_cast<unsigned long long>(best[i].ticks));
+        details.push_back(line);
+    }
 }
 
 void GameOverState::handleInput(const sf::Event& event) {
@@ -29,12 +43,29 @@ void GameOverState::handleInput(const sf::Event& event) {
 }
 
 void GameOverState::update() {
-    // Nothing to update in game over state
+    StateFactory::preloadState(StateType::Menu, gameController, resources, stateMachine);
+}
+
+void GameOverState::render(FrameSnapshot& frame) const {
+    describe(scoreText, frame, details);
 }
 
-void GameOverState::render(sf::RenderWindow& window) {
-    window.draw(gameOverText);
-    window.draw(scoreText);
+void GameOverState::describe(std::string_view scoreText, FrameSnapshot& frame,
+                             const std::vector<std::string>& detailLines) {
+    frame.addText("GAME OVER", 50, sf::Color::Red,
+                  sf::Vector2f(GameConfig::WindowWidth() / 2.0f, GameConfig::WindowHeight() / 2.0f),
+                  TextAnchor::Center);
+    if (!scoreText.empty()) {
+        frame.addText(scoreText, 30, sf::Color::White,
+                      sf::Vector2f(GameConfig::WindowWidth() / 2.0f, GameConfig::WindowHeight() * 0.6f),
+                      TextAnchor::TopCenter);
+    }
+    for (std::size_t i = 0; i < detailLines.size(); ++i) {
+        frame.addText(detailLines[i], 18, i == 0 ? sf::Color::Yellow : sf::Color::White,
+                      sf::Vector2f(GameConfig::WindowWidth() / 2.0f,
+                                   GameConfig::WindowHeight() * 0.6f + 44.0f + 24.0f * static_cast<float>(i)),
+                      TextAnchor::TopCenter);
+    }
 }
 
 void GameOverState::pause() {
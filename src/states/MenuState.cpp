@@ -7,56 +7,20 @@
 #include "GameConfig.hpp"
 
 MenuState::MenuState(GameController* controller, const GameResources& resources, StateMachine* machine) 
-    : State(controller, resources, machine), selectedOption(0) {
-    // Title setup
-    titleText.setFont(resources.font);
-    titleText.setString("SNAKE GAME");
-    titleText.setCharacterSize(50);
-    titleText.setFillColor(sf::Color::Green);
-    
-    // Center the title
-    sf::FloatRect textBounds = titleText.getLocalBounds();
-    titleText.setPosition(
-        (GameConfig::GRID_WIDTH * GameConfig::CELL_SIZE - textBounds.width) / 2,
-        GameConfig::GRID_HEIGHT * GameConfig::CELL_SIZE * 0.2f
-    );
-
-    // Menu options setup
-    std::vector<std::string> options = {"Play", "Quit"};
-    for (size_t i = 0; i < options.size(); ++i) {
-        sf::Text option;
-        option.setFont(resources.font);
-        option.setString(options[i]);
-        option.setCharacterSize(30);
-        option.setFillColor(sf::Color::White);
-        
-        // Center each option
-        textBounds = option.getLocalBounds();
-        option.setPosition(
-            (GameConfig::GRID_WIDTH * GameConfig::CELL_SIZE - textBounds.width) / 2,
-            GameConfig::GRID_HEIGHT * GameConfig::CELL_SIZE * (0.4f + i * 0.1f)
-        );
-        
-        menuOptions.push_back(option);
-    }
-    
-    // Highlight initial selection
-    menuOptions[selectedOption].setFillColor(sf::Color::Green);
+    : State(controller, resources, machine)
+    , menuOptions{"Play", "Arena", "Quit"}
+    , selectedOption(0) {
 }
 
 void MenuState::handleInput(const sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         switch (event.key.code) {
             case sf::Keyboard::Up:
-                menuOptions[selectedOption].setFillColor(sf::Color::White);
                 selectedOption = (selectedOption - 1 + menuOptions.size()) % menuOptions.size();
-                menuOptions[selectedOption].setFillColor(sf::Color::Green);
                 break;
                 
             case sf::Keyboard::Down:
-                menuOptions[selectedOption].setFillColor(sf::Color::White);
                 selectedOption = (selectedOption + 1) % menuOptions.size();
-                menuOptions[selectedOption].setFillColor(sf::Color::Green);
                 break;
                 
             case sf::Keyboard::Enter:
@@ -66,6 +30,11 @@ void MenuState::handleInput(const sf::Event& event) {
                             gameController, resources, stateMachine)
                     );
                 } else if (selectedOption == 1) {
+                    stateMachine->replaceState(
+                        StateFactory::createState(StateType::Arena, 
+                            gameController, resources, stateMachine)
+                    );
+                } else if (selectedOption == 2) {
                     // Handle quit through GameController
                     gameController->quitGame();
                 }
@@ -75,14 +44,25 @@ void MenuState::handleInput(const sf::Event& event) {
 }
 
 void MenuState::update() {
-    // Update menu animations if any
+    // Build the highlighted game mode in the background so Enter switches instantly
+    if (selectedOption == 0) {
+        StateFactory::preloadState(StateType::Playing, gameController, resources, stateMachine);
+    } else if (selectedOption == 1) {
+        StateFactory::preloadState(StateType::Arena, gameController, resources, stateMachine);
+    }
 }
 
-void MenuState::render(sf::RenderWindow& window) {
-    // Just draw elements, no clear/display
-    window.draw(titleText);
-    for (const auto& option : menuOptions) {
-        window.draw(option);
+void MenuState::render(FrameSnapshot& frame) const {
+    const float centerX = GameConfig::WindowWidth() / 2.0f;
+    frame.addText("SNAKE GAME", 50, sf::Color::Green,
+                  sf::Vector2f(centerX, GameConfig::WindowHeight() * 0.2f), TextAnchor::TopCenter);
+
+    // Selected option is highlighted
+    for (size_t i = 0; i < menuOptions.size(); ++i) {
+        frame.addText(menuOptions[i], 30,
+                      static_cast<int>(i) == selectedOption ? sf::Color::Green : sf::Color::White,
+                      sf::Vector2f(centerX, GameConfig::WindowHeight() * (0.4f + i * 0.1f)),
+                      TextAnchor::TopCenter);
     }
 }
 
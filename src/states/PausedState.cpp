@@ -5,16 +5,6 @@
 
 PausedState::PausedState(GameController* controller, const GameResources& resources, StateMachine* machine)
     : State(controller, resources, machine) {
-    pausedText.setFont(resources.font);
-    pausedText.setString("PAUSED");
-    pausedText.setCharacterSize(50);
-    pausedText.setFillColor(sf::Color::White);
-    
-    sf::FloatRect textBounds = pausedText.getLocalBounds();
-    pausedText.setPosition(
-        (GameConfig::GRID_WIDTH * GameConfig::CELL_SIZE - textBounds.width) / 2,
-        (GameConfig::GRID_HEIGHT * GameConfig::CELL_SIZE - textBounds.height) / 2
-    );
 }
 
 void PausedState::handleInput(const sf::Event& event) {
@@ -27,6 +17,8 @@ void PausedState::update() {
     // Nothing to update in pause state
 }
 
-void PausedState::render(sf::RenderWindow& window) {
-    window.draw(pausedText);
+void PausedState::render(FrameSnapshot& frame) const {
+    frame.addText("PAUSED", 50, sf::Color::White,
+                  sf::Vector2f(GameConfig::WindowWidth() / 2.0f, GameConfig::WindowHeight() / 2.0f),
+                  TextAnchor::Center);
 }
\ No newline at end of file
@@ -5,83 +5,314 @@
 #include "StateMachine.hpp"
 #include "GameConfig.hpp"
 #include "states/StateFactory.hpp"
+#include "SnakeColors.hpp"
+#include "metrics/AllocationTracker.hpp"
+#include "agents/ControllerRegistry.hpp"
+#include "Bitboard.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
 
-PlayingState::PlayingState(GameController* controller, const GameResources& resources, StateMachine* machine)
+namespace {
+    constexpr std::uint64_t RewindJump = 100;   // Ticks skipped by Up/Down while rewinding
+}
+
+PlayingState::PlayingState(GameController* controller, const GameResources& resources, StateMachine* machine,
+                           PlayMode playMode)
     : State(controller, resources, machine)
-    , snake(GameConfig::GRID_WIDTH / 2, GameConfig::GRID_HEIGHT / 2)
-    , rng(std::random_device{}())
+    , mode(playMode)
+    , inputLatency(MetricsRegistry::instance().histogram(
+          "snaike_input_to_move_us", "Time from polling a turn key to the tick that moves that way, microseconds"))
+    , droppedCommands(MetricsRegistry::instance().counter(
+          "snaike_input_commands_dropped_total", "Turn commands dropped because the command queue was full"))
 {
-    spawnFood();
-}
-
-void PlayingState::spawnFood() {
-    std::uniform_int_distribution<int> disX(0, GameConfig::GRID_WIDTH - 1);
-    std::uniform_int_distribution<int> disY(0, GameConfig::GRID_HEIGHT - 1);
-    bool validPosition;
-    do {
-        food.x = disX(rng);
-        food.y = disY(rng);
-        validPosition = true;
-        
-        for (const auto& segment : snake.getBody()) {
-            if (segment.x == food.x && segment.y == food.y) {
-                validPosition = false;
-                break;
-            }
+    if (mode == PlayMode::Arena) {
+        ArenaFoodRules rules;
+        rules.lifetime = GameConfig::ARENA_FOOD_LIFETIME;
+        rules.bonusChance = GameConfig::ARENA_BONUS_CHANCE;
+        rules.bonusWeight = GameConfig::ARENA_BONUS_WEIGHT;
+        arena = std::make_unique<Arena>(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT,
+                                        GameConfig::ARENA_BOTS + 1, GameConfig::ARENA_FOOD,
+                                        controller ? controller->nextGameSeed() : randomSeed(), rules);
+        arena->setAutopilot(0, false);  // Snake 0 belongs to the player
+    } else {
+        // A known seed, so recorded games can be replayed
+        gameSeed = controller ? controller->nextGameSeed() : randomSeed();
+        if (const LevelPack* levels = controller ? controller->getLevelPack() : nullptr) {
+            session.setLevel(levels->levelForSeed(gameSeed));
         }
-    } while (!validPosition);
+        session.reset(gameSeed);
+        if (controller && !controller->getAgent().empty()) {
+            autopilot = ControllerRegistry::create(controller->getAgent());
+            autopilot->reset(controller->nextGameSeed());
+        }
+        if (controller) {
+            trajectories = controller->getTrajectoryWriter();
+        }
+    }
+    if (mode == PlayMode::Classic) {
+        history = std::make_unique<RewindHistory>();
+        history->reset(session);
+    }
+}
+
+PlayingState::~PlayingState() {
+    if (recordedSteps) {
+        trajectories->cutOff();
+    }
+}
+
+void PlayingState::steerPlayer(Direction dir) {
+    if (arena) {
+        arena->setDirection(0, dir);
+    } else {
+        session.setDirection(dir);
+    }
+}
+
+void PlayingState::applyNextCommand() {
+    // Exactly one setDirection per tick, so the snake's direction is the one it last moved in
+    const Direction current = arena ? arena->getSnake(0).getDirection() : session.getSnake().getDirection();
+    MoveCommand command;
+    if (!commands.popTurn(current, command)) return;
+
+    steerPlayer(command.direction);
+    inputLatency.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - command.issued).count()));
+}
+
+bool PlayingState::enqueue(const MoveCommand& command) {
+    if (commands.tryPush(command)) return true;
+    droppedCommands.add();
+    return false;
 }
 
 void PlayingState::handleInput(const sf::Event& event) {
-    if (event.type == sf::Event::KeyPressed) {
+    handleTimedInput({event, std::chrono::steady_clock::now()});
+}
+
+void PlayingState::handleTimedInput(const InputEvent& input) {
+    const sf::Event& event = input.event;
+    if (event.type == sf::Event::KeyPressed && rewinding) {
+        handleRewindKey(event.key.code);
+    } else if (event.type == sf::Event::KeyPressed) {
         switch (event.key.code) {
-            case sf::Keyboard::Up: snake.setDirection(Direction::Up); break;
-            case sf::Keyboard::Down: snake.setDirection(Direction::Down); break;
-            case sf::Keyboard::Left: snake.setDirection(Direction::Left); break;
-            case sf::Keyboard::Right: snake.setDirection(Direction::Right); break;
+            case sf::Keyboard::Up: enqueue({Direction::Up, input.time}); break;
+            case sf::Keyboard::Down: enqueue({Direction::Down, input.time}); break;
+            case sf::Keyboard::Left: enqueue({Direction::Left, input.time}); break;
+            case sf::Keyboard::Right: enqueue({Direction::Right, input.time}); break;
             case sf::Keyboard::Escape:
                 stateMachine->pushState(
                     StateFactory::createState(StateType::Paused, gameController, resources, stateMachine)
                 );
                 break;
+            case sf::Keyboard::Backspace:
+                if (history) {
+                    history->seek(history->newestTick());
+                    rewinding = true;
+                }
+                break;
         }
     }
 }
 
+void PlayingState::handleRewindKey(sf::Keyboard::Key key) {
+    const std::uint64_t tick = history->viewTick();
+    switch (key) {
+        case sf::Keyboard::Left: history->stepBack(); break;
+        case sf::Keyboard::Right: history->stepForward(); break;
+        case sf::Keyboard::Up: history->seek(tick > RewindJump ? tick - RewindJump : 0); break;
+        case sf::Keyboard::Down: history->seek(tick + RewindJump); break;
+        case sf::Keyboard::Enter:
+        case sf::Keyboard::Backspace:
+            // Resuming from an earlier tick abandons the recorded branch after it
+            if (recordedSteps && history->viewTick() != history->newestTick()) {
+                trajectories->cutOff();
+            }
+            history->resume(session);
+            commands.clear();
+            rewinding = false;
+            ended = false;
+            break;
+        case sf::Keyboard::Escape:
+            rewinding = false;
+            if (ended) endGame();
+            break;
+        default: break;
+    }
+}
+
+void PlayingState::endGame() {
+    auto state = StateFactory::createState(StateType::GameOver, gameController, resources, stateMachine);
+    auto& gameOver = static_cast<GameOverState&>(*state);   // createState builds the type asked for
+
+    if (arena) {
+        gameOver.setResult(arena->getScore(0), nullptr);
+    } else {
+        gameOver.setResult(session.getScore(), gameController ? gameController->getRunLog() : nullptr);
+    }
+    stateMachine->replaceState(std::move(state));
+}
+
+void PlayingState::logRun() {
+    RunLog* log = gameController ? gameController->getRunLog() : nullptr;
+    if (!log || runLogged) return;
+    runLogged = true;
+
+    const std::string& agent = gameController->getAgent();
+    RunRecord run = RunLog::makeRecord(agent.empty() ? "keyboard" : agent);
+    run.seed = gameSeed;
+    run.ticks = session.getTick();
+    run.score = session.getScore();
+    run.length = static_cast<std::uint32_t>(session.getSnake().getBody().size());
+    run.durationMs = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startedAt).count());
+    try {
+        log->append(run);
+    } catch (const std::exception& e) {
+        // A full disk should not take the game down with it
+        std::cerr << e.what() << std::endl;
+    }
+}
+
 void PlayingState::update() {
-    snake.move();
-    
-    if (snake.checkCollision(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT)) {
-        stateMachine->replaceState(
-            StateFactory::createState(StateType::GameOver, gameController, resources, stateMachine)
-        );
+    // Both exits from a running game are built ahead of time
+    StateFactory::preloadState(StateType::Paused, gameController, resources, stateMachine);
+    StateFactory::preloadState(StateType::GameOver, gameController, resources, stateMachine);
+    if (rewinding) return;
+    if (startedAt == std::chrono::steady_clock::time_point{}) {
+        startedAt = std::chrono::steady_clock::now();
+    }
+
+    bool playerDied;
+    bool boardFilled = false;
+    {
+        // A running game must not touch the heap (see AllocationTracker)
+        AllocationScope scope(AllocPhase::Update);
+        if (autopilot) {
+            // Agents steer through the same command queue as the keyboard
+            enqueue({autopilot->decide(session), std::chrono::steady_clock::now()});
+        }
+        if (history) history->beginTick(session);
+        applyNextCommand();
+        EventBus& events = stateMachine->getEvents();
+        if (arena) {
+            const int score = arena->getScore(0);
+            arena->step();
+            playerDied = !arena->isAlive(0);
+            if (!playerDied && arena->getScore(0) > score) {
+                const sf::Vector2i& head = arena->getSnake(0).getHead();
+                events.publish(FoodEaten{arena->getTick(), head.x, head.y, arena->getScore(0)});
+            }
+            if (playerDied) events.publish(PlayerDied{arena->getTick(), arena->getScore(0)});
+        } else {
+            const sf::Vector2i food = session.getFood();
+            const std::uint64_t tick = session.getTick();
+            if (trajectories) session.writeObservation(trajectories->observation());
+            const StepOutcome outcome = session.step();
+            playerDied = outcome == StepOutcome::Died;
+            boardFilled = outcome == StepOutcome::Filled;
+            if (trajectories) {
+                recordedSteps = true;
+                trajectories->commit(session.getSnake().getDirection(), outcome == StepOutcome::Ate || boardFilled ? 1.0f : 0.0f,
+                                     playerDied || boardFilled ? TrajectoryDone::Died : TrajectoryDone::Running,
+                                     tick, gameSeed);
+            }
+            if (outcome == StepOutcome::Ate || boardFilled) {
+                events.publish(FoodEaten{session.getTick(), food.x, food.y, session.getScore()});
+            }
+            if (playerDied) {
+                events.publish(PlayerDied{session.getTick(), session.getScore()});
+            } else {
+                history->endTick(session);
+            }
+        }
+        SNAIKE_ASSERT_NO_ALLOCATIONS(scope);
+    }
+
+    if ((playerDied || boardFilled) && !arena) {
+        // Logged at the death itself, whether or not anyone ever leaves the rewind below
+        logRun();
+    }
+    if (playerDied && history && gameController && gameController->isRewindOnDeath()) {
+        // Stop on the last move so the run-up to the death can be scrubbed through
+        history->seek(history->newestTick());
+        rewinding = true;
+        ended = true;
+    } else if (playerDied || boardFilled) {
+        endGame();
+    }
+}
+
+void PlayingState::render(FrameSnapshot& frame) const {
+    if (rewinding) {
+        // A frozen debugging view, so it is not held to the no-allocation rule of running frames
+        describeBoard(session.getLevel(), history->getViewSnake(), history->getViewFood(), frame);
+        char line[96];
+        std::snprintf(line, sizeof(line), "REWIND tick %llu [%llu..%llu] score %d",
+                      static_cast<unsigned long long>(history->viewTick()),
+                      static_cast<unsigned long long>(history->oldestTick()),
+                      static_cast<unsigned long long>(history->newestTick()), history->getViewScore());
+        frame.addText(line, 18, sf::Color::Yellow, sf::Vector2f(8.0f, 8.0f));
+        frame.addText("Left/Right step  Up/Down jump  Enter resume  Esc leave", 14, sf::Color::White,
+                      sf::Vector2f(8.0f, 32.0f));
         return;
     }
 
-    if (snake.getHead().x == food.x && snake.getHead().y == food.y) {
-        snake.grow();
-        spawnFood();
+    AllocationScope scope(AllocPhase::Snapshot);
+    if (arena) {
+        describeArena(*arena, frame);
+    } else {
+        describeSession(session, frame);
     }
+    SNAIKE_ASSERT_NO_ALLOCATIONS(scope);
+}
+
+void PlayingState::describeSession(const GameSession& session, FrameSnapshot& frame) {
+    describeBoard(session.getLevel(), session.getSnake(), session.getFood(), frame);
 }
 
-void PlayingState::render(sf::RenderWindow& window) {
-    // Draw snake
+void PlayingState::describeBoard(const Level& level, const Snake& snake, const sf::Vector2i& food,
+                                 FrameSnapshot& frame) {
+    // Walls
+    if (!level.isOpen()) {
+        for (int i = 0; i < (GameSession::ObservationSize + 63) / 64; ++i) {
+            for (std::uint64_t word = level.walls[i]; word != 0; word &= word - 1) {
+                const int cell = i * 64 + lowestBit(word);
+                frame.addCell(cell % GameConfig::GRID_WIDTH, cell / GameConfig::GRID_WIDTH, sf::Color(110, 110, 110));
+            }
+        }
+    }
+
+    // Snake
     for (const auto& segment : snake.getBody()) {
-        sf::RectangleShape segmentShape(sf::Vector2f(GameConfig::CELL_SIZE - 2, GameConfig::CELL_SIZE - 2));
-        segmentShape.setPosition(segment.x * GameConfig::CELL_SIZE + 1, segment.y * GameConfig::CELL_SIZE + 1);
-        segmentShape.setFillColor(sf::Color::Green);
-        window.draw(segmentShape);
+        frame.addCell(segment.x, segment.y, sf::Color::Green);
     }
     
-    // Draw food
-    sf::RectangleShape foodShape(sf::Vector2f(GameConfig::CELL_SIZE - 2, GameConfig::CELL_SIZE - 2));
-    foodShape.setPosition(food.x * GameConfig::CELL_SIZE + 1, food.y * GameConfig::CELL_SIZE + 1);
-    foodShape.setFillColor(sf::Color::Red);
-    window.draw(foodShape);
+    // Food
+    frame.addCell(food.x, food.y, sf::Color::Red);
+}
+
+void PlayingState::describeArena(const Arena& arena, FrameSnapshot& frame) {
+    for (int y = 0; y < arena.getHeight(); ++y) {
+        for (int x = 0; x < arena.getWidth(); ++x) {
+            const std::uint16_t owner = arena.cellAt(x, y);
+            if (owner == Arena::NoOwner) continue;
+
+            if (owner == Arena::FoodCell) {
+                // Bonus food is gold
+                const bool bonus = arena.getFood().weightAt(y * arena.getWidth() + x) > 1;
+                frame.addCell(x, y, bonus ? sf::Color(255, 200, 0) : sf::Color::Red);
+            } else {
+                frame.addCell(x, y, snakeColor(owner - 1));
+            }
+        }
+    }
 }
 
 void PlayingState::pause() {
-    // Save game state or pause game logic if needed
+    // Turns queued before the pause would fire unexpectedly on resume
+    commands.clear();
 }
 
 void PlayingState::resume() {
@@ -0,0 +1,54 @@
+#include "states/SpectatorState.hpp"
+#include "GameController.hpp"
+#include "StateMachine.hpp"
+#include "SnakeColors.hpp"
+#include <string>
+
+SpectatorState::SpectatorState(GameController* controller, const GameResources& resources, StateMachine* machine)
+    : State(controller, resources, machine)
+    , subscriber(controller->getSpectateSource())
+{
+}
+
+void SpectatorState::handleInput(const sf::Event& event) {
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
+        gameController->quitGame();
+    }
+}
+
+void SpectatorState::update() {
+    if (!subscriber.isConnected() && !subscriber.connect()) {
+        statusText = "Waiting for " + gameController->getSpectateSource();
+        return;
+    }
+    subscriber.poll();
+
+    const SpectatorBoard& board = subscriber.getBoard();
+    statusText = board.isSynced()
+        ? "Tick " + std::to_string(board.getTick())
+        : "Waiting for keyframe";
+}
+
+void SpectatorState::render(FrameSnapshot& frame) const {
+    const SpectatorBoard& board = subscriber.getBoard();
+    if (board.isSynced()) {
+        // The renderer fits the published board into the window, whatever its size
+        const int width = board.getWidth();
+        frame.boardWidth = width;
+        frame.boardHeight = board.getHeight();
+
+        const auto& food = board.getFood();
+        for (std::uint32_t i = 0; i < food.size(); ++i) {
+            if (food[i]) frame.addCell(i % width, i / width, sf::Color::Red);
+        }
+
+        for (std::size_t id = 0; id < board.snakeSlots(); ++id) {
+            if (!board.hasSnake(id)) continue;
+            const sf::Color color = snakeColor(id);
+            for (std::uint32_t index : board.getSnakeCells(id)) {
+                frame.addCell(index % width, index / width, color);
+            }
+        }
+    }
+    frame.addText(statusText, 16, sf::Color::White, sf::Vector2f(4, 2));
+}
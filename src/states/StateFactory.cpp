@@ -4,8 +4,13 @@
 #include "states/PausedState.hpp"
 #include "states/GameOverState.hpp"
 #include "GameResources.hpp"
+#include "StateMachine.hpp"
+#include <future>
+#ifdef SNAIKE_SPECTATOR
+#include "states/SpectatorState.hpp"
+#endif
 
-std::unique_ptr<State> StateFactory::createState(
+std::unique_ptr<State> StateFactory::buildState(
     StateType type,
     GameController* controller,
     const GameResources& resources,
@@ -16,11 +21,44 @@ std::unique_ptr<State> StateFactory::createState(
             return std::make_unique<MenuState>(controller, resources, machine);
         case StateType::Playing:
             return std::make_unique<PlayingState>(controller, resources, machine);
+        case StateType::Arena:
+            return std::make_unique<PlayingState>(controller, resources, machine, PlayMode::Arena);
         case StateType::Paused:
             return std::make_unique<PausedState>(controller, resources, machine);
         case StateType::GameOver:
             return std::make_unique<GameOverState>(controller, resources, machine);
+#ifdef SNAIKE_SPECTATOR
+        case StateType::Spectator:
+            return std::make_unique<SpectatorState>(controller, resources, machine);
+#endif
         default:
             throw std::runtime_error("Unknown state type");
     }
-}
\ No newline at end of file
+}
+
+std::unique_ptr<State> StateFactory::createState(
+    StateType type,
+    GameController* controller,
+    const GameResources& resources,
+    StateMachine* machine
+) {
+    if (machine) {
+        if (auto state = machine->takePreload(type)) {
+            return state;
+        }
+    }
+    return buildState(type, controller, resources, machine);
+}
+
+void StateFactory::preloadState(
+    StateType type,
+    GameController* controller,
+    const GameResources& resources,
+    StateMachine* machine
+) {
+    if (machine->hasPreload(type)) {
+        return;
+    }
+    machine->addPreload(type, std::async(std::launch::async, &StateFactory::buildState,
+                                         type, controller, std::cref(resources), machine));
+}
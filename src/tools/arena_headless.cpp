@@ -0,0 +1,81 @@
+#include "Arena.hpp"
+#include "GameConfig.hpp"
+#include "spectator/SpectatorPublisher.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace {
+    std::atomic<bool> running{true};
+
+    void handleSignal(int) {
+        running = false;
+    }
+}
+
+// Usage: arena_headless <spectator-socket> [width] [height] [snakes] [food] [ticks-per-second]
+//                       [food-lifetime] [bonus-chance]
+//
+// Runs an all-autopilot arena without a window and publishes it for
+// viewers (main --spectate <socket>). A tick rate of 0 runs uncapped.
+// Food lives food-lifetime ticks (0 = until eaten), and one item in
+// bonus-chance is worth GameConfig::ARENA_BONUS_WEIGHT.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <spectator-socket> [width] [height] [snakes] [food] [ticks-per-second]"
+                  << " [food-lifetime] [bonus-chance]" << std::endl;
+        return 1;
+    }
+    const int width = argc > 2 ? std::atoi(argv[2]) : 160;
+    const int height = argc > 3 ? std::atoi(argv[3]) : 120;
+    const auto snakes = static_cast<std::size_t>(argc > 4 ? std::atol(argv[4]) : 200);
+    const int food = argc > 5 ? std::atoi(argv[5]) : 100;
+    const int tickRate = argc > 6 ? std::atoi(argv[6]) : 30;
+    ArenaFoodRules rules;
+    rules.lifetime = static_cast<std::uint32_t>(argc > 7 ? std::atol(argv[7]) : 0);
+    rules.bonusChance = static_cast<std::uint32_t>(argc > 8 ? std::atol(argv[8]) : 0);
+    rules.bonusWeight = GameConfig::ARENA_BONUS_WEIGHT;
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    try {
+        Arena arena(width, height, snakes, food, randomSeed(), rules);
+        SpectatorPublisher publisher(argv[1]);
+        std::cout << "Arena " << width << "x" << height << " with " << snakes
+                  << " snakes, publishing on " << argv[1] << std::endl;
+
+        using Clock = std::chrono::steady_clock;
+        const auto tickInterval = tickRate > 0
+            ? std::chrono::nanoseconds(1000000000LL / tickRate)
+            : std::chrono::nanoseconds(0);
+        auto nextTick = Clock::now();
+        auto reportAt = Clock::now() + std::chrono::seconds(1);
+        long ticksSinceReport = 0;
+
+        while (running) {
+            arena.step();
+            publisher.publish(arena);
+            ++ticksSinceReport;
+
+            if (Clock::now() >= reportAt) {
+                std::cout << ticksSinceReport << " ticks/s, "
+                          << publisher.viewerCount() << " viewers" << std::endl;
+                ticksSinceReport = 0;
+                reportAt += std::chrono::seconds(1);
+            }
+            if (tickRate > 0) {
+                nextTick += tickInterval;
+                std::this_thread::sleep_until(nextTick);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
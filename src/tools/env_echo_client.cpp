@@ -0,0 +1,85 @@
+#include "env/EnvClient.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Usage: env_echo_client [shm-name] [steps]
+//
+// Round-trips single actions through the server, checks that every result
+// echoes the game it was sent to and that its tick advanced, then reports
+// step latency. Finishes with a batched pass that keeps every game in flight.
+int main(int argc, char** argv) {
+    const std::string name = argc > 1 ? argv[1] : SharedEnvDefaultName;
+    const long steps = argc > 2 ? std::strtol(argv[2], nullptr, 10) : 100000;
+
+    try {
+        EnvClient client(name);
+        const std::uint32_t numEnvs = client.numEnvs();
+        std::cout << "Connected to " << name << ": " << numEnvs << " games, "
+                  << client.gridWidth() << "x" << client.gridHeight() << " board" << std::endl;
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<std::uint32_t> pickAction(0, 3);
+        std::vector<std::uint64_t> lastTick(numEnvs, 0);
+        std::vector<double> latencies;
+        latencies.reserve(static_cast<std::size_t>(steps));
+        long mismatches = 0;
+        long episodes = 0;
+
+        for (std::uint32_t i = 0; i < numEnvs; ++i) {
+            client.step(i, EnvActionReset);
+        }
+
+        for (long s = 0; s < steps; ++s) {
+            const std::uint32_t env = static_cast<std::uint32_t>(s % numEnvs);
+            auto start = std::chrono::steady_clock::now();
+            EnvStepResult result = client.step(env, pickAction(rng));
+            auto end = std::chrono::steady_clock::now();
+            latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+
+            if (result.status != EnvStatusOk || result.envIndex != env || result.tick != lastTick[env] + 1) {
+                ++mismatches;
+            }
+            if (result.done) {
+                ++episodes;
+                lastTick[env] = 0;
+            } else {
+                lastTick[env] = result.tick;
+            }
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double p) {
+            return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))];
+        };
+        std::cout << "Single-step round trip (us): min " << percentile(0.0)
+                  << "  p50 " << percentile(0.5)
+                  << "  p99 " << percentile(0.99)
+                  << "  max " << percentile(1.0) << std::endl;
+
+        // Batched: one action per game in flight, then drain all results
+        const int rounds = 100;
+        auto batchStart = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (std::uint32_t i = 0; i < numEnvs; ++i) {
+                client.send(i, pickAction(rng));
+            }
+            for (std::uint32_t i = 0; i < numEnvs; ++i) {
+                EnvStepResult result = client.receive();
+                if (result.status != EnvStatusOk || result.envIndex >= numEnvs) ++mismatches;
+                if (result.done) ++episodes;
+            }
+        }
+        double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStart).count();
+        std::cout << "Batched throughput: " << (rounds * numEnvs) / batchSeconds << " steps/s" << std::endl;
+        std::cout << "Episodes finished: " << episodes << ", mismatched results: " << mismatches << std::endl;
+
+        return mismatches == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,43 @@
+#include "env/EnvServer.hpp"
+#include "spectator/SpectatorPublisher.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+namespace {
+    EnvServer* activeServer = nullptr;
+
+    void handleSignal(int) {
+        if (activeServer) {
+            activeServer->stop();
+        }
+    }
+}
+
+// Usage: env_server [shm-name] [num-games] [seed] [spectator-socket]
+int main(int argc, char** argv) {
+    const std::string name = argc > 1 ? argv[1] : SharedEnvDefaultName;
+    const auto numEnvs = static_cast<std::uint32_t>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64);
+    const std::uint64_t seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+
+    try {
+        EnvServer server(name, numEnvs, seed);
+        std::unique_ptr<SpectatorPublisher> spectator;
+        if (argc > 4) {
+            spectator = std::make_unique<SpectatorPublisher>(argv[4]);
+            server.setSpectator(spectator.get());
+        }
+        activeServer = &server;
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        std::cout << "Serving " << numEnvs << " games on " << name << std::endl;
+        server.run();
+        activeServer = nullptr;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "levels/LevelPack.hpp"
+#include "Bitboard.hpp"
+#include "GameConfig.hpp"
+#include "Random.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " --out PACK [options] [level.txt ...]\n"
+                  << "       " << program << " --info PACK [--show I]\n"
+                  << "  --out PACK           write the text levels and generated levels to PACK\n"
+                  << "  --generate N         add N random obstacle levels of the game board size\n"
+                  << "  --seed S             generator seed (default 1)\n"
+                  << "  --density P          wall percentage of generated levels (default 10)\n"
+                  << "  --info PACK          open PACK and print its size and open time\n"
+                  << "  --show I             also print level I as text\n"
+                  << "Text levels: '#' wall, 'S' snake head (body trails left), anything else free.\n";
+    }
+
+    /**
+     * @brief Random wall segments around a clear spawn, with every free cell reachable
+     */
+    LevelSource generateLevel(GameRng& rng, BitboardGrid& grid, int density) {
+        const int width = GameConfig::GRID_WIDTH;
+        const int height = GameConfig::GRID_HEIGHT;
+        const sf::Vector2i spawn(width / 2, height / 2);
+        const int wallTarget = width * height * density / 100;
+
+        for (;;) {
+            LevelSource level{Bitboard(width, height), spawn};
+            int walls = 0;
+            while (walls < wallTarget) {
+                const bool horizontal = rng.bounded(2) == 0;
+                const int length = 3 + static_cast<int>(rng.bounded(8));
+                int x = static_cast<int>(rng.bounded(width));
+                int y = static_cast<int>(rng.bounded(height));
+                for (int i = 0; i < length && x < width && y < height; ++i) {
+                    // Keep the snake's body and the cells around its first moves clear
+                    const bool nearSpawn = std::abs(x - spawn.x) <= 3 && std::abs(y - spawn.y) <= 1;
+                    const int cell = y * width + x;
+                    if (!nearSpawn && !level.walls.test(cell)) {
+                        level.walls.set(cell);
+                        ++walls;
+                    }
+                    if (horizontal) ++x; else ++y;
+                }
+            }
+
+            // Reject levels with pockets food could spawn in but the snake never reach
+            Bitboard open(width, height);
+            open.fill();
+            open.andNot(level.walls);
+            const int freeCount = open.count();
+            if (grid.reachableArea(spawn.y * width + spawn.x, open) + 1 == freeCount) {
+                return level;
+            }
+        }
+    }
+
+    void showLevel(const Level& level) {
+        for (int y = 0; y < level.height; ++y) {
+            std::string row(static_cast<std::size_t>(level.width), '.');
+            for (int x = 0; x < level.width; ++x) {
+                if (level.isWall(y * level.width + x)) row[x] = '#';
+            }
+            if (y == level.spawn.y) row[level.spawn.x] = 'S';
+            std::cout << row << "\n";
+        }
+    }
+}
+
+// Builds and inspects level packs, e.g. 2000 random levels for a sweep:
+//   level_pack --out sweep.pack --generate 2000 --density 12
+//   tournament --levels sweep.pack --seeds 2000
+int main(int argc, char** argv) {
+    std::string outPath;
+    std::string infoPath;
+    std::vector<std::string> textLevels;
+    std::uint32_t generate = 0;
+    std::uint64_t seed = 1;
+    int density = 10;
+    long show = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+            outPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--generate") == 0 && hasValue) {
+            generate = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--density") == 0 && hasValue) {
+            density = static_cast<int>(std::strtol(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--info") == 0 && hasValue) {
+            infoPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--show") == 0 && hasValue) {
+            show = std::strtol(argv[++i], nullptr, 10);
+        } else if (argv[i][0] != '-') {
+            textLevels.push_back(argv[i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (outPath.empty() == infoPath.empty() || density < 0 || density > 60) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        if (!outPath.empty()) {
+            std::vector<LevelSource> levels;
+            for (const auto& path : textLevels) {
+                std::ifstream in(path);
+                if (!in) throw std::runtime_error("Cannot read " + path);
+                std::stringstream text;
+                text << in.rdbuf();
+                levels.push_back(LevelPack::parse(text.str()));
+            }
+            GameRng rng(seed);
+            BitboardGrid grid(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT);
+            for (std::uint32_t i = 0; i < generate; ++i) {
+                levels.push_back(generateLevel(rng, grid, density));
+            }
+            LevelPack::write(outPath, levels);
+            std::cout << "wrote " << levels.size() << " levels to " << outPath << std::endl;
+            return 0;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const LevelPack pack(infoPath);
+        const double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        std::cout << pack.levelCount() << " levels of " << pack.getWidth() << "x" << pack.getHeight()
+                  << ", opened in " << micros << " us" << std::endl;
+        if (show >= 0) {
+            if (show >= static_cast<long>(pack.levelCount())) throw std::runtime_error("No such level");
+            const Level level = pack.level(static_cast<std::uint32_t>(show));
+            std::cout << "level " << show << ": " << level.freeCount << " free cells\n";
+            showLevel(level);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
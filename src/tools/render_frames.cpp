@@ -0,0 +1,213 @@
+#include "agents/ControllerRegistry.hpp"
+#include "render/ImageWriter.hpp"
+#include "render/SoftwareRenderer.hpp"
+#include "states/GameOverState.hpp"
+#include "states/PlayingState.hpp"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --replay AGENT:SEED  classic game played by a controller (default flood:1)\n"
+                  << "  --arena SNAKES:SEED  all-autopilot arena game instead\n"
+                  << "  --ticks T            stop after T ticks (default 20000 classic, 1000 arena)\n"
+                  << "  --size WxH           frame size in pixels (default: window size)\n"
+                  << "  --font PATH          TrueType font (default resources/fonts/arial.ttf)\n"
+                  << "  --ppm DIR            write DIR/frame_NNNNNN.ppm\n"
+                  << "  --png DIR            write DIR/frame_NNNNNN.png\n"
+                  << "  --pipe CMD           pipe raw RGBA frames to CMD's stdin\n"
+                  << "Without an output the frames are only rendered (for timing).\n";
+    }
+
+    bool splitPair(const std::string& text, std::string& name, std::uint64_t& value) {
+        const std::size_t colon = text.rfind(':');
+        if (colon == std::string::npos) return false;
+        name = text.substr(0, colon);
+        value = std::strtoull(text.c_str() + colon + 1, nullptr, 10);
+        return true;
+    }
+
+    /**
+     * @brief Sends rendered frames to files, an encoder, or nowhere
+     */
+    class FrameSink {
+    private:
+        enum class Kind { None, Ppm, Png, Pipe };
+        Kind kind{Kind::None};
+        std::string directory;
+        std::unique_ptr<EncoderPipe> pipe;
+        std::vector<std::uint8_t> encoded;
+        std::uint64_t written{0};
+
+    public:
+        std::uint64_t bytes{0};   ///< Bytes written so far
+
+        void toFiles(const std::string& dir, bool png) {
+            kind = png ? Kind::Png : Kind::Ppm;
+            directory = dir;
+        }
+
+        void toPipe(const std::string& command) {
+            kind = Kind::Pipe;
+            pipe = std::make_unique<EncoderPipe>(command);
+        }
+
+        void write(const SoftwareRenderer& renderer) {
+            const int width = renderer.getWidth();
+            const int height = renderer.getHeight();
+            if (kind == Kind::Pipe) {
+                pipe->write(renderer.data(), width, height);
+                bytes += static_cast<std::uint64_t>(width) * height * 4;
+            } else if (kind != Kind::None) {
+                char name[32];
+                std::snprintf(name, sizeof(name), "/frame_%06llu.%s",
+                              static_cast<unsigned long long>(written), kind == Kind::Png ? "png" : "ppm");
+                if (kind == Kind::Png) encodePng(renderer.data(), width, height, encoded);
+                else encodePpm(renderer.data(), width, height, encoded);
+                writeFile(directory + name, encoded);
+                bytes += encoded.size();
+            }
+            ++written;
+        }
+
+        int close() {
+            return pipe ? pipe->close() : 0;
+        }
+    };
+}
+
+// Renders a replayed game to image files or a video encoder, without a
+// window or GPU, e.g.:
+//   render_frames --replay flood:7 --pipe "ffmpeg -y -f rawvideo -pix_fmt rgba -s 800x600 -r 10 -i - flood7.mp4"
+int main(int argc, char** argv) {
+    std::string replay = "flood:1";
+    std::string arenaSpec;
+    std::uint64_t maxTicks = 0;
+    int width = GameConfig::WindowWidth();
+    int height = GameConfig::WindowHeight();
+    std::string fontPath = "resources/fonts/arial.ttf";
+    std::string ppmDir;
+    std::string pngDir;
+    std::string pipeCommand;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--replay") == 0 && hasValue) {
+            replay = argv[++i];
+        } else if (std::strcmp(argv[i], "--arena") == 0 && hasValue) {
+            arenaSpec = argv[++i];
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue) {
+            maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--size") == 0 && hasValue) {
+            char* end = nullptr;
+            width = static_cast<int>(std::strtol(argv[++i], &end, 10));
+            height = (*end == 'x') ? static_cast<int>(std::strtol(end + 1, nullptr, 10)) : 0;
+        } else if (std::strcmp(argv[i], "--font") == 0 && hasValue) {
+            fontPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--ppm") == 0 && hasValue) {
+            ppmDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--png") == 0 && hasValue) {
+            pngDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--pipe") == 0 && hasValue) {
+            pipeCommand = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (width <= 0 || height <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+#ifdef SIGPIPE
+    // A crashed encoder should surface as a write error, not kill us
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    try {
+        const TrueTypeFont font(fontPath);
+        SoftwareRenderer renderer(font, width, height);
+        FrameSink sink;
+        if (!pipeCommand.empty()) sink.toPipe(pipeCommand);
+        else if (!pngDir.empty()) sink.toFiles(pngDir, true);
+        else if (!ppmDir.empty()) sink.toFiles(ppmDir, false);
+
+        FrameSnapshot frame;
+        std::uint64_t frames = 0;
+        std::chrono::steady_clock::duration renderTime{0};
+        auto emit = [&]() {
+            const auto start = std::chrono::steady_clock::now();
+            renderer.draw(frame);
+            renderTime += std::chrono::steady_clock::now() - start;
+            sink.write(renderer);
+            ++frames;
+        };
+        const auto start = std::chrono::steady_clock::now();
+
+        std::string name;
+        std::uint64_t seed;
+        if (!arenaSpec.empty()) {
+            if (!splitPair(arenaSpec, name, seed)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            const auto snakes = static_cast<std::size_t>(std::strtoul(name.c_str(), nullptr, 10));
+            Arena arena(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT, snakes, GameConfig::ARENA_FOOD, seed);
+            if (maxTicks == 0) maxTicks = 1000;
+            for (std::uint64_t tick = 0; tick <= maxTicks; ++tick) {
+                frame.clear(arena.getWidth(), arena.getHeight());
+                PlayingState::describeArena(arena, frame);
+                emit();
+                arena.step();
+            }
+        } else {
+            if (!splitPair(replay, name, seed)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            GameSession session(seed);
+            auto controller = ControllerRegistry::create(name);
+            controller->reset(seed);
+            if (maxTicks == 0) maxTicks = 20000;
+
+            // Same frames the window shows: the board every tick, then the game over screen
+            bool over = false;
+            while (!over && session.getTick() < maxTicks) {
+                frame.clear(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT);
+                PlayingState::describeSession(session, frame);
+                emit();
+                session.setDirection(controller->decide(session));
+                const StepOutcome outcome = session.step();
+                over = outcome == StepOutcome::Died || outcome == StepOutcome::Filled;
+            }
+            const std::string scoreText = "Score: " + std::to_string(session.getScore());
+            for (int i = 0; i < 2 * GameConfig::TICK_RATE; ++i) {
+                frame.clear(GameConfig::GRID_WIDTH, GameConfig::GRID_HEIGHT);
+                GameOverState::describe(scoreText, frame);
+                emit();
+            }
+        }
+
+        const int status = sink.close();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double renderSeconds = std::chrono::duration<double>(renderTime).count();
+        std::cout << frames << " frames of " << width << "x" << height << " in " << seconds << " s ("
+                  << frames / seconds << " frames/s overall, " << frames / renderSeconds
+                  << " frames/s rendering), " << sink.bytes / 1048576.0 << " MiB written" << std::endl;
+        if (status != 0) {
+            std::cerr << "encoder exited with status " << status << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
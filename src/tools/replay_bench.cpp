@@ -0,0 +1,280 @@
+#include "GameController.hpp"
+#include "levels/LevelPack.hpp"
+#include "metrics/AllocationTracker.hpp"
+#include "render/FrameSnapshot.hpp"
+#include "render/SoftwareRenderer.hpp"
+#include "render/TrueTypeFont.hpp"
+#include "replay/Session.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Phases of one tick, as the simulation thread runs them (plus drawing, like the window thread)
+     */
+    enum Phase { Input, Update, Snapshot, Render, PhaseCount };
+    const char* const PhaseNames[PhaseCount] = {"input", "update", "snapshot", "render"};
+    const AllocPhase AllocPhases[PhaseCount] = {AllocPhase::Input, AllocPhase::Update, AllocPhase::Snapshot,
+                                                AllocPhase::Render};
+
+    struct Result {
+        std::string name;                           ///< Session name
+        std::uint64_t ticks{0};                     ///< Ticks replayed
+        std::uint64_t keys{0};                      ///< Key presses replayed
+        Clock::duration total{0};                   ///< Wall time of the whole replay
+        Clock::duration time[PhaseCount]{};         ///< Time per phase
+        std::uint64_t allocations[PhaseCount]{};    ///< Heap allocations per phase (tracking builds only)
+        std::uint64_t checksum{0};                  ///< Hash of every snapshot
+    };
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [options] SESSION...\n"
+                  << "  --repeat N   replay each session N times and keep the fastest (default 3)\n"
+                  << "  --render     also draw every snapshot with the software renderer\n"
+                  << "  --font PATH  TrueType font for --render (default resources/fonts/arial.ttf)\n"
+                  << "  --csv FILE   write one row per session\n"
+                  << "Sessions are recorded with main --record-session.\n";
+    }
+
+    // FNV-1a over everything a snapshot shows: equal checksums mean the replay behaved identically
+    std::uint64_t hashBytes(std::uint64_t hash, const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    std::uint64_t hashFrame(std::uint64_t hash, const FrameSnapshot& frame) {
+        for (const SnapshotCell& cell : frame.cells) {
+            const std::uint8_t packed[8] = {
+                static_cast<std::uint8_t>(cell.x), static_cast<std::uint8_t>(cell.x >> 8),
+                static_cast<std::uint8_t>(cell.y), static_cast<std::uint8_t>(cell.y >> 8),
+                cell.color.r, cell.color.g, cell.color.b, cell.color.a};
+            hash = hashBytes(hash, packed, sizeof(packed));
+        }
+        for (const SnapshotText& text : frame.texts) {
+            hash = hashBytes(hash, text.text.data(), text.text.size());
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Replays a session through GameController as the game's simulation thread would
+     */
+    Result replay(const Session& session, const std::shared_ptr<const LevelPack>& levels,
+                  SoftwareRenderer* renderer) {
+        sf::Font font;   // States only name texts; nothing is drawn with it
+        GameController controller(font);
+        controller.setGameSeed(session.seed);
+        controller.setAgent(session.agent);
+        controller.setLevelPack(levels);
+        controller.setRewindOnDeath(session.rewindOnDeath);
+        controller.initializeGame();
+
+        Result result;
+        result.name = session.name;
+        result.checksum = 0xCBF29CE484222325ull;
+        FrameSnapshot frame;
+        std::uint64_t allocations[PhaseCount]{};
+        std::size_t next = 0;
+
+        const auto start = Clock::now();
+        for (std::uint64_t tick = 0; tick < session.ticks && !controller.isQuitRequested(); ++tick) {
+            auto begin = Clock::now();
+            if (next < session.events.size() && session.events[next].tick == tick) {
+                AllocationScope scope(AllocPhase::Input);
+                for (; next < session.events.size() && session.events[next].tick == tick; ++next) {
+                    InputEvent input;
+                    input.event.type = sf::Event::KeyPressed;
+                    input.event.key.code = session.events[next].key;
+                    input.time = begin;
+                    controller.handleInput(input);
+                    ++result.keys;
+                }
+                allocations[Input] += scope.allocations();
+                const auto end = Clock::now();
+                result.time[Input] += end - begin;
+                begin = end;
+            }
+            {
+                AllocationScope scope(AllocPhase::Update);
+                controller.update();
+                allocations[Update] += scope.allocations();
+            }
+            auto end = Clock::now();
+            result.time[Update] += end - begin;
+            begin = end;
+            {
+                AllocationScope scope(AllocPhase::Snapshot);
+                controller.render(frame);
+                allocations[Snapshot] += scope.allocations();
+            }
+            end = Clock::now();
+            result.time[Snapshot] += end - begin;
+            result.checksum = hashFrame(result.checksum, frame);
+
+            if (renderer) {
+                begin = end;
+                {
+                    AllocationScope scope(AllocPhase::Render);
+                    renderer->draw(frame);
+                    allocations[Render] += scope.allocations();
+                }
+                result.time[Render] += Clock::now() - begin;
+            }
+            ++result.ticks;
+        }
+        result.total = Clock::now() - start;
+        std::copy(allocations, allocations + PhaseCount, result.allocations);
+        return result;
+    }
+
+    double nanosPerTick(Clock::duration time, std::uint64_t ticks) {
+        return ticks ? std::chrono::duration<double, std::nano>(time).count() / static_cast<double>(ticks) : 0.0;
+    }
+
+    double ticksPerSecond(const Result& result) {
+        const double seconds = std::chrono::duration<double>(result.total).count();
+        return seconds > 0 ? static_cast<double>(result.ticks) / seconds : 0.0;
+    }
+
+    void printRow(const Result& result) {
+        std::printf("%-22s %9llu %7llu %11.0f", result.name.c_str(),
+                    static_cast<unsigned long long>(result.ticks), static_cast<unsigned long long>(result.keys),
+                    ticksPerSecond(result));
+        for (int phase = 0; phase < PhaseCount; ++phase) {
+            std::printf(" %9.0f", nanosPerTick(result.time[phase], result.ticks));
+        }
+        for (int phase = 0; phase < PhaseCount; ++phase) {
+            std::printf(" %8llu", static_cast<unsigned long long>(result.allocations[phase]));
+        }
+        std::printf("  %016llx\n", static_cast<unsigned long long>(result.checksum));
+    }
+
+    void writeCsv(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream out(path, std::ios::trunc);
+        out << "session,ticks,keys,seconds,ticks_per_second";
+        for (const char* name : PhaseNames) out << ',' << name << "_ns_per_tick";
+        for (const char* name : PhaseNames) out << ',' << name << "_allocations";
+        out << ",checksum\n";
+        for (const Result& result : results) {
+            char checksum[24];
+            std::snprintf(checksum, sizeof(checksum), "%016llx", static_cast<unsigned long long>(result.checksum));
+            out << result.name << ',' << result.ticks << ',' << result.keys << ','
+                << std::chrono::duration<double>(result.total).count() << ',' << ticksPerSecond(result);
+            for (int phase = 0; phase < PhaseCount; ++phase) out << ',' << nanosPerTick(result.time[phase], result.ticks);
+            for (int phase = 0; phase < PhaseCount; ++phase) out << ',' << result.allocations[phase];
+            out << ',' << checksum << '\n';
+        }
+        if (!out) {
+            throw std::runtime_error("Failed to write " + path);
+        }
+    }
+}
+
+// Replays recorded sessions end to end (GameController -> StateMachine ->
+// states, snapshots, optionally software rendering) and reports ticks/s,
+// time per phase and allocations per phase, e.g.:
+//   replay_bench --render bench/sessions/*.session
+int main(int argc, char** argv) {
+    int repeat = 3;
+    bool render = false;
+    std::string fontPath = "resources/fonts/arial.ttf";
+    std::string csvPath;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--repeat") == 0 && hasValue) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--render") == 0) {
+            render = true;
+        } else if (std::strcmp(argv[i], "--font") == 0 && hasValue) {
+            fontPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+            csvPath = argv[++i];
+        } else if (argv[i][0] == '-') {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        std::unique_ptr<TrueTypeFont> font;
+        std::unique_ptr<SoftwareRenderer> renderer;
+        if (render) {
+            font = std::make_unique<TrueTypeFont>(fontPath);
+            renderer = std::make_unique<SoftwareRenderer>(*font, GameConfig::WindowWidth(), GameConfig::WindowHeight());
+        }
+
+        std::printf("%-22s %9s %7s %11s", "session", "ticks", "keys", "ticks/s");
+        for (const char* name : PhaseNames) std::printf(" %9s", (std::string(name).substr(0, 6) + " ns").c_str());
+        for (const char* name : PhaseNames) std::printf(" %8s", (std::string(name).substr(0, 6) + " al").c_str());
+        std::printf("  checksum\n");
+
+        std::map<std::string, std::shared_ptr<const LevelPack>> packs;
+        std::vector<Result> results;
+        Result total;
+        total.name = "total";
+        for (const std::string& path : paths) {
+            const Session session = Session::load(path);
+            std::shared_ptr<const LevelPack>& levels = packs[session.levels];
+            if (!session.levels.empty() && !levels) {
+                levels = std::make_shared<const LevelPack>(session.levels);
+            }
+
+            // Fastest of several runs; every run must see exactly the same frames
+            Result best;
+            for (int run = 0; run < repeat; ++run) {
+                Result result = replay(session, levels, renderer.get());
+                if (run > 0 && result.checksum != best.checksum) {
+                    throw std::runtime_error(path + " does not replay deterministically");
+                }
+                if (run == 0 || result.total < best.total) {
+                    best = result;
+                }
+            }
+            printRow(best);
+
+            total.ticks += best.ticks;
+            total.keys += best.keys;
+            total.total += best.total;
+            for (int phase = 0; phase < PhaseCount; ++phase) {
+                total.time[phase] += best.time[phase];
+                total.allocations[phase] += best.allocations[phase];
+            }
+            total.checksum = hashBytes(total.checksum, &best.checksum, sizeof(best.checksum));
+            results.push_back(best);
+        }
+        printRow(total);
+        if (!AllocationTracker::isEnabled()) {
+            std::printf("(allocations are only counted in builds with SNAIKE_TRACK_ALLOCATIONS)\n");
+        }
+        if (!csvPath.empty()) {
+            results.push_back(total);
+            writeCsv(csvPath, results);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
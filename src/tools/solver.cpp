@@ -0,0 +1,89 @@
+#include "solver/SmallBoardSolver.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --size WxH           board size, 4x4 up to 64 cells (default 6x6)\n"
+                  << "  --seed S             food seed (default 1)\n"
+                  << "  --threads T          search threads (default: all cores)\n"
+                  << "  --max-ticks M        search horizon (default: cells squared)\n"
+                  << "  --max-nodes N        stop after N positions and report the best line so far\n"
+                  << "  --table-mb MB        transposition table size (default 256)\n"
+                  << "  --longest            only maximise length, do not minimise ticks\n"
+                  << "  --moves              print the best line as U/D/L/R\n";
+    }
+
+    char directionLetter(Direction dir) {
+        switch (dir) {
+            case Direction::Up:    return 'U';
+            case Direction::Down:  return 'D';
+            case Direction::Left:  return 'L';
+            case Direction::Right: return 'R';
+        }
+        return '?';
+    }
+}
+
+int main(int argc, char** argv) {
+    SolverConfig config;
+    bool printMoves = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--size") == 0 && hasValue) {
+            char* end = nullptr;
+            config.width = static_cast<int>(std::strtol(argv[++i], &end, 10));
+            config.height = (*end == 'x') ? static_cast<int>(std::strtol(end + 1, nullptr, 10)) : 0;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            config.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--max-ticks") == 0 && hasValue) {
+            config.maxTicks = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--max-nodes") == 0 && hasValue) {
+            config.maxNodes = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--table-mb") == 0 && hasValue) {
+            config.tableMegabytes = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--longest") == 0) {
+            config.fewestTicks = false;
+        } else if (std::strcmp(argv[i], "--moves") == 0) {
+            printMoves = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        const SmallBoardSolver solver(config);
+        const SolverResult result = solver.solve();
+
+        std::cout << config.width << "x" << config.height << " seed " << config.seed << ": "
+                  << (result.proven ? "optimal" : "best found") << " score " << result.score
+                  << " (length " << result.length << (result.filled ? ", board filled" : "")
+                  << ") at tick " << result.ticks << std::endl;
+        std::cout << result.nodes << " nodes, " << result.tableHits << " table hits, "
+                  << result.seconds << " s" << std::endl;
+
+        // Cross-check the line with the game's own Snake rules
+        const int replayed = solver.replay(result.moves);
+        if (replayed != result.score) {
+            std::cerr << "replay with Snake scored " << replayed << ", expected " << result.score << std::endl;
+            return 1;
+        }
+
+        if (printMoves) {
+            std::string line;
+            for (Direction dir : result.moves) line += directionLetter(dir);
+            std::cout << line << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
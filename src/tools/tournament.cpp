@@ -0,0 +1,142 @@
+#include "tournament/Tournament.hpp"
+#include "agents/ControllerRegistry.hpp"
+#include "metrics/Metrics.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --agents a,b,...     controllers to compare (default: all registered)\n"
+                  << "  --seeds N            games per agent (default 200)\n"
+                  << "  --first-seed S       first seed (default 1)\n"
+                  << "  --threads T          worker threads (default: all cores)\n"
+                  << "  --max-ticks M        tick limit per game\n"
+                  << "  --batch B            games per act_batch call for plugin:<path> agents (default 64)\n"
+                  << "  --levels PACK        play seed S on level S % count of a level pack\n"
+                  << "  --csv FILE           per-game results\n"
+                  << "  --json FILE          statistics, tests and failing seeds\n"
+                  << "  --trajectories DIR   stream every step to DIR as .npy chunks for training\n"
+                  << "  --metrics PATH       write PATH.prom and PATH.json metrics every 5 s\n"
+                  << "  --replay AGENT:SEED  replay a single game and print its record\n";
+    }
+
+    std::vector<std::string> splitList(const std::string& text) {
+        std::vector<std::string> items;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+}
+
+int main(int argc, char** argv) {
+    TournamentConfig config;
+    std::string csvPath;
+    std::string jsonPath;
+    std::string replay;
+    std::string metricsPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--agents") == 0 && hasValue) {
+            config.agents = splitList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seeds") == 0 && hasValue) {
+            config.numSeeds = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--first-seed") == 0 && hasValue) {
+            config.firstSeed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            config.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--max-ticks") == 0 && hasValue) {
+            config.maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--batch") == 0 && hasValue) {
+            config.batchSize = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--levels") == 0 && hasValue) {
+            config.levelPack = argv[++i];
+        } else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+            csvPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--trajectories") == 0 && hasValue) {
+            config.trajectoryDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--metrics") == 0 && hasValue) {
+            metricsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) {
+            replay = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::unique_ptr<MetricsExporter> metricsExporter;
+    if (!metricsPath.empty()) {
+        metricsExporter = std::make_unique<MetricsExporter>(metricsPath);
+    }
+
+    try {
+        if (!replay.empty()) {
+            const std::size_t colon = replay.rfind(':');
+            if (colon == std::string::npos) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            const std::string agent = replay.substr(0, colon);
+            const std::uint64_t seed = std::strtoull(replay.c_str() + colon + 1, nullptr, 10);
+            std::unique_ptr<LevelPack> levels;
+            if (!config.levelPack.empty()) levels = std::make_unique<LevelPack>(config.levelPack);
+            std::unique_ptr<TrajectoryWriter> trajectories;
+            if (!config.trajectoryDir.empty()) {
+                trajectories = std::make_unique<TrajectoryWriter>(config.trajectoryDir, "replay");
+            }
+            GameSession session(seed);
+            auto controller = ControllerRegistry::create(agent);
+            const GameRecord r = Tournament::playGame(session, *controller, agent, seed,
+                                                      config.maxTicks, config.starveTicks, levels.get(),
+                                                      trajectories.get());
+            if (trajectories) trajectories->close();
+            std::cout << r.agent << " seed " << r.seed << ": " << gameEndName(r.end)
+                      << " after " << r.ticks << " ticks, score " << r.score;
+            if (!r.error.empty()) std::cout << " (" << r.error << ")";
+            std::cout << std::endl;
+            return 0;
+        }
+
+        Tournament tournament(config);
+        const TournamentConfig& settings = tournament.getConfig();
+        std::cout << settings.agents.size() << " agents x " << settings.numSeeds << " seeds on "
+                  << settings.threads << " threads" << std::endl;
+
+        const auto start = std::chrono::steady_clock::now();
+        const std::vector<GameRecord> records = tournament.run();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << records.size() << " games in " << seconds << " s" << std::endl;
+
+        printTournamentSummary(std::cout, settings, records);
+        // Every end but a death or a filled board is a failing run; each can be replayed from its seed
+        constexpr int MaxListedFailures = 10;
+        int failures = 0;
+        for (const auto& r : records) {
+            if (r.end == GameEnd::Died || r.end == GameEnd::Filled) continue;
+            if (++failures <= MaxListedFailures) {
+                std::cout << "failing run: --replay " << r.agent << ":" << r.seed
+                          << " (" << gameEndName(r.end) << ")" << std::endl;
+            }
+        }
+        if (failures > MaxListedFailures) {
+            std::cout << "... " << failures - MaxListedFailures << " more failing runs" << std::endl;
+        }
+        if (!csvPath.empty()) writeTournamentCsv(csvPath, records);
+        if (!jsonPath.empty()) writeTournamentJson(jsonPath, settings, records);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "tournament/Statistics.hpp"
+#include <cmath>
+
+namespace {
+    // Continued fraction for the regularized incomplete beta function (Lentz's method)
+    double betaContinuedFraction(double a, double b, double x) {
+        constexpr int MaxIterations = 300;
+        constexpr double Epsilon = 1e-14;
+        constexpr double Tiny = 1e-300;
+
+        double c = 1.0;
+        double d = 1.0 - (a + b) * x / (a + 1.0);
+        if (std::fabs(d) < Tiny) d = Tiny;
+        d = 1.0 / d;
+        double h = d;
+
+        for (int m = 1; m <= MaxIterations; ++m) {
+            const double m2 = 2.0 * m;
+            double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+            d = 1.0 + aa * d;
+            if (std::fabs(d) < Tiny) d = Tiny;
+            c = 1.0 + aa / c;
+            if (std::fabs(c) < Tiny) c = Tiny;
+            d = 1.0 / d;
+            h *= d * c;
+
+            aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+            d = 1.0 + aa * d;
+            if (std::fabs(d) < Tiny) d = Tiny;
+            c = 1.0 + aa / c;
+            if (std::fabs(c) < Tiny) c = Tiny;
+            d = 1.0 / d;
+            const double delta = d * c;
+            h *= delta;
+            if (std::fabs(delta - 1.0) < Epsilon) break;
+        }
+        return h;
+    }
+
+    double regularizedIncompleteBeta(double a, double b, double x) {
+        if (x <= 0.0) return 0.0;
+        if (x >= 1.0) return 1.0;
+        const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                      a * std::log(x) + b * std::log(1.0 - x));
+        if (x < (a + 1.0) / (a + b + 2.0)) {
+            return front * betaContinuedFraction(a, b, x) / a;
+        }
+        return 1.0 - front * betaContinuedFraction(b, a, 1.0 - x) / b;
+    }
+
+    // Two-sided 95% critical value, found by bisection on the tail probability
+    double tCritical95(double df) {
+        double lo = 0.0, hi = 1000.0;
+        for (int i = 0; i < 100; ++i) {
+            const double mid = 0.5 * (lo + hi);
+            if (studentTwoSidedP(mid, df) > 0.05) lo = mid; else hi = mid;
+        }
+        return 0.5 * (lo + hi);
+    }
+
+    TTestResult finishTest(double meanDiff, double standardError, double df) {
+        TTestResult result;
+        result.df = df;
+        if (standardError > 0.0 && df > 0.0) {
+            result.t = meanDiff / standardError;
+            result.pValue = studentTwoSidedP(result.t, df);
+        } else {
+            // No variance: identical samples are indistinguishable, anything else is certain
+            result.pValue = meanDiff == 0.0 ? 1.0 : 0.0;
+        }
+        return result;
+    }
+}
+
+double studentTwoSidedP(double t, double df) {
+    return regularizedIncompleteBeta(0.5 * df, 0.5, df / (df + t * t));
+}
+
+SampleSummary summarize(const std::vector<double>& values) {
+    SampleSummary summary;
+    summary.count = values.size();
+    if (values.empty()) return summary;
+
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    summary.mean = sum / values.size();
+
+    if (values.size() > 1) {
+        double squares = 0.0;
+        for (double v : values) squares += (v - summary.mean) * (v - summary.mean);
+        summary.stddev = std::sqrt(squares / (values.size() - 1));
+        const double halfWidth = tCritical95(static_cast<double>(values.size() - 1)) *
+                                 summary.stddev / std::sqrt(static_cast<double>(values.size()));
+        summary.ciLow = summary.mean - halfWidth;
+        summary.ciHigh = summary.mean + halfWidth;
+    } else {
+        summary.ciLow = summary.ciHigh = summary.mean;
+    }
+    return summary;
+}
+
+TTestResult pairedTTest(const std::vector<double>& a, const std::vector<double>& b) {
+    const std::size_t n = a.size() < b.size() ? a.size() : b.size();
+    std::vector<double> diff(n);
+    for (std::size_t i = 0; i < n; ++i) diff[i] = a[i] - b[i];
+    const SampleSummary s = summarize(diff);
+    if (n < 2) return TTestResult{};
+    return finishTest(s.mean, s.stddev / std::sqrt(static_cast<double>(n)), static_cast<double>(n - 1));
+}
+
+TTestResult welchTTest(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() < 2 || b.size() < 2) return TTestResult{};
+    const SampleSummary sa = summarize(a);
+    const SampleSummary sb = summarize(b);
+    const double va = sa.stddev * sa.stddev / a.size();
+    const double vb = sb.stddev * sb.stddev / b.size();
+    const double denom = va * va / (a.size() - 1) + vb * vb / (b.size() - 1);
+    const double df = denom > 0.0 ? (va + vb) * (va + vb) / denom : 0.0;
+    return finishTest(sa.mean - sb.mean, std::sqrt(va + vb), df);
+}
@@ -0,0 +1,497 @@
+#include "tournament/Tournament.hpp"
+#include "tournament/Statistics.hpp"
+#include "agents/ControllerRegistry.hpp"
+#include "metrics/Metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    /**
+     * @brief Per-agent metric columns gathered from the records
+     */
+    struct AgentSamples {
+        std::vector<double> score;
+        std::vector<double> ticks;
+        std::vector<double> ticksPerFood;   // Only games that ate at least once
+        std::vector<double> nsPerDecision;
+    };
+
+    std::vector<AgentSamples> collectSamples(const TournamentConfig& config,
+                                             const std::vector<GameRecord>& records) {
+        std::vector<AgentSamples> samples(config.agents.size());
+        for (std::size_t a = 0; a < config.agents.size(); ++a) {
+            for (std::uint32_t s = 0; s < config.numSeeds; ++s) {
+                const GameRecord& r = records[a * config.numSeeds + s];
+                samples[a].score.push_back(r.score);
+                samples[a].ticks.push_back(static_cast<double>(r.ticks));
+                if (r.score > 0) samples[a].ticksPerFood.push_back(r.ticksPerFood);
+                samples[a].nsPerDecision.push_back(r.nsPerDecision);
+            }
+        }
+        return samples;
+    }
+
+    void writeSummaryJson(std::ostream& out, const char* name, const SampleSummary& s) {
+        out << "\"" << name << "\": {\"n\": " << s.count << ", \"mean\": " << s.mean
+            << ", \"stddev\": " << s.stddev << ", \"ci95\": [" << s.ciLow << ", " << s.ciHigh << "]}";
+    }
+
+    /**
+     * @brief Gets the done column value of a step that ended the game (or not)
+     */
+    TrajectoryDone trajectoryDone(bool over, GameEnd end) {
+        if (!over) return TrajectoryDone::Running;
+        return end == GameEnd::Died || end == GameEnd::Filled ? TrajectoryDone::Died : TrajectoryDone::CutOff;
+    }
+
+    /**
+     * @brief Turns an agent name such as "plugin:./libx.so" into a file name prefix
+     */
+    std::string filePrefix(const std::string& agent, unsigned worker) {
+        std::string prefix;
+        for (char c : agent) {
+            prefix += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+        }
+        return prefix + "-w" + std::to_string(worker);
+    }
+
+    std::string jsonString(const std::string& text) {
+        std::string escaped = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+        }
+        return escaped + "\"";
+    }
+}
+
+const char* gameEndName(GameEnd end) {
+    switch (end) {
+        case GameEnd::Died:     return "died";
+        case GameEnd::Filled:   return "filled";
+        case GameEnd::MaxTicks: return "max_ticks";
+        case GameEnd::Starved:  return "starved";
+        case GameEnd::Error:    return "error";
+    }
+    return "unknown";
+}
+
+Tournament::Tournament(const TournamentConfig& settings)
+    : config(settings)
+{
+    if (config.agents.empty()) {
+        config.agents = ControllerRegistry::names();
+    }
+    for (const auto& agent : config.agents) {
+        ControllerRegistry::create(agent);  // Throws for unknown names before any work starts
+    }
+    if (config.threads == 0) {
+        config.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (!config.levelPack.empty()) {
+        levels = std::make_unique<LevelPack>(config.levelPack);
+        GameSession(config.firstSeed).setLevel(levels->level(0));   // Throws for the wrong board size
+    }
+}
+
+GameRecord Tournament::playGame(GameSession& session, Controller& controller, const std::string& agent,
+                                std::uint64_t seed, std::uint64_t maxTicks, std::uint64_t starveTicks,
+                                const LevelPack* levels, TrajectoryWriter* trajectories) {
+    using Clock = std::chrono::steady_clock;
+    static Histogram& decisionLatency = MetricsRegistry::instance().histogram(
+        "snaike_agent_decision_ns", "Time spent in Controller::decide, nanoseconds");
+
+    GameRecord record;
+    record.agent = agent;
+    record.seed = seed;
+    session.setLevel(levels ? levels->levelForSeed(seed) : Level());
+    session.reset(seed);
+
+    Clock::duration decisionTime{0};
+    std::uint64_t lastMeal = 0;
+    try {
+        controller.reset(seed);
+        for (bool over = false; !over;) {
+            if (trajectories) {
+                session.writeObservation(trajectories->observation());
+            }
+            const auto start = Clock::now();
+            const Direction dir = controller.decide(session);
+            const auto elapsed = Clock::now() - start;
+            decisionTime += elapsed;
+            decisionLatency.record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+            const std::uint64_t tick = session.getTick();
+            const int score = session.getScore();
+            session.setDirection(dir);
+            const StepOutcome outcome = session.step();
+            if (outcome == StepOutcome::Ate) {
+                lastMeal = session.getTick();
+            }
+            over = true;
+            if (outcome == StepOutcome::Died) {
+                record.end = GameEnd::Died;
+            } else if (outcome == StepOutcome::Filled) {
+                record.end = GameEnd::Filled;
+            } else if (session.getTick() >= maxTicks) {
+                record.end = GameEnd::MaxTicks;
+            } else if (session.getTick() - lastMeal >= starveTicks) {
+                record.end = GameEnd::Starved;
+            } else {
+                over = false;
+            }
+            if (trajectories) {
+                trajectories->commit(session.getSnake().getDirection(), static_cast<float>(session.getScore() - score),
+                                     trajectoryDone(over, record.end), tick, seed);
+            }
+        }
+    } catch (const std::exception& e) {
+        record.end = GameEnd::Error;
+        record.error = e.what();
+        if (trajectories) {
+            trajectories->cutOff();   // The game's rows stop at its last committed step
+        }
+    }
+
+    record.score = session.getScore();
+    record.ticks = session.getTick();
+    record.ticksPerFood = record.score > 0 ? static_cast<double>(record.ticks) / record.score : 0.0;
+    record.nsPerDecision = record.ticks > 0
+        ? std::chrono::duration<double, std::nano>(decisionTime).count() / record.ticks
+        : 0.0;
+    return record;
+}
+
+#ifdef SNAIKE_PLUGINS
+void Tournament::playBatch(AgentPlugin& plugin, const std::string& agent, std::uint64_t firstSeed,
+                           GameRecord* records, std::uint32_t numGames,
+                           std::uint64_t maxTicks, std::uint64_t starveTicks,
+                           const LevelPack* levels, TrajectoryWriter* trajectories) {
+    using Clock = std::chrono::steady_clock;
+    static Histogram& batchLatency = MetricsRegistry::instance().histogram(
+        "snaike_agent_batch_ns", "Time spent in one plugin act_batch call, nanoseconds");
+
+    /**
+     * @brief A recorded step waiting in a slot's run (its observation is stored alongside)
+     */
+    struct PendingRow {
+        Direction action;
+        float reward;
+        TrajectoryDone done;
+        std::uint64_t tick;
+    };
+
+    /**
+     * @brief One game in flight; the observation buffer is handed to the plugin as is
+     *
+     * The slots step in lockstep, so recorded steps are held per slot and
+     * written as one run when the game ends; rows of a game stay consecutive.
+     */
+    struct Slot {
+        GameSession session;
+        std::vector<std::uint8_t> observation = std::vector<std::uint8_t>(GameSession::ObservationSize);
+        GameRecord* record = nullptr;      // Null while idle
+        std::uint64_t lastMeal = 0;
+        Clock::duration decisionTime{0};
+        std::vector<std::uint8_t> runObservations;  // Capacity kept across games
+        std::vector<PendingRow> runRows;
+    };
+
+    const std::uint32_t width = plugin.maxBatch();
+    std::vector<Slot> slots(width);
+    std::vector<const std::uint8_t*> observations(width, nullptr);
+    std::vector<std::uint8_t> actions(width);
+    std::uint32_t nextGame = 0;
+    std::uint32_t active = 0;
+
+    auto start = [&](std::uint32_t index) {
+        Slot& slot = slots[index];
+        if (nextGame == numGames) {
+            slot.record = nullptr;
+            observations[index] = nullptr;
+            return;
+        }
+        const std::uint64_t seed = firstSeed + nextGame;
+        slot.record = &records[nextGame++];
+        slot.record->agent = agent;
+        slot.record->seed = seed;
+        slot.session.setLevel(levels ? levels->levelForSeed(seed) : Level());
+        slot.session.reset(seed);
+        slot.lastMeal = 0;
+        slot.decisionTime = Clock::duration{0};
+        plugin.reset(index, seed);
+        observations[index] = slot.observation.data();
+        ++active;
+    };
+    auto finish = [&](std::uint32_t index, GameEnd end) {
+        Slot& slot = slots[index];
+        GameRecord& record = *slot.record;
+        if (trajectories && !slot.runRows.empty()) {
+            // A game stopped by an error ends at its last recorded step
+            if (slot.runRows.back().done == TrajectoryDone::Running) {
+                slot.runRows.back().done = TrajectoryDone::CutOff;
+            }
+            const std::uint8_t* observation = slot.runObservations.data();
+            for (const PendingRow& row : slot.runRows) {
+                std::memcpy(trajectories->observation(), observation, slot.observation.size());
+                trajectories->commit(row.action, row.reward, row.done, row.tick, record.seed);
+                observation += slot.observation.size();
+            }
+            slot.runObservations.clear();
+            slot.runRows.clear();
+        }
+        record.end = end;
+        record.score = slot.session.getScore();
+        record.ticks = slot.session.getTick();
+        record.ticksPerFood = record.score > 0 ? static_cast<double>(record.ticks) / record.score : 0.0;
+        record.nsPerDecision = record.ticks > 0
+            ? std::chrono::duration<double, std::nano>(slot.decisionTime).count() / record.ticks
+            : 0.0;
+        --active;
+        start(index);
+    };
+
+    for (std::uint32_t i = 0; i < width; ++i) {
+        start(i);
+    }
+    while (active > 0) {
+        for (std::uint32_t i = 0; i < width; ++i) {
+            if (slots[i].record) slots[i].session.writeObservation(slots[i].observation.data());
+        }
+
+        const auto callStart = Clock::now();
+        try {
+            plugin.actBatch(observations.data(), actions.data());
+        } catch (const std::exception& e) {
+            for (std::uint32_t i = 0; i < width; ++i) {
+                if (!slots[i].record) continue;
+                slots[i].record->error = e.what();
+                finish(i, GameEnd::Error);
+            }
+            continue;
+        }
+        const auto elapsed = Clock::now() - callStart;
+        batchLatency.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        const auto share = elapsed / active;
+
+        for (std::uint32_t i = 0; i < width; ++i) {
+            Slot& slot = slots[i];
+            if (!slot.record) continue;
+            slot.decisionTime += share;
+
+            GameSession& session = slot.session;
+            const std::uint64_t tick = session.getTick();
+            const int score = session.getScore();
+            session.setDirection(actionDirection(actions[i], session.getSnake().getDirection()));
+            const StepOutcome outcome = session.step();
+            if (outcome == StepOutcome::Ate) {
+                slot.lastMeal = session.getTick();
+            }
+            GameEnd end = GameEnd::Died;
+            bool over = true;
+            if (outcome == StepOutcome::Died) {
+                end = GameEnd::Died;
+            } else if (outcome == StepOutcome::Filled) {
+                end = GameEnd::Filled;
+            } else if (session.getTick() >= maxTicks) {
+                end = GameEnd::MaxTicks;
+            } else if (session.getTick() - slot.lastMeal >= starveTicks) {
+                end = GameEnd::Starved;
+            } else {
+                over = false;
+            }
+            if (trajectories) {
+                slot.runObservations.insert(slot.runObservations.end(), slot.observation.begin(), slot.observation.end());
+                slot.runRows.push_back(PendingRow{session.getSnake().getDirection(),
+                                                  static_cast<float>(session.getScore() - score),
+                                                  trajectoryDone(over, end), tick});
+            }
+            if (over) {
+                finish(i, end);
+            }
+        }
+    }
+}
+#endif
+
+std::vector<GameRecord> Tournament::run() const {
+    const std::size_t numAgents = config.agents.size();
+    std::vector<GameRecord> records(numAgents * config.numSeeds);
+
+    /**
+     * @brief A run of consecutive seeds for one agent (one seed unless batched)
+     */
+    struct Job {
+        std::size_t agent;
+        std::uint32_t firstSeedIndex;
+        std::uint32_t numSeeds;
+    };
+
+    // Jobs interleave agents so every agent progresses at the same rate
+    const std::uint32_t batch = std::max(1u, config.batchSize);
+    std::vector<Job> jobs;
+    for (std::uint32_t seedIndex = 0; seedIndex < config.numSeeds; ++seedIndex) {
+        for (std::size_t agent = 0; agent < numAgents; ++agent) {
+            if (!ControllerRegistry::isPluginName(config.agents[agent])) {
+                jobs.push_back({agent, seedIndex, 1});
+            } else if (seedIndex % batch == 0) {
+                jobs.push_back({agent, seedIndex, std::min(batch, config.numSeeds - seedIndex)});
+            }
+        }
+    }
+    std::atomic<std::size_t> nextJob{0};
+
+    auto worker = [&](unsigned workerIndex) {
+        GameSession session(config.firstSeed);
+        std::vector<std::unique_ptr<Controller>> controllers(numAgents);
+        std::vector<std::unique_ptr<TrajectoryWriter>> writers(numAgents);
+#ifdef SNAIKE_PLUGINS
+        std::vector<std::unique_ptr<AgentPlugin>> plugins(numAgents);
+#endif
+
+        for (std::size_t index = nextJob++; index < jobs.size(); index = nextJob++) {
+            const Job& job = jobs[index];
+            const std::string& name = config.agents[job.agent];
+            GameRecord* out = &records[job.agent * config.numSeeds + job.firstSeedIndex];
+            const std::uint64_t firstSeed = config.firstSeed + job.firstSeedIndex;
+            auto& writer = writers[job.agent];
+            if (!writer && !config.trajectoryDir.empty()) {
+                writer = std::make_unique<TrajectoryWriter>(config.trajectoryDir, filePrefix(name, workerIndex));
+            }
+
+            if (ControllerRegistry::isPluginName(name)) {
+#ifdef SNAIKE_PLUGINS
+                auto& plugin = plugins[job.agent];
+                if (!plugin) {
+                    plugin = std::make_unique<AgentPlugin>(ControllerRegistry::pluginPath(name), batch);
+                }
+                playBatch(*plugin, name, firstSeed, out, job.numSeeds, config.maxTicks, config.starveTicks,
+                          levels.get(), writer.get());
+#endif
+                continue;
+            }
+
+            auto& controller = controllers[job.agent];
+            if (!controller) {
+                controller = ControllerRegistry::create(name);
+            }
+            *out = playGame(session, *controller, name, firstSeed, config.maxTicks, config.starveTicks,
+                            levels.get(), writer.get());
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < config.threads; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return records;
+}
+
+void writeTournamentCsv(const std::string& path, const std::vector<GameRecord>& records) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+    out << "agent,seed,score,ticks,ticks_per_food,ns_per_decision,end\n";
+    for (const auto& r : records) {
+        out << r.agent << ',' << r.seed << ',' << r.score << ',' << r.ticks << ','
+            << r.ticksPerFood << ',' << r.nsPerDecision << ',' << gameEndName(r.end) << '\n';
+    }
+}
+
+void writeTournamentJson(const std::string& path, const TournamentConfig& config,
+                         const std::vector<GameRecord>& records) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+    const auto samples = collectSamples(config, records);
+
+    out << "{\n  \"seeds\": {\"first\": " << config.firstSeed << ", \"count\": " << config.numSeeds << "},\n";
+    out << "  \"levels\": " << jsonString(config.levelPack) << ",\n";
+    out << "  \"agents\": [\n";
+    for (std::size_t a = 0; a < config.agents.size(); ++a) {
+        out << "    {\"name\": " << jsonString(config.agents[a]) << ", ";
+        writeSummaryJson(out, "score", summarize(samples[a].score));
+        out << ", ";
+        writeSummaryJson(out, "ticks", summarize(samples[a].ticks));
+        out << ", ";
+        writeSummaryJson(out, "ticks_per_food", summarize(samples[a].ticksPerFood));
+        out << ", ";
+        writeSummaryJson(out, "ns_per_decision", summarize(samples[a].nsPerDecision));
+        out << "}" << (a + 1 < config.agents.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n  \"score_tests\": [\n";
+    bool first = true;
+    for (std::size_t a = 0; a < config.agents.size(); ++a) {
+        for (std::size_t b = a + 1; b < config.agents.size(); ++b) {
+            const TTestResult paired = pairedTTest(samples[a].score, samples[b].score);
+            const TTestResult welch = welchTTest(samples[a].score, samples[b].score);
+            out << (first ? "" : ",\n") << "    {\"a\": " << jsonString(config.agents[a])
+                << ", \"b\": " << jsonString(config.agents[b])
+                << ", \"paired_t\": " << paired.t << ", \"paired_p\": " << paired.pValue
+                << ", \"welch_t\": " << welch.t << ", \"welch_df\": " << welch.df
+                << ", \"welch_p\": " << welch.pValue << "}";
+            first = false;
+        }
+    }
+    out << "\n  ],\n  \"failures\": [\n";
+    first = true;
+    for (const auto& r : records) {
+        if (r.end == GameEnd::Died || r.end == GameEnd::Filled) continue;
+        out << (first ? "" : ",\n") << "    {\"agent\": " << jsonString(r.agent) << ", \"seed\": " << r.seed
+            << ", \"end\": \"" << gameEndName(r.end) << "\", \"ticks\": " << r.ticks
+            << ", \"error\": " << jsonString(r.error) << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+}
+
+void printTournamentSummary(std::ostream& out, const TournamentConfig& config,
+                            const std::vector<GameRecord>& records) {
+    const auto samples = collectSamples(config, records);
+    out << std::fixed << std::setprecision(2);
+    out << std::left << std::setw(12) << "agent" << std::right
+        << std::setw(24) << "score [95% CI]" << std::setw(12) << "ticks"
+        << std::setw(14) << "ticks/food" << std::setw(14) << "ns/decision" << std::setw(10) << "failures" << "\n";
+
+    for (std::size_t a = 0; a < config.agents.size(); ++a) {
+        const SampleSummary score = summarize(samples[a].score);
+        std::size_t failures = 0;
+        for (std::uint32_t s = 0; s < config.numSeeds; ++s) {
+            const GameEnd end = records[a * config.numSeeds + s].end;
+            if (end != GameEnd::Died && end != GameEnd::Filled) ++failures;
+        }
+        std::ostringstream ci;
+        ci << std::fixed << std::setprecision(2) << score.mean << " [" << score.ciLow << ", " << score.ciHigh << "]";
+        out << std::left << std::setw(12) << config.agents[a] << std::right
+            << std::setw(24) << ci.str()
+            << std::setw(12) << summarize(samples[a].ticks).mean
+            << std::setw(14) << summarize(samples[a].ticksPerFood).mean
+            << std::setw(14) << summarize(samples[a].nsPerDecision).mean
+            << std::setw(9) << failures << "\n";
+    }
+
+    for (std::size_t a = 0; a < config.agents.size(); ++a) {
+        for (std::size_t b = a + 1; b < config.agents.size(); ++b) {
+            const TTestResult paired = pairedTTest(samples[a].score, samples[b].score);
+            out << config.agents[a] << " vs " << config.agents[b] << ": paired t = " << paired.t
+                << ", p = " << std::setprecision(4) << paired.pValue << std::setprecision(2) << "\n";
+        }
+    }
+}
@@ -0,0 +1,195 @@
+#include "trajectory/TrajectoryWriter.hpp"
+#include "metrics/Metrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    bool littleEndian() {
+        const std::uint16_t probe = 1;
+        std::uint8_t first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    /**
+     * @brief Writes one array as a version 1.0 .npy file, header padded to 64 bytes
+     * @param descr numpy dtype string, e.g. "<f4"
+     * @param shape Python tuple text, e.g. "(8192,)"
+     */
+    void writeNpy(const std::string& path, const char* descr, const std::string& shape,
+                  const void* data, std::size_t bytes) {
+        std::string header = std::string("{'descr': '") + descr + "', 'fortran_order': False, 'shape': " + shape + ", }";
+        const std::size_t preamble = 10;   // Magic, version, header length
+        const std::size_t total = (preamble + header.size() + 1 + 63) / 64 * 64;
+        header.append(total - preamble - header.size() - 1, ' ');
+        header += '\n';
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const char magic[8] = {'\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0};
+        const std::uint16_t length = static_cast<std::uint16_t>(header.size());
+        const char lengthBytes[2] = {static_cast<char>(length & 0xFF), static_cast<char>(length >> 8)};
+        out.write(magic, sizeof(magic));
+        out.write(lengthBytes, sizeof(lengthBytes));
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        if (!out) {
+            throw std::runtime_error("Failed to write " + path);
+        }
+    }
+}
+
+TrajectoryWriter::TrajectoryWriter(const std::string& outputDirectory, const std::string& filePrefix,
+                                   std::size_t chunkSize, std::size_t bufferCount,
+                                   int boardWidth, int boardHeight)
+    : directory(outputDirectory)
+    , prefix(filePrefix)
+    , width(boardWidth)
+    , height(boardHeight)
+    , chunkRows(std::max<std::size_t>(chunkSize, 1))
+    , chunks(std::max<std::size_t>(bufferCount, 2))
+    , stalls(MetricsRegistry::instance().counter(
+          "snaike_trajectory_stalls_total", "Times a full trajectory chunk waited for a free buffer")) {
+    std::error_code failure;
+    std::filesystem::create_directories(directory, failure);
+    if (failure) {
+        throw std::runtime_error("Cannot create " + directory + ": " + failure.message());
+    }
+
+    const std::size_t cells = static_cast<std::size_t>(width) * height;
+    for (Chunk& chunk : chunks) {
+        chunk.observations.resize(chunkRows * cells);
+        chunk.actions.resize(chunkRows);
+        chunk.rewards.resize(chunkRows);
+        chunk.dones.resize(chunkRows);
+        chunk.ticks.resize(chunkRows);
+        chunk.seeds.resize(chunkRows);
+    }
+    filling = &chunks[0];
+    filling->index = nextIndex++;
+    worker = std::thread(&TrajectoryWriter::writeLoop, this);
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void TrajectoryWriter::rotate() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    filling->full = true;
+    wake.notify_all();
+
+    auto freeChunk = [this]() -> Chunk* {
+        for (Chunk& chunk : chunks) {
+            if (!chunk.full) return &chunk;
+        }
+        return nullptr;
+    };
+    Chunk* next = freeChunk();
+    if (!next) {
+        stalls.add();
+        wake.wait(lock, [&] { return (next = freeChunk()) != nullptr || error != nullptr; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    next->rows = 0;
+    next->index = nextIndex++;
+    filling = next;
+}
+
+void TrajectoryWriter::writeLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        // Oldest full chunk first, so files appear in order
+        Chunk* oldest = nullptr;
+        for (Chunk& chunk : chunks) {
+            if (chunk.full && (!oldest || chunk.index < oldest->index)) oldest = &chunk;
+        }
+        if (!oldest) {
+            if (stopping) return;
+            wake.wait(lock);
+            continue;
+        }
+
+        lock.unlock();
+        std::exception_ptr failure;
+        try {
+            if (oldest->rows > 0) writeChunk(*oldest);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        lock.lock();
+        if (failure && !error) {
+            error = failure;
+        }
+        oldest->full = false;
+        wake.notify_all();
+    }
+}
+
+void TrajectoryWriter::writeChunk(const Chunk& chunk) const {
+    const std::string order = littleEndian() ? "<" : ">";
+    const std::string rows = std::to_string(chunk.rows);
+    const std::size_t cells = static_cast<std::size_t>(width) * height;
+
+    char number[32];
+    std::snprintf(number, sizeof(number), "%06llu", static_cast<unsigned long long>(chunk.index));
+    const std::string base = (std::filesystem::path(directory) / (prefix + "-" + number)).string();
+
+    struct Column {
+        const char* name;
+        std::string descr;
+        std::string shape;
+        const void* data;
+        std::size_t bytes;
+    };
+    const Column columns[] = {
+        {"observations", "|u1", "(" + rows + ", " + std::to_string(height) + ", " + std::to_string(width) + ")",
+         chunk.observations.data(), chunk.rows * cells},
+        {"actions", "|u1", "(" + rows + ",)", chunk.actions.data(), chunk.rows},
+        {"rewards", order + "f4", "(" + rows + ",)", chunk.rewards.data(), chunk.rows * sizeof(float)},
+        {"dones", "|u1", "(" + rows + ",)", chunk.dones.data(), chunk.rows},
+        {"ticks", order + "u8", "(" + rows + ",)", chunk.ticks.data(), chunk.rows * sizeof(std::uint64_t)},
+        {"seeds", order + "u8", "(" + rows + ",)", chunk.seeds.data(), chunk.rows * sizeof(std::uint64_t)},
+    };
+
+    // All columns under temporary names first, so a chunk appears complete or not at all
+    for (const Column& column : columns) {
+        writeNpy(base + "." + column.name + ".npy.tmp", column.descr.c_str(), column.shape, column.data, column.bytes);
+    }
+    for (const Column& column : columns) {
+        const std::string path = base + "." + column.name + ".npy";
+        std::error_code failure;
+        std::filesystem::rename(path + ".tmp", path, failure);
+        if (failure) {
+            throw std::runtime_error("Failed to rename " + path + ".tmp: " + failure.message());
+        }
+    }
+}
+
+void TrajectoryWriter::close() {
+    if (closed) return;
+    closed = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        filling->full = filling->rows > 0;
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}